@@ -0,0 +1,112 @@
+#pragma once
+
+#include <chrono>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+
+// minimal benchmark harness, the results are written as JSON so they can be compared across releases
+namespace dbcppp
+{
+    namespace Bench
+    {
+        // keeps the compiler from optimizing away the computation of value
+        template <class T>
+        inline void do_not_optimize(const T& value)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            asm volatile("" : : "r,m"(value) : "memory");
+#else
+            static volatile const void* sink;
+            sink = &value;
+#endif
+        }
+
+        struct Result
+        {
+            std::string name;
+            uint64_t iterations;
+            double ns_per_op;
+            // number of signals, frames, messages... processed by one op, 0 if it doesn't apply
+            uint64_t items_per_op;
+            double ns_per_item;
+            // number of input bytes processed by one op, 0 if it doesn't apply
+            uint64_t bytes_per_op;
+            double mb_per_s;
+        };
+        // a measured quantity which isn't a timing, e.g. the memory usage of a network
+        struct Metric
+        {
+            std::string name;
+            uint64_t value;
+            std::string unit;
+        };
+
+        class Runner
+        {
+        public:
+            Runner(std::string filter, double min_time)
+                : _filter(std::move(filter))
+                , _min_time(min_time)
+            {}
+
+            bool Enabled(const std::string& name) const
+            {
+                return name.find(_filter) != std::string::npos;
+            }
+            // Calls op until it ran for at least min_time seconds.
+            template <class Op>
+            void Run(const std::string& name, uint64_t items_per_op, uint64_t bytes_per_op, Op&& op)
+            {
+                using clock = std::chrono::steady_clock;
+                if (!Enabled(name))
+                {
+                    return;
+                }
+                // warm up caches and lazily built indices
+                op();
+                uint64_t iterations = 1;
+                while (true)
+                {
+                    auto begin = clock::now();
+                    for (uint64_t i = 0; i < iterations; i++)
+                    {
+                        op();
+                    }
+                    double elapsed = std::chrono::duration<double>(clock::now() - begin).count();
+                    if (elapsed >= _min_time || iterations >= (uint64_t(1) << 40))
+                    {
+                        Add(name, iterations, elapsed, items_per_op, bytes_per_op);
+                        break;
+                    }
+                    double factor = elapsed > 0 ? 1.2 * _min_time / elapsed : 10.;
+                    iterations = uint64_t(double(iterations) * std::min(std::max(factor, 2.), 100.));
+                }
+            }
+            void Record(const std::string& name, uint64_t value, const std::string& unit);
+            const std::vector<Result>& Results() const
+            {
+                return _results;
+            }
+            const std::vector<Metric>& Metrics() const
+            {
+                return _metrics;
+            }
+            void WriteJson(std::ostream& os) const;
+
+        private:
+            void Add(const std::string& name, uint64_t iterations, double elapsed, uint64_t items_per_op, uint64_t bytes_per_op);
+
+            std::string _filter;
+            double _min_time;
+            std::vector<Result> _results;
+            std::vector<Metric> _metrics;
+        };
+
+        void decode_benchmarks(Runner& runner);
+        void network_benchmarks(Runner& runner);
+        void parse_benchmarks(Runner& runner);
+    }
+}
@@ -0,0 +1,210 @@
+#include <array>
+#include <random>
+
+#include "dbcppp/Network.h"
+#include "dbcppp/StaticSignal.h"
+
+#include "Bench.h"
+
+using namespace dbcppp;
+using namespace dbcppp::Bench;
+
+namespace
+{
+    constexpr uint64_t message_size = 16;
+    constexpr std::size_t frame_count = 64;
+    // frames are padded, decoding reads whole 64 bit words
+    using frame_t = std::array<uint8_t, message_size + 16>;
+
+    const char* name(Alignment alignment)
+    {
+        switch (alignment)
+        {
+        case Alignment::size_inbetween_first_64_bit: return "first_64_bit";
+        case Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit: return "fits_into_64_bit";
+        default: return "spans_9_bytes";
+        }
+    }
+    const char* name(ISignal::EByteOrder byte_order)
+    {
+        return byte_order == ISignal::EByteOrder::LittleEndian ? "le" : "be";
+    }
+    const char* name(ISignal::EValueType value_type)
+    {
+        return value_type == ISignal::EValueType::Signed ? "signed" : "unsigned";
+    }
+    const char* name(ISignal::EExtendedValueType extended_value_type)
+    {
+        switch (extended_value_type)
+        {
+        case ISignal::EExtendedValueType::Integer: return "int";
+        case ISignal::EExtendedValueType::Float: return "float";
+        default: return "double";
+        }
+    }
+    std::unique_ptr<ISignal> make_signal(
+          uint64_t start_bit
+        , uint64_t bit_size
+        , ISignal::EByteOrder byte_order
+        , ISignal::EValueType value_type
+        , ISignal::EExtendedValueType extended_value_type)
+    {
+        return ISignal::Create(
+              message_size
+            , "Signal"
+            , ISignal::EMultiplexer::NoMux
+            , 0
+            , start_bit
+            , bit_size
+            , byte_order
+            , value_type
+            , 0.5
+            , -10.
+            , 0.
+            , 0.
+            , ""
+            , {}
+            , {}
+            , {}
+            , ""
+            , extended_value_type
+            , {});
+    }
+    // a signal of the given layout which fits into the message, nullptr if there is none
+    std::unique_ptr<ISignal> find_signal(
+          Alignment alignment
+        , ISignal::EByteOrder byte_order
+        , ISignal::EValueType value_type
+        , ISignal::EExtendedValueType extended_value_type)
+    {
+        uint64_t bit_size = 0;
+        switch (extended_value_type)
+        {
+        case ISignal::EExtendedValueType::Float: bit_size = 32; break;
+        case ISignal::EExtendedValueType::Double: bit_size = 64; break;
+        default:
+            switch (alignment)
+            {
+            case Alignment::size_inbetween_first_64_bit: bit_size = 12; break;
+            case Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit: bit_size = 20; break;
+            default: bit_size = 62; break;
+            }
+        }
+        // the first start bit which isn't byte aligned has the more expensive shifts
+        for (uint64_t i = 0; i < message_size * 8; i++)
+        {
+            uint64_t start_bit = (i + 3) % (message_size * 8);
+            if (make_signal_layout(start_bit, bit_size, byte_order).alignment != alignment)
+            {
+                continue;
+            }
+            auto sig = make_signal(start_bit, bit_size, byte_order, value_type, extended_value_type);
+            if (!sig->Error(ISignal::EErrorCode::SignalExceedsMessageSize))
+            {
+                return sig;
+            }
+        }
+        return nullptr;
+    }
+}
+
+void dbcppp::Bench::decode_benchmarks(Runner& runner)
+{
+    std::default_random_engine rng(1);
+    std::uniform_int_distribution<uint64_t> dist;
+    std::vector<frame_t> frames(frame_count);
+    std::vector<uint64_t> raws(frame_count);
+    for (std::size_t i = 0; i < frame_count; i++)
+    {
+        for (auto& b : frames[i])
+        {
+            b = uint8_t(dist(rng));
+        }
+        raws[i] = dist(rng);
+    }
+    const Alignment alignments[] =
+        { Alignment::size_inbetween_first_64_bit
+        , Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit
+        , Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit };
+    const ISignal::EByteOrder byte_orders[] = {ISignal::EByteOrder::LittleEndian, ISignal::EByteOrder::BigEndian};
+    const ISignal::EValueType value_types[] = {ISignal::EValueType::Unsigned, ISignal::EValueType::Signed};
+    const ISignal::EExtendedValueType extended_value_types[] =
+        { ISignal::EExtendedValueType::Integer
+        , ISignal::EExtendedValueType::Float
+        , ISignal::EExtendedValueType::Double };
+
+    for (auto alignment : alignments)
+    {
+        for (auto byte_order : byte_orders)
+        {
+            for (auto value_type : value_types)
+            {
+                for (auto extended_value_type : extended_value_types)
+                {
+                    auto sig = find_signal(alignment, byte_order, value_type, extended_value_type);
+                    if (!sig)
+                    {
+                        continue;
+                    }
+                    std::string suffix = std::string(name(alignment)) + "/" + name(byte_order) + "/"
+                        + name(value_type) + "/" + name(extended_value_type);
+                    runner.Run("decode/" + suffix, frame_count, 0,
+                        [&]
+                        {
+                            uint64_t acc = 0;
+                            for (const auto& frame : frames)
+                            {
+                                acc += sig->Decode(frame.data());
+                            }
+                            do_not_optimize(acc);
+                        });
+                    frame_t buffer{};
+                    runner.Run("encode/" + suffix, frame_count, 0,
+                        [&]
+                        {
+                            for (auto raw : raws)
+                            {
+                                sig->Encode(raw, buffer.data());
+                            }
+                            do_not_optimize(buffer);
+                        });
+                }
+            }
+        }
+    }
+    for (auto value_type : value_types)
+    {
+        for (auto extended_value_type : extended_value_types)
+        {
+            auto sig = find_signal(Alignment::size_inbetween_first_64_bit, ISignal::EByteOrder::LittleEndian, value_type, extended_value_type);
+            std::vector<uint64_t> decoded;
+            std::vector<double> phys;
+            for (const auto& frame : frames)
+            {
+                decoded.push_back(sig->Decode(frame.data()));
+                phys.push_back(double(int64_t(dist(rng) % 2000)) - 1000.);
+            }
+            std::string suffix = std::string(name(value_type)) + "/" + name(extended_value_type);
+            runner.Run("raw_to_phys/" + suffix, frame_count, 0,
+                [&]
+                {
+                    double acc = 0;
+                    for (auto raw : decoded)
+                    {
+                        acc += sig->RawToPhys(raw);
+                    }
+                    do_not_optimize(acc);
+                });
+            runner.Run("phys_to_raw/" + suffix, frame_count, 0,
+                [&]
+                {
+                    uint64_t acc = 0;
+                    for (auto value : phys)
+                    {
+                        acc += sig->PhysToRaw(value);
+                    }
+                    do_not_optimize(acc);
+                });
+        }
+    }
+}
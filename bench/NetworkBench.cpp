@@ -0,0 +1,170 @@
+#include <sstream>
+#include <algorithm>
+
+#include "dbcppp/CApi.h"
+#include "dbcppp/Network.h"
+#include "dbcppp/Generator.h"
+#include "dbcppp/Predicate.h"
+#include "dbcppp/Projection.h"
+
+#include "Bench.h"
+
+using namespace dbcppp;
+using namespace dbcppp::Bench;
+
+void dbcppp::Bench::network_benchmarks(Runner& runner)
+{
+    constexpr std::size_t messages = 2000;
+    constexpr std::size_t signals_per_message = 8;
+    constexpr std::size_t frame_count = 1024;
+    Generator::DBCOptions options;
+    options.messages = messages;
+    options.signals_per_message = signals_per_message;
+    std::istringstream iss(Generator::GenerateDBC(options));
+    auto net = INetwork::LoadDBCFromIs(iss);
+    if (!net)
+    {
+        return;
+    }
+    std::size_t signal_count = 0;
+    for (const IMessage& msg : net->Messages())
+    {
+        signal_count += msg.Signals_Size();
+    }
+
+    Generator::FrameOptions frame_options;
+    frame_options.count = frame_count;
+    std::vector<uint32_t> ids;
+    std::vector<uint8_t> payloads;
+    Generator::GenerateFrames(*net, frame_options,
+        [&](const Generator::Frame& frame)
+        {
+            ids.push_back(frame.id);
+            payloads.insert(payloads.end(), frame.data.begin(), frame.data.begin() + 8);
+        });
+    std::vector<uint32_t> unknown_ids(frame_count);
+    std::transform(ids.begin(), ids.end(), unknown_ids.begin(), [](uint32_t id) { return id + 0x10000; });
+
+    runner.Run("lookup/message_by_id", frame_count, 0,
+        [&]
+        {
+            for (auto id : ids)
+            {
+                do_not_optimize(net->MessageById(id));
+            }
+        });
+    runner.Run("lookup/message_by_id_unknown", frame_count, 0,
+        [&]
+        {
+            for (auto id : unknown_ids)
+            {
+                do_not_optimize(net->MessageById(id));
+            }
+        });
+    runner.Run("lookup/linear_search", frame_count / 16, 0,
+        [&]
+        {
+            for (std::size_t i = 0; i < frame_count / 16; i++)
+            {
+                auto iter = std::find_if(net->Messages().begin(), net->Messages().end(),
+                    [&](const IMessage& msg) { return msg.Id() == ids[i]; });
+                do_not_optimize(&*iter);
+            }
+        });
+    runner.Run("iterate/range_for", signal_count, 0,
+        [&]
+        {
+            uint64_t acc = 0;
+            for (const IMessage& msg : net->Messages())
+            {
+                for (const ISignal& sig : msg.Signals())
+                {
+                    acc += sig.BitSize();
+                }
+            }
+            do_not_optimize(acc);
+        });
+    runner.Run("iterate/index", signal_count, 0,
+        [&]
+        {
+            uint64_t acc = 0;
+            for (std::size_t i = 0; i < net->Messages_Size(); i++)
+            {
+                const IMessage& msg = net->Messages_Get(i);
+                for (std::size_t j = 0; j < msg.Signals_Size(); j++)
+                {
+                    acc += msg.Signals_Get(j).BitSize();
+                }
+            }
+            do_not_optimize(acc);
+        });
+
+    auto cnet = reinterpret_cast<const dbcppp_Network*>(net.get());
+    std::vector<double> values(frame_count * signals_per_message);
+    runner.Run("decode_frames/c_api", frame_count, payloads.size(),
+        [&]
+        {
+            do_not_optimize(dbcppp_NetworkDecodeFrames(cnet, ids.data(), payloads.data(), 8, frame_count,
+                values.data(), signals_per_message, nullptr));
+        });
+    runner.Run("decode_frames/per_signal", frame_count, payloads.size(),
+        [&]
+        {
+            double acc = 0;
+            for (std::size_t i = 0; i < frame_count; i++)
+            {
+                const IMessage* msg = net->MessageById(ids[i]);
+                for (const ISignal& sig : msg->Signals())
+                {
+                    acc += sig.RawToPhys(sig.Decode(&payloads[i * 8]));
+                }
+            }
+            do_not_optimize(acc);
+        });
+
+    // about 5% of the signals: one signal of every third message
+    std::vector<const ISignal*> selected;
+    for (std::size_t i = 0; i < net->Messages_Size(); i += 3)
+    {
+        selected.push_back(&net->Messages_Get(i).Signals_Get(net->Messages_Get(i).Signals_Size() - 1));
+    }
+    std::string error;
+    auto projection = Projection::Create(*net, selected, error);
+    runner.Run("decode_frames/projection", frame_count, payloads.size(),
+        [&]
+        {
+            for (std::size_t i = 0; i < frame_count; i++)
+            {
+                do_not_optimize(projection->Decode(ids[i], &payloads[i * 8], &values[i * signals_per_message]));
+            }
+        });
+
+    // filtering the frames on two signals of one message, as if they all had its id
+    const IMessage& filtered = net->Messages_Get(0);
+    const ISignal& first = filtered.Signals_Get(0);
+    const ISignal& second = filtered.Signals_Get(1);
+    double threshold = first.RawToPhys(first.Decode(&payloads[0]));
+    double value = second.RawToPhys(second.Decode(&payloads[8]));
+    auto predicate = Predicate::Create(filtered, {{{&first, Predicate::EOperator::Greater, threshold}, {&second, Predicate::EOperator::Equal, value}}}, error);
+    runner.Run("filter_frames/physical", frame_count, payloads.size(),
+        [&]
+        {
+            std::size_t matches = 0;
+            for (std::size_t i = 0; i < frame_count; i++)
+            {
+                matches += first.RawToPhys(first.Decode(&payloads[i * 8])) > threshold
+                    && second.RawToPhys(second.Decode(&payloads[i * 8])) == value;
+            }
+            do_not_optimize(matches);
+        });
+    runner.Run("filter_frames/predicate", frame_count, payloads.size(),
+        [&]
+        {
+            std::size_t matches = 0;
+            for (std::size_t i = 0; i < frame_count; i++)
+            {
+                matches += predicate->Evaluate(&payloads[i * 8]);
+            }
+            do_not_optimize(matches);
+        });
+}
@@ -0,0 +1,94 @@
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <algorithm>
+#include <filesystem>
+
+#include "dbcppp/Network.h"
+#include "dbcppp/Generator.h"
+
+#include "Bench.h"
+
+using namespace dbcppp;
+using namespace dbcppp::Bench;
+
+namespace
+{
+    void memory_metrics(Runner& runner, const std::string& name, const INetwork& net, bool breakdown)
+    {
+        auto usage = net.MemoryUsage();
+        runner.Record("memory/" + name + "/total", usage.Total(), "bytes");
+        if (breakdown)
+        {
+            runner.Record("memory/" + name + "/signal_hot_data", usage.signal_hot_data, "bytes");
+            runner.Record("memory/" + name + "/names", usage.names, "bytes");
+            runner.Record("memory/" + name + "/comments", usage.comments, "bytes");
+            runner.Record("memory/" + name + "/attributes", usage.attributes, "bytes");
+            runner.Record("memory/" + name + "/value_descriptions", usage.value_descriptions, "bytes");
+            runner.Record("memory/" + name + "/mux_metadata", usage.mux_metadata, "bytes");
+            runner.Record("memory/" + name + "/indices", usage.indices, "bytes");
+            runner.Record("memory/" + name + "/other", usage.other, "bytes");
+        }
+    }
+    // also records the memory usage of the network, broken down by category for the synthetic ones
+    void parse_benchmark(Runner& runner, const std::string& input, const std::string& dbc, bool breakdown = false)
+    {
+        const std::string name = "parse/" + input;
+        if (!runner.Enabled(name) && !runner.Enabled("memory/" + input))
+        {
+            return;
+        }
+        // files the parser rejects are part of the test corpus too, but their timings say nothing
+        std::istringstream probe(dbc);
+        std::string error;
+        auto net = INetwork::LoadDBCFromIs(probe, error);
+        if (!net)
+        {
+            return;
+        }
+        memory_metrics(runner, input, *net, breakdown);
+        uint64_t signals = 0;
+        for (const IMessage& msg : net->Messages())
+        {
+            signals += msg.Signals_Size();
+        }
+        runner.Run(name, signals, dbc.size(),
+            [&]
+            {
+                std::istringstream iss(dbc);
+                auto net = INetwork::LoadDBCFromIs(iss, error);
+                do_not_optimize(net.get());
+            });
+    }
+}
+
+void dbcppp::Bench::parse_benchmarks(Runner& runner)
+{
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::path(DBCPPP_TEST_FILES_PATH) / "dbc"))
+    {
+        if (entry.path().extension() == ".dbc")
+        {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    for (const auto& file : files)
+    {
+        std::ifstream is(file, std::ios::binary);
+        std::string dbc{std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>()};
+        parse_benchmark(runner, file.filename().string(), dbc);
+    }
+    Generator::DBCOptions options;
+    options.messages = 100;
+    options.signals_per_message = 8;
+    parse_benchmark(runner, "synthetic_100x8", Generator::GenerateDBC(options), true);
+    options.messages = 1000;
+    options.signals_per_message = 16;
+    parse_benchmark(runner, "synthetic_1000x16", Generator::GenerateDBC(options), true);
+    options.can_fd = true;
+    options.mux_depth = 2;
+    options.float_signals = true;
+    options.double_signals = true;
+    parse_benchmark(runner, "synthetic_1000x16_fd_mux", Generator::GenerateDBC(options), true);
+}
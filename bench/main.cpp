@@ -0,0 +1,151 @@
+#include <ctime>
+#include <string>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "Bench.h"
+
+using namespace dbcppp::Bench;
+
+namespace
+{
+    std::string escape(const std::string& str)
+    {
+        std::string result;
+        for (char c : str)
+        {
+            if (c == '"' || c == '\\')
+            {
+                result += '\\';
+            }
+            result += c;
+        }
+        return result;
+    }
+    void print_help()
+    {
+        std::cout << "Usage: dbcppp_Bench [--filter=<substring>] [--min-time=<seconds>] [--out=<json file>]\n"
+            << "Writes the results as JSON to the file or stdout and a summary to stderr.\n";
+    }
+}
+
+void Runner::Add(const std::string& name, uint64_t iterations, double elapsed, uint64_t items_per_op, uint64_t bytes_per_op)
+{
+    Result result;
+    result.name = name;
+    result.iterations = iterations;
+    result.ns_per_op = elapsed * 1e9 / double(iterations);
+    result.items_per_op = items_per_op;
+    result.ns_per_item = items_per_op ? result.ns_per_op / double(items_per_op) : 0.;
+    result.bytes_per_op = bytes_per_op;
+    result.mb_per_s = bytes_per_op ? double(bytes_per_op) * double(iterations) / elapsed / 1e6 : 0.;
+    _results.push_back(result);
+    std::cerr << std::left << std::setw(80) << name << std::right << std::fixed << std::setprecision(2)
+        << std::setw(14) << result.ns_per_op << " ns/op";
+    if (items_per_op)
+    {
+        std::cerr << std::setw(12) << result.ns_per_item << " ns/item";
+    }
+    if (bytes_per_op)
+    {
+        std::cerr << std::setw(12) << result.mb_per_s << " MB/s";
+    }
+    std::cerr << std::endl;
+}
+void Runner::Record(const std::string& name, uint64_t value, const std::string& unit)
+{
+    if (!Enabled(name))
+    {
+        return;
+    }
+    _metrics.push_back({name, value, unit});
+    std::cerr << std::left << std::setw(80) << name << std::right << std::setw(14) << value << " " << unit << std::endl;
+}
+void Runner::WriteJson(std::ostream& os) const
+{
+    std::time_t now = std::time(nullptr);
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    os << "{\n"
+        << "  \"context\": {\n"
+        << "    \"date\": \"" << date << "\",\n"
+        << "    \"version\": \"" << DBCPPP_VERSION << "\",\n"
+        << "    \"build_type\": \"" << escape(DBCPPP_BUILD_TYPE) << "\",\n"
+        << "    \"compiler\": \"" << escape(DBCPPP_COMPILER) << "\"\n"
+        << "  },\n"
+        << "  \"benchmarks\": [";
+    os << std::setprecision(4) << std::fixed;
+    for (std::size_t i = 0; i < _results.size(); i++)
+    {
+        const auto& result = _results[i];
+        os << (i ? ",\n" : "\n")
+            << "    {\"name\": \"" << escape(result.name) << "\""
+            << ", \"iterations\": " << result.iterations
+            << ", \"ns_per_op\": " << result.ns_per_op
+            << ", \"items_per_op\": " << result.items_per_op
+            << ", \"ns_per_item\": " << result.ns_per_item
+            << ", \"bytes_per_op\": " << result.bytes_per_op
+            << ", \"mb_per_s\": " << result.mb_per_s << "}";
+    }
+    os << "\n  ],\n"
+        << "  \"metrics\": [";
+    for (std::size_t i = 0; i < _metrics.size(); i++)
+    {
+        const auto& metric = _metrics[i];
+        os << (i ? ",\n" : "\n")
+            << "    {\"name\": \"" << escape(metric.name) << "\""
+            << ", \"value\": " << metric.value
+            << ", \"unit\": \"" << escape(metric.unit) << "\"}";
+    }
+    os << "\n  ]\n}\n";
+}
+
+int main(int argc, char** argv)
+{
+    std::string filter;
+    std::string out;
+    double min_time = 0.2;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--filter=", 0) == 0)
+        {
+            filter = arg.substr(9);
+        }
+        else if (arg.rfind("--min-time=", 0) == 0)
+        {
+            min_time = std::stod(arg.substr(11));
+        }
+        else if (arg.rfind("--out=", 0) == 0)
+        {
+            out = arg.substr(6);
+        }
+        else
+        {
+            print_help();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    Runner runner(filter, min_time);
+    decode_benchmarks(runner);
+    network_benchmarks(runner);
+    parse_benchmarks(runner);
+
+    if (out.empty())
+    {
+        runner.WriteJson(std::cout);
+    }
+    else
+    {
+        std::ofstream os(out);
+        runner.WriteJson(os);
+        if (!os)
+        {
+            std::cerr << "failed to write " << out << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -6,6 +6,7 @@ extern "C"
 {
 #endif
 #include "Export.h"
+#include <stddef.h>
 #include <stdint.h>
 
     typedef enum
@@ -83,6 +84,18 @@ extern "C"
         uint64_t to;
     } dbcppp_ValueRange;
     typedef struct {} dbcppp_ValueEncodingDescription;
+    typedef struct {} dbcppp_DecodeStats;
+    typedef struct {
+        uint64_t frames;
+        uint64_t signals_out_of_range;
+        uint64_t unmatched_mux;
+    } dbcppp_MessageDecodeStats;
+    typedef struct {
+        uint8_t priority;
+        uint32_t pgn;
+        uint8_t source;
+        uint8_t destination;
+    } dbcppp_J1939Id;
     
     DBCPPP_API const dbcppp_Attribute* dbcppp_AttributeCreate(
         const char* name,
@@ -175,6 +188,10 @@ extern "C"
     DBCPPP_API const dbcppp_Attribute* dbcppp_MessageAttributeValues_Get(const dbcppp_Message* msg, uint64_t i);
     DBCPPP_API uint64_t dbcppp_MessageAttributeValues_Size(const dbcppp_Message* msg);
     DBCPPP_API const char* dbcppp_MessageComment(const dbcppp_Message* msg);
+    // Writes the physical values of all signals of the message in signal order into out and returns the number
+    // of values written, 0 if len is smaller than the message size. Multiplexed signals which are not present
+    // in the frame are set to NaN. Does not allocate.
+    DBCPPP_API uint64_t dbcppp_MessageDecodeAll(const dbcppp_Message* msg, const uint8_t* data, size_t len, double* out);
     
     DBCPPP_API const dbcppp_Network* dbcppp_NetworkLoadDBCFromFile(const char* filename);
     DBCPPP_API const dbcppp_Network* dbcppp_NetworkLoadDBCFromMemory(const char* data);
@@ -201,6 +218,24 @@ extern "C"
     DBCPPP_API uint64_t dbcppp_NetworkValueTables_Size(const dbcppp_Network* net);
     DBCPPP_API const dbcppp_Message* dbcppp_NetworkMessages_Get(const dbcppp_Network* net, uint64_t i);
     DBCPPP_API uint64_t dbcppp_NetworkMessages_Size(const dbcppp_Network* net);    
+    DBCPPP_API const dbcppp_Message* dbcppp_NetworkMessageById(const dbcppp_Network* net, uint64_t id);
+    // like INetwork::MessageByJ1939Id, id may be NULL
+    DBCPPP_API const dbcppp_Message* dbcppp_NetworkMessageByJ1939Id(const dbcppp_Network* net, uint32_t can_id, dbcppp_J1939Id* id);
+    // greatest number of signals of a message, the minimal values_stride for dbcppp_NetworkDecodeFrames
+    DBCPPP_API uint64_t dbcppp_NetworkMaxSignalsPerMessage(const dbcppp_Network* net);
+    // Decodes n frames, frame i has the id ids[i] and the payload payloads[i * stride] with stride bytes.
+    // The values of frame i are written like by dbcppp_MessageDecodeAll to values[i * values_stride], at most
+    // values_stride of them. messages may be NULL, otherwise messages[i] is set to the message of frame i or
+    // NULL if the id is unknown or the frame too short. Returns the number of decoded frames. Does not allocate.
+    DBCPPP_API size_t dbcppp_NetworkDecodeFrames(
+          const dbcppp_Network* net
+        , const uint32_t* ids
+        , const uint8_t* payloads
+        , size_t stride
+        , size_t n
+        , double* values
+        , size_t values_stride
+        , const dbcppp_Message** messages);
     DBCPPP_API const dbcppp_EnvironmentVariable* dbcppp_NetworkEnvironmentVariables_Get(const dbcppp_Network* net, uint64_t i);
     DBCPPP_API uint64_t dbcppp_NetworkEnvironmentVariables_Size(const dbcppp_Network* net);
     DBCPPP_API const dbcppp_AttributeDefinition* dbcppp_NetworkAttributeDefinitions_Get(const dbcppp_Network* net, uint64_t i);
@@ -302,6 +337,36 @@ extern "C"
     DBCPPP_API uint64_t dbcppp_ValueEncodingDescriptionValue(const dbcppp_ValueEncodingDescription* ved);
     DBCPPP_API const char* dbcppp_ValueEncodingDescriptionDescription(const dbcppp_ValueEncodingDescription* ved);
 
+    // see dbcppp::DecodeStats, the network must outlive the stats
+    DBCPPP_API dbcppp_DecodeStats* dbcppp_DecodeStatsCreate(const dbcppp_Network* net);
+    DBCPPP_API void dbcppp_DecodeStatsFree(dbcppp_DecodeStats* stats);
+    DBCPPP_API void dbcppp_DecodeStatsEnable(dbcppp_DecodeStats* stats, int enabled);
+    // counts frames like dbcppp_NetworkDecodeFrames decodes them, without writing the values
+    DBCPPP_API void dbcppp_DecodeStatsRecordFrames(
+          dbcppp_DecodeStats* stats
+        , const uint32_t* ids
+        , const uint8_t* payloads
+        , size_t stride
+        , size_t n);
+    // dbcppp_NetworkDecodeFrames which also counts the frames, checking the already decoded values
+    DBCPPP_API size_t dbcppp_DecodeStatsDecodeFrames(
+          dbcppp_DecodeStats* stats
+        , const uint32_t* ids
+        , const uint8_t* payloads
+        , size_t stride
+        , size_t n
+        , double* values
+        , size_t values_stride
+        , const dbcppp_Message** messages);
+    // Sums up the counters of all threads. Writes the counters of the first messages_size messages in the order
+    // of dbcppp_NetworkMessages_Get to messages and their sum to total, both may be NULL. Returns the number of
+    // frames with unknown ids.
+    DBCPPP_API uint64_t dbcppp_DecodeStatsSnapshot(
+          const dbcppp_DecodeStats* stats
+        , dbcppp_MessageDecodeStats* messages
+        , uint64_t messages_size
+        , dbcppp_MessageDecodeStats* total);
+
 #ifdef __cplusplus
 }
 #endif
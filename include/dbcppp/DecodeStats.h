@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+#include "Export.h"
+#include "BuildOptions.h"
+#include "Network.h"
+
+namespace dbcppp
+{
+    struct MessageDecodeStats
+    {
+        uint64_t frames = 0;
+        // present signals whose physical value lies outside of [Minimum, Maximum],
+        // signals with Minimum >= Maximum (e.g. [0|0]) have no range and aren't checked
+        uint64_t signals_out_of_range = 0;
+        // frames with a multiplexer switch value for which the message defines no multiplexed signals
+        uint64_t unmatched_mux = 0;
+    };
+    struct DecodeStatsSnapshot
+    {
+        // indexed like INetwork::Messages_Get
+        std::vector<MessageDecodeStats> messages;
+        MessageDecodeStats total;
+        uint64_t unknown_ids = 0;
+    };
+
+    // Counters for the frames of one network. Every thread counts into its own block, indexed by the
+    // message index, which Snapshot sums up on demand, so recording never contends between threads.
+    // Disabled stats cost one relaxed load per call, if the library is configured with the CMake option
+    // DBCPPP_DISABLE_DECODE_STATS the Record functions compile to nothing.
+    // The frames have to be readable like for ISignal::Decode.
+    class DBCPPP_API DecodeStats
+    {
+    public:
+        // the network must outlive the stats
+        explicit DecodeStats(const INetwork& net, bool enabled = true);
+        ~DecodeStats();
+        DecodeStats(const DecodeStats&) = delete;
+        DecodeStats& operator=(const DecodeStats&) = delete;
+
+        void Enable(bool enabled)
+        {
+            _enabled.store(enabled, std::memory_order_relaxed);
+        }
+        bool Enabled() const
+        {
+            return _enabled.load(std::memory_order_relaxed);
+        }
+
+        // Looks up the message of the id, decodes the frame and counts it.
+        void RecordFrame(uint64_t id, const void* data)
+        {
+#ifndef DBCPPP_DISABLE_DECODE_STATS
+            if (Enabled())
+            {
+                recordFrame(id, data);
+            }
+#endif
+        }
+        // For frames which are decoded anyway: values holds the physical values of the first count signals
+        // of the message in signal order, NaN for signals which aren't present, like dbcppp_MessageDecodeAll.
+        void RecordDecoded(const IMessage& msg, const void* data, const double* values, std::size_t count)
+        {
+#ifndef DBCPPP_DISABLE_DECODE_STATS
+            if (Enabled())
+            {
+                recordDecoded(msg, data, values, count);
+            }
+#endif
+        }
+        void RecordUnknownId(uint64_t id)
+        {
+#ifndef DBCPPP_DISABLE_DECODE_STATS
+            if (Enabled())
+            {
+                recordUnknownId(id);
+            }
+#endif
+        }
+
+        const INetwork& Network() const;
+        DecodeStatsSnapshot Snapshot() const;
+
+    private:
+        class Impl;
+        struct Block;
+
+        void recordFrame(uint64_t id, const void* data);
+        void recordDecoded(const IMessage& msg, const void* data, const double* values, std::size_t count);
+        void recordUnknownId(uint64_t id);
+        Block& block();
+
+        std::atomic<bool> _enabled;
+        std::unique_ptr<Impl> _impl;
+    };
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <functional>
+
+#include "Export.h"
+#include "Network.h"
+
+namespace dbcppp
+{
+    // Synthetic DBCs and CAN traffic for scale tests and benchmarks.
+    // The output only depends on the options, the same seed always produces the same DBC or frames.
+    namespace Generator
+    {
+        struct DBCPPP_API DBCOptions
+        {
+            uint64_t seed = 0;
+            std::size_t messages = 100;
+            // including the multiplexer switches, limited by the bits of the message
+            std::size_t signals_per_message = 8;
+            std::size_t nodes = 4;
+            // 0: no multiplexing, 1: one switch per message, n: n cascaded switches (extended multiplexing)
+            std::size_t mux_depth = 0;
+            // number of values each switch selects signals for
+            std::size_t mux_values = 4;
+            // describe the multiplexing with SG_MUL_VAL_ even if mux_depth is 1
+            bool extended_mux = false;
+            // some signals become IEEE floats (SIG_VALTYPE_ 1) or doubles (SIG_VALTYPE_ 2)
+            bool float_signals = false;
+            bool double_signals = false;
+            // message and signal attributes (BA_DEF_, BA_DEF_DEF_, BA_)
+            bool attributes = true;
+            bool comments = true;
+            bool value_descriptions = true;
+            // 64 byte CAN FD messages instead of 8 byte messages
+            bool can_fd = false;
+            // 29 bit ids, used anyway if there are more messages than 11 bit ids
+            bool extended_ids = false;
+        };
+        DBCPPP_API void GenerateDBC(std::ostream& os, const DBCOptions& options);
+        DBCPPP_API std::string GenerateDBC(const DBCOptions& options);
+
+        struct Frame
+        {
+            // id like in the DBC, bit 31 is set for extended ids
+            uint32_t id;
+            uint8_t size;
+            std::array<uint8_t, 64> data;
+        };
+        enum class EFrameFormat
+        {
+            // the output of candump: "  can0  123   [8]  11 22 33 44 55 66 77 88"
+            Candump,
+            // records of 72 bytes: id (uint32, little endian), size (uint8), 3 padding bytes, 64 data bytes
+            Binary
+        };
+        struct DBCPPP_API FrameOptions
+        {
+            uint64_t seed = 0;
+            std::size_t count = 1000;
+            EFrameFormat format = EFrameFormat::Candump;
+            std::string interface_name = "can0";
+        };
+        // Random frames of random messages of the network. The payloads are random except for the multiplexer
+        // switches, which are set to values the message defines multiplexed signals for.
+        DBCPPP_API void GenerateFrames(const INetwork& net, const FrameOptions& options, const std::function<void(const Frame&)>& on_frame);
+        DBCPPP_API void WriteFrames(std::ostream& os, const INetwork& net, const FrameOptions& options);
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+namespace dbcppp
+{
+    struct Hash128
+    {
+        uint64_t low = 0;
+        uint64_t high = 0;
+
+        bool operator==(const Hash128& rhs) const
+        {
+            return low == rhs.low && high == rhs.high;
+        }
+        bool operator!=(const Hash128& rhs) const
+        {
+            return !(*this == rhs);
+        }
+    };
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "Export.h"
+#include "Network.h"
+
+namespace dbcppp
+{
+    // ISO 15765-2 (ISO-TP): PDUs which don't fit into one frame, e.g. UDS responses, are segmented into a first
+    // frame and consecutive frames, the receiver paces them with flow control frames.
+    namespace IsoTp
+    {
+        // The PDUs sent with id, their flow control frames are sent with flow_control_id by the receiver.
+        // The ids are given like in the DBC, bit 31 set for extended ids.
+        struct Channel
+        {
+            uint32_t id;
+            uint32_t flow_control_id;
+            // Optional buffer owned by the caller the PDUs of the channel are reassembled in, PDUs which don't fit
+            // into capacity - 8 bytes are rejected. Without a buffer the PDUs are reassembled in buffers of the pool.
+            uint8_t* buffer = nullptr;
+            std::size_t capacity = 0;
+        };
+        struct Pdu
+        {
+            const Channel* channel;
+            // valid until the callback returns, or, for a buffer of the channel, until its next first frame.
+            // It is followed by zeros up to the size of message plus 8 bytes (as far as the buffer allows),
+            // so it can be decoded in place like a frame.
+            const uint8_t* data;
+            std::size_t size;
+            // the message of the network with the id of the channel, nullptr if there is none
+            const IMessage* message;
+        };
+        struct ReassemblerStats
+        {
+            // including single frames
+            uint64_t completed = 0;
+            // by a new first or single frame or a flow control frame reporting an overflow
+            uint64_t aborted = 0;
+            uint64_t timed_out = 0;
+            // PDUs which were too large, malformed or found no free buffer
+            uint64_t rejected = 0;
+            // consecutive frames with the wrong sequence number or size, the PDU is dropped
+            uint64_t sequence_errors = 0;
+        };
+        struct DBCPPP_API ReassemblerOptions
+        {
+            // at most 65535
+            std::vector<Channel> channels;
+            // buffers of the pool, the number of PDUs without a buffer of their channel that can be reassembled at a time
+            std::size_t pooled_buffers = 256;
+            // larger PDUs are rejected from the pool, the default is the largest one without the escape sequence
+            std::size_t max_size = 4095;
+            // sessions without a frame for this long are dropped, ISO 15765-2 uses 1000 ms (N_Bs, N_Cr)
+            uint64_t timeout_us = 1000000;
+        };
+
+        // Reassembles the PDUs of all channels of one bus from the frames of both sides, classic CAN as well as
+        // CAN FD frames. Only normal addressing is supported. The memory is allocated upfront, frames are
+        // processed without allocating. Not thread safe.
+        class DBCPPP_API Reassembler
+        {
+        public:
+            using on_pdu_t = std::function<void(const Pdu&)>;
+
+            // net, if given, must outlive the reassembler
+            Reassembler(const ReassemblerOptions& options, on_pdu_t on_pdu, const INetwork* net = nullptr);
+            ~Reassembler();
+            Reassembler(const Reassembler&) = delete;
+            Reassembler& operator=(const Reassembler&) = delete;
+
+            // Returns false for frames whose id is no id of a channel, they have to be decoded directly.
+            // The timestamps have to be monotonic, sessions which timed out are dropped before the frame is processed.
+            bool OnFrame(uint32_t id, const uint8_t* data, std::size_t size, uint64_t timestamp_us);
+            // drops the sessions which timed out
+            void Expire(uint64_t timestamp_us);
+
+            std::size_t ActiveSessions() const;
+            const ReassemblerStats& Stats() const;
+
+        private:
+            class Impl;
+            std::unique_ptr<Impl> _impl;
+        };
+    }
+}
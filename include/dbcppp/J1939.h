@@ -0,0 +1,78 @@
+#pragma once
+
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "Export.h"
+#include "Network.h"
+#include "J1939Id.h"
+
+namespace dbcppp
+{
+    // The transport protocol (TP, up to 1785 bytes) and the extended transport protocol (ETP, larger PGs)
+    // segment the PGs which don't fit into one frame.
+    namespace J1939
+    {
+        struct Payload
+        {
+            // the PGN, source and destination of the transported PG, the priority of the frame which opened the session
+            Id id;
+            // valid until the callback returns, followed by zeros up to the size of message plus 8 bytes,
+            // so it can be decoded in place like a frame
+            const uint8_t* data;
+            std::size_t size;
+            // the message of the network with the PGN, nullptr if there is none
+            const IMessage* message;
+        };
+        struct ReassemblerStats
+        {
+            uint64_t completed = 0;
+            // by an abort frame or a new session of the same source and destination
+            uint64_t aborted = 0;
+            uint64_t timed_out = 0;
+            // sessions which were too large, inconsistent or found no free slot
+            uint64_t rejected = 0;
+            // data frames out of order, the session is dropped
+            uint64_t sequence_errors = 0;
+        };
+        struct DBCPPP_API ReassemblerOptions
+        {
+            // concurrent sessions, at most 65535
+            std::size_t max_sessions = 1024;
+            // larger PGs are rejected, the default fits every TP session but no ETP session
+            std::size_t max_size = 1785;
+            // sessions without a frame for this long are dropped, J1939-21 allows up to 1250 ms (T2, T3)
+            uint64_t timeout_us = 1250000;
+        };
+
+        // Reassembles the TP (BAM and RTS/CTS) and ETP sessions of one bus from the frames of all participants.
+        // The memory for all sessions is allocated upfront, frames are processed without allocating.
+        // Not thread safe.
+        class DBCPPP_API Reassembler
+        {
+        public:
+            using on_payload_t = std::function<void(const Payload&)>;
+
+            // net, if given, must outlive the reassembler
+            Reassembler(const ReassemblerOptions& options, on_payload_t on_payload, const INetwork* net = nullptr);
+            ~Reassembler();
+            Reassembler(const Reassembler&) = delete;
+            Reassembler& operator=(const Reassembler&) = delete;
+
+            // Returns false for frames which aren't transport protocol frames, they have to be decoded directly.
+            // The timestamps have to be monotonic, sessions which timed out are dropped before the frame is processed.
+            bool OnFrame(uint32_t can_id, const uint8_t* data, std::size_t size, uint64_t timestamp_us);
+            // drops the sessions which timed out
+            void Expire(uint64_t timestamp_us);
+
+            std::size_t ActiveSessions() const;
+            const ReassemblerStats& Stats() const;
+
+        private:
+            class Impl;
+            std::unique_ptr<Impl> _impl;
+        };
+    }
+}
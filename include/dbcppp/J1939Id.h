@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+namespace dbcppp
+{
+    // SAE J1939: parameter groups (PGs) are identified by their parameter group number (PGN), which is embedded
+    // in the 29 bit id together with the priority, the source address and, for PDU1 PGs, the destination address.
+    namespace J1939
+    {
+        constexpr uint32_t PGN_TP_CM = 0xEC00;
+        constexpr uint32_t PGN_TP_DT = 0xEB00;
+        constexpr uint32_t PGN_ETP_CM = 0xC800;
+        constexpr uint32_t PGN_ETP_DT = 0xC700;
+        constexpr uint8_t GlobalAddress = 0xFF;
+
+        struct Id
+        {
+            uint8_t priority;
+            // for PDU1 PGs (PF < 240) without the destination address
+            uint32_t pgn;
+            uint8_t source;
+            // GlobalAddress for PDU2 PGs
+            uint8_t destination;
+        };
+        // can_id: the 29 bit id, bit 31 (the extended id flag of the message ids in DBCs) is ignored
+        constexpr Id ParseId(uint32_t can_id)
+        {
+            uint8_t pf = uint8_t(can_id >> 16);
+            uint8_t ps = uint8_t(can_id >> 8);
+            uint32_t pgn = (can_id >> 8) & 0x3FF00;
+            return {uint8_t((can_id >> 26) & 0x7), pf < 240 ? pgn : pgn | ps, uint8_t(can_id), pf < 240 ? ps : GlobalAddress};
+        }
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Export.h"
+#include "LoadStats.h"
+
+namespace dbcppp
+{
+    // Selects which parts of a DBC are loaded. Disabled parts are skipped by the parser
+    // without being parsed and the corresponding accessors of the network return empty values.
+    struct DBCPPP_API LoadOptions
+    {
+        bool comments = true;
+        bool attribute_definitions = true;
+        // attribute defaults (BA_DEF_DEF_) and attribute values (BA_)
+        bool attribute_values = true;
+        // value descriptions (VAL_) and value tables (VAL_TABLE_, SGTYPE_)
+        bool value_descriptions = true;
+        bool environment_variables = true;
+        bool signal_groups = true;
+
+        // Number of threads used to parse the DBC, 0 selects one per hardware thread.
+        // Only inputs of several hundred KiB are split, smaller ones are always parsed sequentially.
+        std::size_t threads = 1;
+
+        // if set, filled in with the time and memory the load took, which costs a little extra time
+        LoadStats* stats = nullptr;
+
+        // everything that isn't needed to decode/encode messages and to map raw values to their descriptions
+        static LoadOptions DecodeOnly();
+    };
+}
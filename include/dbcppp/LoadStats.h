@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "Export.h"
+
+namespace dbcppp
+{
+    // Where the time and memory of loading a network go, filled in if LoadOptions::stats is set.
+    struct DBCPPP_API LoadStats
+    {
+        struct Phase
+        {
+            std::string name;
+            double wall_time_ms = 0;
+            // only counted if the application reports its allocations, see CountAllocation
+            uint64_t allocations = 0;
+            uint64_t allocated_bytes = 0;
+        };
+        struct NodeCount
+        {
+            std::string name;
+            uint64_t count = 0;
+        };
+        struct Entity
+        {
+            std::string name;
+            uint64_t count = 0;
+            // counted like INetwork::MemoryUsage does
+            uint64_t bytes = 0;
+        };
+
+        // in the order they ran in
+        std::vector<Phase> phases;
+        // the statements the parser produced (signals are counted separately from their messages),
+        // statements skipped because of the LoadOptions aren't counted
+        std::vector<NodeCount> ast_nodes;
+        // the objects of the loaded network by entity type
+        std::vector<Entity> footprint;
+        // whether any allocation has been reported yet
+        bool allocations_counted = false;
+
+        // The library can't count allocations on its own. An application which wants the allocation counts
+        // calls this from its replacement of the global operator new, see tools/dbcppp/CountAllocations.cpp.
+        // The counters are process wide, so allocations of other threads during a load are counted as well.
+        static void CountAllocation(std::size_t size);
+    };
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Export.h"
+
+namespace dbcppp
+{
+    // Bytes a network occupies by category: its objects and the heap memory their strings and vectors own,
+    // including unused capacity, but without the overhead of the allocator.
+    struct DBCPPP_API MemoryUsageBreakdown
+    {
+        // the signal objects, with everything decoding needs, and the fixed size parts of their strings and vectors
+        uint64_t signal_hot_data = 0;
+        // names of signals, messages, nodes, environment variables, value tables and signal groups
+        // as well as the node names of senders and receivers
+        uint64_t names = 0;
+        uint64_t comments = 0;
+        // attribute definitions, defaults and values
+        uint64_t attributes = 0;
+        // value descriptions, value tables and signal types
+        uint64_t value_descriptions = 0;
+        // extended multiplexing (SG_MUL_VAL_)
+        uint64_t mux_metadata = 0;
+        // the message pointers and the lookup tables of MessageById and MessageByJ1939Id once they are built
+        uint64_t indices = 0;
+        // the remaining objects (messages, nodes, ...), units, version and new symbols
+        uint64_t other = 0;
+
+        uint64_t Total() const
+        {
+            return signal_hot_data + names + comments + attributes + value_descriptions + mux_metadata + indices + other;
+        }
+    };
+}
@@ -10,6 +10,7 @@
 #include "Signal.h"
 #include "Attribute.h"
 #include "SignalGroup.h"
+#include "Hash128.h"
 
 namespace dbcppp
 {
@@ -58,6 +59,10 @@ namespace dbcppp
         DBCPPP_MAKE_ITERABLE(IMessage, AttributeValues, IAttribute);
         DBCPPP_MAKE_ITERABLE(IMessage, SignalGroups, ISignalGroup);
         
+        // Hash over everything operator== compares, unordered like operator== where it searches the elements.
+        // Stable across runs and platforms, computed on first use and cached.
+        virtual Hash128 Fingerprint() const = 0;
+
         virtual bool operator==(const IMessage& message) const = 0;
         virtual bool operator!=(const IMessage& message) const = 0;
 
@@ -19,6 +19,10 @@
 #include "SignalType.h"
 #include "AttributeDefinition.h"
 #include "Attribute.h"
+#include "LoadOptions.h"
+#include "MemoryUsageBreakdown.h"
+#include "Hash128.h"
+#include "J1939Id.h"
 
 namespace dbcppp
 {
@@ -41,6 +45,16 @@ namespace dbcppp
         static std::unique_ptr<INetwork> LoadNetworkFromFile(const std::filesystem::path& filename, std::string& error_message);
         static std::unique_ptr<INetwork> LoadDBCFromIs(std::istream &is);
         static std::unique_ptr<INetwork> LoadDBCFromIs(std::istream &is, std::string& error_message);
+        static std::unique_ptr<INetwork> LoadNetworkFromFile(const std::filesystem::path& filename, const LoadOptions& options, std::string& error_message);
+        static std::unique_ptr<INetwork> LoadDBCFromIs(std::istream &is, const LoadOptions& options, std::string& error_message);
+        // Loads the files on up to options.threads threads and merges them in the given order, like
+        // calling Merge for each of them. error_messages receives one message per file, empty if the file
+        // loaded. If any file failed to load nullptr is returned. options.stats receives the phases
+        // "load files" and "merge" only.
+        static std::unique_ptr<INetwork> LoadNetworksFromFiles(
+              const std::vector<std::filesystem::path>& filenames
+            , const LoadOptions& options
+            , std::vector<std::string>& error_messages);
 
 
         virtual std::unique_ptr<INetwork> Clone() const = 0;
@@ -76,10 +90,29 @@ namespace dbcppp
         DBCPPP_MAKE_ITERABLE(INetwork, AttributeValues, IAttribute);
 
         virtual const IMessage* ParentMessage(const ISignal* sig) const = 0;
+        // Message with the given id or nullptr, the first one if several messages share the id.
+        // The lookup table is built on first use and dropped when the messages are modified.
+        virtual const IMessage* MessageById(uint64_t id) const = 0;
+        // J1939: the message with the PGN and source address of the 29 bit can_id, else the first one with its PGN,
+        // or nullptr. Priority and destination address of the frame don't matter. Only messages with extended ids
+        // are looked up, the first one wins if several messages share PGN and source address. id, if given,
+        // receives the parsed can_id.
+        // The lookup table is built on first use and dropped when the messages are modified.
+        virtual const IMessage* MessageByJ1939Id(uint32_t can_id, J1939::Id* id = nullptr) const = 0;
+        // Walks the whole network, the messages a clone shares with this network are counted by both.
+        virtual MemoryUsageBreakdown MemoryUsage() const = 0;
+
+        // Hash over everything operator== compares, unordered like operator== where it searches the elements.
+        // Stable across runs and platforms, computed on first use and cached.
+        virtual Hash128 Fingerprint() const = 0;
 
         virtual bool operator==(const INetwork& rhs) const = 0;
         virtual bool operator!=(const INetwork& rhs) const = 0;
 
         void Merge(std::unique_ptr<INetwork>&& other);
+        // Merges all networks in order into the first one and returns it, equivalent to calling Merge
+        // for each of them, but the lookup indices of the merged network are only built once.
+        // Null entries are ignored, networks is empty afterwards.
+        static std::unique_ptr<INetwork> MergeAll(std::vector<std::unique_ptr<INetwork>>&& networks);
     };
 }
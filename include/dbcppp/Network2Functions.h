@@ -15,6 +15,11 @@ namespace dbcppp
     {
         DBCPPP_API std::ostream& operator<<(std::ostream& os, const INetwork& net);
     }
+    namespace Network2Cpp
+    {
+        // header only C++17 code with a type per message and signal, see the generated header
+        DBCPPP_API std::ostream& operator<<(std::ostream& os, const INetwork& net);
+    }
     namespace Network2DBC
     {
         using na_t = std::tuple<const INetwork&, const IAttribute&>;
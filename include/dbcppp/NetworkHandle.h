@@ -0,0 +1,176 @@
+#pragma once
+
+#include <any>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "Export.h"
+#include "Network.h"
+
+namespace dbcppp
+{
+    // One published version of a network together with everything derived from it at publish time.
+    // A snapshot never changes, so it can be used from any number of threads without synchronization.
+    class DBCPPP_API NetworkSnapshot
+    {
+    public:
+        NetworkSnapshot(std::unique_ptr<const INetwork>&& network, std::any&& attachment, uint64_t version);
+
+        const INetwork& Network() const;
+        // counts the versions published to the handle, starting with 1
+        uint64_t Version() const;
+        const IMessage* MessageById(uint64_t id) const;
+        // user data published together with the network, e.g. decode plans built for it
+        const std::any& Attachment() const;
+
+    private:
+        std::unique_ptr<const INetwork> _network;
+        std::unordered_map<uint64_t, const IMessage*> _messages_by_id;
+        std::any _attachment;
+        uint64_t _version;
+    };
+
+    // Holds the current version of a network, which can be replaced while other threads keep decoding
+    // (read-copy-update). Readers never block or allocate: they announce the epoch they entered in their
+    // own slot and load the current snapshot. A replaced snapshot is retired and freed by the writer
+    // (on the next Publish or Reclaim) once every reader has left the epochs in which it could see it,
+    // so the destruction of old networks never happens on a decoding thread.
+    class DBCPPP_API NetworkHandle
+    {
+        struct alignas(64) Slot
+        {
+            static constexpr uint64_t idle = UINT64_MAX;
+
+            std::atomic<uint64_t> epoch{idle};
+            std::atomic<bool> used{false};
+        };
+
+    public:
+        // Keeps the snapshot it was created with alive until it is destroyed. Hold it while decoding one
+        // frame (or a batch of frames) and take a new one for the next, to pick up new versions.
+        class ReadGuard
+        {
+        public:
+            ReadGuard(ReadGuard&& other) noexcept
+                : _slot(other._slot)
+                , _snapshot(other._snapshot)
+            {
+                other._slot = nullptr;
+            }
+            ReadGuard(const ReadGuard&) = delete;
+            ReadGuard& operator=(const ReadGuard&) = delete;
+            ReadGuard& operator=(ReadGuard&&) = delete;
+            ~ReadGuard()
+            {
+                if (_slot)
+                {
+                    _slot->epoch.store(Slot::idle, std::memory_order_release);
+                }
+            }
+
+            // false if nothing was published yet
+            explicit operator bool() const
+            {
+                return _snapshot != nullptr;
+            }
+            const NetworkSnapshot& operator*() const
+            {
+                return *_snapshot;
+            }
+            const NetworkSnapshot* operator->() const
+            {
+                return _snapshot;
+            }
+
+        private:
+            friend class NetworkHandle;
+
+            ReadGuard(Slot* slot, const NetworkSnapshot* snapshot)
+                : _slot(slot)
+                , _snapshot(snapshot)
+            {}
+
+            Slot* _slot;
+            const NetworkSnapshot* _snapshot;
+        };
+        // Reader slot of one thread, at most one ReadGuard of a reader may exist at a time.
+        class DBCPPP_API Reader
+        {
+        public:
+            Reader(Reader&& other) noexcept;
+            Reader(const Reader&) = delete;
+            Reader& operator=(const Reader&) = delete;
+            Reader& operator=(Reader&&) = delete;
+            ~Reader();
+
+            ReadGuard Lock()
+            {
+                // the epoch has to be visible to the writer before the snapshot is loaded, the writer
+                // retires a snapshot before it advances the epoch (both sequentially consistent)
+                _slot->epoch.store(_handle->_epoch.load());
+                return ReadGuard(_slot, _handle->_current.load());
+            }
+
+        private:
+            friend class NetworkHandle;
+
+            Reader(NetworkHandle& handle, Slot& slot);
+
+            NetworkHandle* _handle;
+            Slot* _slot;
+        };
+
+        explicit NetworkHandle(std::size_t max_readers = 64);
+        NetworkHandle(const NetworkHandle&) = delete;
+        NetworkHandle& operator=(const NetworkHandle&) = delete;
+        // all readers have to be destroyed before the handle
+        ~NetworkHandle();
+
+        // throws std::runtime_error if all max_readers slots are in use
+        Reader CreateReader();
+        // Makes network the current version and returns its version number. The message id index of
+        // the snapshot and the attachment are built before the snapshot becomes visible to readers.
+        uint64_t Publish(std::unique_ptr<const INetwork>&& network, std::any attachment = std::any());
+        // Frees the retired snapshots no reader can use anymore, returns the number of those still in use.
+        std::size_t Reclaim();
+
+    private:
+        std::size_t ReclaimLocked();
+
+        std::atomic<const NetworkSnapshot*> _current{nullptr};
+        std::atomic<uint64_t> _epoch{0};
+        std::unique_ptr<Slot[]> _slots;
+        std::size_t _max_readers;
+
+        std::mutex _writer_mutex;
+        struct Retired
+        {
+            const NetworkSnapshot* snapshot;
+            uint64_t epoch;
+        };
+        std::vector<Retired> _retired;
+        uint64_t _version = 0;
+    };
+
+    // Named network handles, e.g. one per bus.
+    class DBCPPP_API NetworkRegistry
+    {
+    public:
+        explicit NetworkRegistry(std::size_t max_readers = 64);
+
+        // creates the handle on first use, the returned reference stays valid as long as the registry
+        NetworkHandle& Handle(const std::string& name);
+        // nullptr if there is no handle with that name
+        NetworkHandle* Find(const std::string& name);
+
+    private:
+        std::size_t _max_readers;
+        std::mutex _mutex;
+        std::unordered_map<std::string, std::unique_ptr<NetworkHandle>> _handles;
+    };
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "Export.h"
+#include "Message.h"
+
+namespace dbcppp
+{
+    // A condition on the physical values of the signals of one message, e.g. "VehicleSpeed > 100 && Gear == 3",
+    // compiled into comparisons of the raw values, so evaluating it needs no RawToPhys. The raw bounds are
+    // exact: a comparison holds for a raw value if and only if it holds for ISignal::RawToPhys of it, for any
+    // factor, offset, sign and for float and double signals. Equality tests of integer signals in the first
+    // 8 bytes are evaluated together on the masked first 64 bit word of the frame.
+    // Multiplexed signals are compared whether the frame selects them or not.
+    // Immutable once created, so it can be used from any number of threads.
+    class DBCPPP_API Predicate
+    {
+    public:
+        enum class EOperator
+        {
+            Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual
+        };
+        struct Comparison
+        {
+            const ISignal* signal;
+            EOperator op;
+            double value;
+        };
+
+        // The predicate holds if all comparisons of one of the conjunctions in any_of hold.
+        // nullptr if a signal isn't one of msg.
+        static std::unique_ptr<Predicate> Create(const IMessage& msg, const std::vector<std::vector<Comparison>>& any_of, std::string& error_message);
+        // expression: comparisons of a signal of msg with a number (==, !=, <, <=, >, >=), joined by && and ||,
+        // && binds stronger. nullptr if the expression can't be parsed.
+        static std::unique_ptr<Predicate> Parse(const IMessage& msg, const std::string& expression, std::string& error_message);
+
+        const IMessage& Message() const;
+        // The frame has to be readable like for ISignal::Decode.
+        bool Evaluate(const void* data) const;
+        // raw: the values ISignal::Decode returns for the signals of the message, in signal order
+        bool EvaluateRaw(const ISignal::raw_t* raw) const;
+
+    private:
+        enum class EKey : uint8_t
+        {
+            Unsigned, Signed, Float, Double
+        };
+        // holds if the order key of the raw value lies in [lo, lo + width], or doesn't if negate is set
+        struct Term
+        {
+            const ISignal* signal;
+            std::size_t index;
+            EKey key;
+            bool negate;
+            uint64_t lo;
+            uint64_t width;
+        };
+        struct Conjunction
+        {
+            // all terms, for EvaluateRaw
+            uint32_t first_term;
+            uint32_t terms;
+            // the terms which aren't covered by mask and pattern, for Evaluate
+            uint32_t first_decoded_term;
+            uint32_t decoded_terms;
+            uint64_t mask;
+            uint64_t pattern;
+        };
+
+        explicit Predicate(const IMessage& msg);
+        static bool Holds(const Term& term, ISignal::raw_t raw);
+        static uint64_t OrderKey(EKey key, ISignal::raw_t raw);
+        static ISignal::raw_t RawOf(EKey key, uint64_t order_key);
+
+        const IMessage* _message;
+        std::vector<Term> _terms;
+        std::vector<Term> _decoded_terms;
+        std::vector<Conjunction> _conjunctions;
+    };
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "Export.h"
+#include "Network.h"
+
+namespace dbcppp
+{
+    // The subset of the signals of a network a consumer decodes. Frames of messages without a selected signal
+    // are rejected with one id lookup, the others decode only the selected signals and the multiplexer switches
+    // which decide whether those are present.
+    // Immutable once created, so it can be used from any number of threads.
+    class DBCPPP_API Projection
+    {
+    public:
+        struct Message
+        {
+            const IMessage* message;
+            // the selected signals in the order of the message
+            std::vector<const ISignal*> signals;
+            // the switches the selected signals depend on, directly or through another switch
+            std::vector<const ISignal*> switches;
+        };
+
+        // nullptr if a signal isn't one of net
+        static std::unique_ptr<Projection> Create(const INetwork& net, const std::vector<const ISignal*>& signals, std::string& error_message);
+        // names: "Message.Signal", or "Signal" for the signals with that name in all messages.
+        // nullptr if a name matches no signal.
+        static std::unique_ptr<Projection> Create(const INetwork& net, const std::vector<std::string>& names, std::string& error_message);
+        ~Projection();
+        Projection(const Projection&) = delete;
+        Projection& operator=(const Projection&) = delete;
+
+        // nullptr if no signal of the message with the id is selected
+        const Message* Find(uint64_t id) const;
+        // Writes the physical values of the selected signals of msg, which has to be one of this projection,
+        // to values, NaN for signals which aren't present. Returns the number of values, msg.signals.size().
+        // The frame has to be readable like for ISignal::Decode.
+        std::size_t Decode(const Message& msg, const void* data, double* values) const;
+        // Find and Decode, nullptr if no signal of the message with the id is selected
+        const Message* Decode(uint64_t id, const void* data, double* values) const;
+
+        const Message& Messages_Get(std::size_t i) const;
+        std::size_t Messages_Size() const;
+        // the greatest number of selected signals of a message, the values Decode needs at most
+        std::size_t MaxSignalsPerMessage() const;
+
+    private:
+        class Impl;
+
+        explicit Projection(std::unique_ptr<Impl>&& impl);
+
+        std::unique_ptr<Impl> _impl;
+    };
+}
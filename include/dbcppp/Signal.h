@@ -12,6 +12,7 @@
 #include "Attribute.h"
 #include "SignalMultiplexerValue.h"
 #include "ValueEncodingDescription.h"
+#include "Hash128.h"
 
 namespace dbcppp
 {
@@ -94,6 +95,10 @@ namespace dbcppp
 
         virtual bool Error(EErrorCode code) const = 0;
         
+        // Hash over everything operator== compares, unordered like operator== where it searches the elements.
+        // Stable across runs and platforms, computed on first use and cached.
+        virtual Hash128 Fingerprint() const = 0;
+
         virtual bool operator==(const ISignal& rhs) const = 0;
         virtual bool operator!=(const ISignal& rhs) const = 0;
         
@@ -0,0 +1,383 @@
+#pragma once
+
+#include <ratio>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <cstring>
+
+#include "Signal.h"
+
+namespace dbcppp
+{
+    // How a signal lies in the 64 bit words of a frame, decides which memory accesses decoding needs.
+    enum class Alignment
+    {
+        size_inbetween_first_64_bit,
+        signal_exceeds_64_bit_size_but_signal_fits_into_64_bit,
+        signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit
+    };
+    // the values decoding precomputes from the position of a signal
+    struct SignalLayout
+    {
+        Alignment alignment;
+        uint64_t byte_pos;
+        uint64_t fixed_start_bit_0;
+        uint64_t fixed_start_bit_1;
+        uint64_t mask;
+        uint64_t mask_signed;
+    };
+    constexpr SignalLayout make_signal_layout(uint64_t start_bit, uint64_t bit_size, ISignal::EByteOrder byte_order) noexcept
+    {
+        SignalLayout result{Alignment::size_inbetween_first_64_bit, 0, 0, 0, 0, 0};
+        result.mask = (1ull << (bit_size - 1ull) << 1ull) - 1;
+        result.mask_signed = ~((1ull << (bit_size - 1ull)) - 1);
+
+        result.byte_pos = start_bit / 8;
+
+        uint64_t nbytes = 0;
+        if (byte_order == ISignal::EByteOrder::LittleEndian)
+        {
+            nbytes = (start_bit % 8 + bit_size + 7) / 8;
+        }
+        else
+        {
+            nbytes = (bit_size + (7 - start_bit % 8) + 7) / 8;
+        }
+        // check whether the data is in the first 8 bytes
+        // so we can optimize out one memory access
+        if (result.byte_pos + nbytes <= 8)
+        {
+            result.alignment = Alignment::size_inbetween_first_64_bit;
+            if (byte_order == ISignal::EByteOrder::LittleEndian)
+            {
+                result.fixed_start_bit_0 = start_bit;
+            }
+            else
+            {
+                result.fixed_start_bit_0 = (8 * (7 - (start_bit / 8))) + (start_bit % 8) - (bit_size - 1);
+            }
+        }
+        // check whether we can align the data on 64 bit
+        else if (result.byte_pos % 8 + nbytes <= 8)
+        {
+            result.alignment = Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit;
+            // align the byte pos on 64 bit
+            result.byte_pos -= result.byte_pos % 8;
+            result.fixed_start_bit_0 = start_bit - result.byte_pos * 8;
+            if (byte_order == ISignal::EByteOrder::BigEndian)
+            {
+                result.fixed_start_bit_0 = (8 * (7 - (result.fixed_start_bit_0 / 8))) + (result.fixed_start_bit_0 % 8) - (bit_size - 1);
+            }
+        }
+        // we aren't able to align the data on 64 bit, so check whether the data fits into on uint64_t
+        else if (nbytes <= 8)
+        {
+            result.alignment = Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit;
+            result.fixed_start_bit_0 = start_bit - result.byte_pos * 8;
+            if (byte_order == ISignal::EByteOrder::BigEndian)
+            {
+                result.fixed_start_bit_0 = (8 * (7 - (result.fixed_start_bit_0 / 8))) + (result.fixed_start_bit_0 % 8) - (bit_size - 1);
+            }
+        }
+        // we aren't able to align the data on 64 bit, and we aren't able to fit the data into one uint64_t
+        // so we have to compose the resulting value
+        else
+        {
+            result.alignment = Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit;
+            if (byte_order == ISignal::EByteOrder::BigEndian)
+            {
+                uint64_t nbits_last_byte = (7 - start_bit % 8) + bit_size - 64;
+                result.fixed_start_bit_0 = nbits_last_byte;
+                result.fixed_start_bit_1 = 8 - nbits_last_byte;
+                result.mask = (1ull << (start_bit % 8 + 57)) - 1;
+            }
+            else
+            {
+                result.fixed_start_bit_0 = start_bit - result.byte_pos * 8;
+                result.fixed_start_bit_1 = 64 - start_bit % 8;
+                uint64_t nbits_last_byte = bit_size + start_bit % 8 - 64;
+                result.mask = (1ull << nbits_last_byte) - 1ull;
+            }
+        }
+        return result;
+    }
+
+    // A signal whose layout is known at compile time, for tight loops which shouldn't pay for the function
+    // pointer dispatching of ISignal. It decodes and encodes exactly like ISignal (same raw_t representation,
+    // same memory accesses, so the frame has to be readable at least up to the end of the 64 bit word
+    // containing the signal), but everything is inlined and the integer paths are constexpr.
+    // Factor and Offset are std::ratio.
+    template <
+          uint64_t StartBit
+        , uint64_t BitSize
+        , ISignal::EByteOrder ByteOrder
+        , ISignal::EValueType ValueType = ISignal::EValueType::Unsigned
+        , ISignal::EExtendedValueType ExtendedValueType = ISignal::EExtendedValueType::Integer
+        , class Factor = std::ratio<1>
+        , class Offset = std::ratio<0>>
+    class static_signal
+    {
+        static_assert(BitSize >= 1 && BitSize <= 64, "the bit size of a signal has to be within [1, 64]");
+        static_assert(ExtendedValueType != ISignal::EExtendedValueType::Float || BitSize == 32, "float signals have 32 bits");
+        static_assert(ExtendedValueType != ISignal::EExtendedValueType::Double || BitSize == 64, "double signals have 64 bits");
+        static_assert(Factor::num != 0, "the factor must not be 0");
+
+    public:
+        using raw_t = ISignal::raw_t;
+
+        static constexpr uint64_t start_bit = StartBit;
+        static constexpr uint64_t bit_size = BitSize;
+        static constexpr ISignal::EByteOrder byte_order = ByteOrder;
+        static constexpr ISignal::EValueType value_type = ValueType;
+        static constexpr ISignal::EExtendedValueType extended_value_type = ExtendedValueType;
+        static constexpr double factor = double(Factor::num) / double(Factor::den);
+        static constexpr double offset = double(Offset::num) / double(Offset::den);
+        static constexpr SignalLayout layout = make_signal_layout(StartBit, BitSize, ByteOrder);
+
+        static constexpr raw_t decode(const uint8_t* bytes) noexcept
+        {
+            uint64_t data = 0;
+            if constexpr (layout.alignment == Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit)
+            {
+                uint64_t data1 = bytes[layout.byte_pos + 8];
+                if constexpr (ByteOrder == ISignal::EByteOrder::BigEndian)
+                {
+                    data = load_big(bytes + layout.byte_pos);
+                    data &= layout.mask;
+                    data <<= layout.fixed_start_bit_0;
+                    data1 >>= layout.fixed_start_bit_1;
+                    data |= data1;
+                }
+                else
+                {
+                    data = load_little(bytes + layout.byte_pos);
+                    data >>= layout.fixed_start_bit_0;
+                    data1 &= layout.mask;
+                    data1 <<= layout.fixed_start_bit_1;
+                    data |= data1;
+                }
+                if constexpr (ExtendedValueType != ISignal::EExtendedValueType::Integer)
+                {
+                    return data;
+                }
+            }
+            else
+            {
+                data = load(bytes + word_pos);
+                if constexpr (ExtendedValueType == ISignal::EExtendedValueType::Double)
+                {
+                    return data;
+                }
+                data >>= layout.fixed_start_bit_0;
+                data &= layout.mask;
+                if constexpr (ExtendedValueType == ISignal::EExtendedValueType::Float)
+                {
+                    return data;
+                }
+            }
+            if constexpr (ValueType == ISignal::EValueType::Signed)
+            {
+                if (data & layout.mask_signed)
+                {
+                    data |= layout.mask_signed;
+                }
+            }
+            return data;
+        }
+        static raw_t decode(const void* bytes) noexcept
+        {
+            return decode(static_cast<const uint8_t*>(bytes));
+        }
+        // only the bits of the signal are changed
+        static constexpr void encode(raw_t raw, uint8_t* bytes) noexcept
+        {
+            uint8_t* word = bytes + word_pos;
+            if constexpr (layout.alignment == Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit)
+            {
+                if constexpr (ByteOrder == ISignal::EByteOrder::BigEndian)
+                {
+                    uint64_t low_mask = (1ull << layout.fixed_start_bit_1) - 1;
+                    // the upper bits are in the word, the lowest fixed_start_bit_0 bits in the upper bits of the next byte
+                    store_big(word, (load_big(word) & ~layout.mask) | ((raw >> layout.fixed_start_bit_0) & layout.mask));
+                    word[8] = uint8_t((word[8] & low_mask) | (raw << layout.fixed_start_bit_1));
+                }
+                else
+                {
+                    // the lower bits are in the upper bits of the word, the rest in the lower bits of the next byte
+                    uint64_t keep = (1ull << layout.fixed_start_bit_0) - 1;
+                    store_little(word, (load_little(word) & keep) | (raw << layout.fixed_start_bit_0));
+                    word[8] = uint8_t((word[8] & ~layout.mask) | ((raw >> layout.fixed_start_bit_1) & layout.mask));
+                }
+            }
+            else
+            {
+                uint64_t mask = layout.mask << layout.fixed_start_bit_0;
+                store(word, (load(word) & ~mask) | ((raw << layout.fixed_start_bit_0) & mask));
+            }
+        }
+        static void encode(raw_t raw, void* bytes) noexcept
+        {
+            encode(raw, static_cast<uint8_t*>(bytes));
+        }
+        static constexpr double raw_to_phys(raw_t raw) noexcept
+        {
+            if constexpr (ExtendedValueType == ISignal::EExtendedValueType::Float)
+            {
+                uint32_t bits = uint32_t(raw);
+                float value = 0.f;
+                std::memcpy(&value, &bits, sizeof(value));
+                return double(value) * factor + offset;
+            }
+            else if constexpr (ExtendedValueType == ISignal::EExtendedValueType::Double)
+            {
+                double value = 0.;
+                std::memcpy(&value, &raw, sizeof(value));
+                return value * factor + offset;
+            }
+            else if constexpr (ValueType == ISignal::EValueType::Signed)
+            {
+                return double(int64_t(raw)) * factor + offset;
+            }
+            else
+            {
+                return double(raw) * factor + offset;
+            }
+        }
+        static constexpr raw_t phys_to_raw(double phys) noexcept
+        {
+            if constexpr (ExtendedValueType == ISignal::EExtendedValueType::Float)
+            {
+                // converting a double outside of the range of float is undefined, those saturate to infinity
+                double scaled = (phys - offset) / factor;
+                constexpr double float_max = std::numeric_limits<float>::max();
+                float value = scaled > float_max ? std::numeric_limits<float>::infinity()
+                    : scaled < -float_max ? -std::numeric_limits<float>::infinity() : float(scaled);
+                uint32_t bits = 0;
+                std::memcpy(&bits, &value, sizeof(bits));
+                return bits;
+            }
+            else if constexpr (ExtendedValueType == ISignal::EExtendedValueType::Double)
+            {
+                double value = (phys - offset) / factor;
+                raw_t raw = 0;
+                std::memcpy(&raw, &value, sizeof(raw));
+                return raw;
+            }
+            else if constexpr (ValueType == ISignal::EValueType::Signed)
+            {
+                // clamped to the raw values of the signal like the unsigned ones, NaN maps to 0
+                constexpr int64_t max = int64_t((1ull << (bit_size - 1)) - 1);
+                constexpr int64_t min = -max - 1;
+                double value = (phys - offset) / factor;
+                if (value != value)
+                {
+                    return 0;
+                }
+                if (value < double(min))
+                {
+                    return raw_t(min);
+                }
+                // 2^(bit_size - 1) is exact as a double, max might not be
+                if (value >= -double(min))
+                {
+                    return raw_t(max);
+                }
+                return raw_t(int64_t(value));
+            }
+            else
+            {
+                // clamped to the raw values of the signal, converting a negative or too large double to an
+                // unsigned integer is undefined
+                constexpr raw_t max = (1ull << (bit_size - 1) << 1) - 1;
+                double value = (phys - offset) / factor;
+                if (!(value > 0.))
+                {
+                    return 0;
+                }
+                if (value >= 18446744073709551616.)
+                {
+                    return max;
+                }
+                return std::min(raw_t(value), max);
+            }
+        }
+        static constexpr double decode_phys(const uint8_t* bytes) noexcept
+        {
+            return raw_to_phys(decode(bytes));
+        }
+
+        // Whether the runtime signal has the same layout and conversion, e.g. to check at startup that
+        // the compiled in signals still match the DBC the application loaded.
+        static bool matches(const ISignal& sig) noexcept
+        {
+            return sig.StartBit() == StartBit
+                && sig.BitSize() == BitSize
+                && sig.ByteOrder() == ByteOrder
+                && sig.ValueType() == ValueType
+                && sig.ExtendedValueType() == ExtendedValueType
+                && sig.Factor() == factor
+                && sig.Offset() == offset;
+        }
+
+    private:
+        // the signals in the first 64 bit are decoded from the first word regardless of the byte_pos
+        static constexpr uint64_t word_pos = layout.alignment == Alignment::size_inbetween_first_64_bit ? 0 : layout.byte_pos;
+
+        // byte order conversion by shifts, compilers turn these into a single load (and byte swap)
+        static constexpr uint64_t load_little(const uint8_t* bytes) noexcept
+        {
+            uint64_t result = 0;
+            for (std::size_t i = 0; i < 8; i++)
+            {
+                result |= uint64_t(bytes[i]) << (8 * i);
+            }
+            return result;
+        }
+        static constexpr uint64_t load_big(const uint8_t* bytes) noexcept
+        {
+            uint64_t result = 0;
+            for (std::size_t i = 0; i < 8; i++)
+            {
+                result = (result << 8) | bytes[i];
+            }
+            return result;
+        }
+        static constexpr void store_little(uint8_t* bytes, uint64_t value) noexcept
+        {
+            for (std::size_t i = 0; i < 8; i++)
+            {
+                bytes[i] = uint8_t(value >> (8 * i));
+            }
+        }
+        static constexpr void store_big(uint8_t* bytes, uint64_t value) noexcept
+        {
+            for (std::size_t i = 0; i < 8; i++)
+            {
+                bytes[i] = uint8_t(value >> (56 - 8 * i));
+            }
+        }
+        static constexpr uint64_t load(const uint8_t* bytes) noexcept
+        {
+            if constexpr (ByteOrder == ISignal::EByteOrder::BigEndian)
+            {
+                return load_big(bytes);
+            }
+            else
+            {
+                return load_little(bytes);
+            }
+        }
+        static constexpr void store(uint8_t* bytes, uint64_t value) noexcept
+        {
+            if constexpr (ByteOrder == ISignal::EByteOrder::BigEndian)
+            {
+                store_big(bytes, value);
+            }
+            else
+            {
+                store_little(bytes, value);
+            }
+        }
+    };
+}
@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <iostream>
 #include "AttributeDefinitionImpl.h"
+#include "MemoryCounter.h"
 
 using namespace dbcppp;
 
@@ -82,4 +83,14 @@ bool AttributeDefinitionImpl::operator==(const IAttributeDefinition& rhs) const
 bool AttributeDefinitionImpl::operator!=(const IAttributeDefinition& rhs) const
 {
     return !(*this == rhs);
-}
\ No newline at end of file
+}
+void AttributeDefinitionImpl::CountMemory(MemoryCounter& counter) const
+{
+    using EEntity = MemoryCounter::EEntity;
+    using ECategory = MemoryCounter::ECategory;
+    counter.Add(EEntity::AttributeDefinitions, ECategory::Attributes, _name);
+    if (auto enum_type = std::get_if<ValueTypeEnum>(&_value_type))
+    {
+        counter.Add(EEntity::AttributeDefinitions, ECategory::Attributes, enum_type->values);
+    }
+}
@@ -4,6 +4,8 @@
 
 namespace dbcppp
 {
+    class MemoryCounter;
+
     class AttributeDefinitionImpl final
         : public IAttributeDefinition
     {
@@ -19,6 +21,8 @@ namespace dbcppp
         virtual bool operator==(const IAttributeDefinition& rhs) const override;
         virtual bool operator!=(const IAttributeDefinition& rhs) const override;
 
+        void CountMemory(MemoryCounter& counter) const;
+
     private:
         std::string _name;
         EObjectType _object_type;
@@ -1,4 +1,5 @@
 #include "AttributeImpl.h"
+#include "MemoryCounter.h"
 #include "dbcppp/Network.h"
 
 using namespace dbcppp;
@@ -46,4 +47,14 @@ bool AttributeImpl::operator==(const IAttribute& rhs) const
 bool AttributeImpl::operator!=(const IAttribute& rhs) const
 {
     return !(*this == rhs);
-}
\ No newline at end of file
+}
+void AttributeImpl::CountMemory(MemoryCounter& counter) const
+{
+    using EEntity = MemoryCounter::EEntity;
+    using ECategory = MemoryCounter::ECategory;
+    counter.Add(EEntity::Attributes, ECategory::Attributes, _name);
+    if (auto str = std::get_if<std::string>(&_value))
+    {
+        counter.Add(EEntity::Attributes, ECategory::Attributes, *str);
+    }
+}
@@ -6,6 +6,8 @@
 
 namespace dbcppp
 {
+    class MemoryCounter;
+
     class AttributeImpl final
         : public IAttribute
     {
@@ -21,6 +23,8 @@ namespace dbcppp
         virtual bool operator==(const IAttribute& rhs) const override;
         virtual bool operator!=(const IAttribute& rhs) const override;
 
+        void CountMemory(MemoryCounter& counter) const;
+
     private:
         std::string _name;
         IAttributeDefinition::EObjectType _object_type;
@@ -1,9 +1,104 @@
+#include <cmath>
+#include <limits>
+#include <cstring>
+#include <algorithm>
 #include "dbcppp/CApi.h"
+#include "dbcppp/DecodeStats.h"
 #include "NetworkImpl.h"
 #include "EnvironmentVariableImpl.h"
 
 using namespace dbcppp;
 
+namespace
+{
+    // the decode functions read whole 64 bit words, so up to 8 bytes past the last byte of a signal
+    constexpr std::size_t decode_padding = 8;
+    // largest message of the J1939 transport protocol
+    constexpr std::size_t max_padded_frame_size = 1785 + decode_padding;
+
+    // Calls func with the frame, copied to a zero padded buffer if it's too short to be decoded in place.
+    // Returns false if the frame is shorter than the message.
+    template <class Func>
+    bool with_padded_frame(const MessageImpl& msg, const uint8_t* data, std::size_t len, Func&& func)
+    {
+        std::size_t size = msg.MessageSize();
+        if (len < size)
+        {
+            return false;
+        }
+        uint8_t padded[max_padded_frame_size];
+        if (len < size + decode_padding)
+        {
+            if (size + decode_padding > sizeof(padded))
+            {
+                return false;
+            }
+            std::memcpy(padded, data, len);
+            std::memset(padded + len, 0, size + decode_padding - len);
+            data = padded;
+        }
+        func(data);
+        return true;
+    }
+    std::size_t decode_all(const MessageImpl& msg, const uint8_t* data, std::size_t len, double* out, std::size_t capacity, DecodeStats* stats)
+    {
+        std::size_t count = std::min<std::size_t>(msg.signals().size(), capacity);
+        bool decoded = with_padded_frame(msg, data, len,
+            [&](const uint8_t* data)
+            {
+                const auto& signals = msg.signals();
+                const auto& conditions = msg.muxConditions();
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    const auto& sig = signals[i];
+                    out[i] = conditions.Present(i, data)
+                        ? sig.RawToPhys(sig.Decode(data))
+                        : std::numeric_limits<double>::quiet_NaN();
+                }
+                if (stats)
+                {
+                    stats->RecordDecoded(msg, data, out, count);
+                }
+            });
+        return decoded ? count : 0;
+    }
+    std::size_t decode_frames(
+          const NetworkImpl& net
+        , const uint32_t* ids
+        , const uint8_t* payloads
+        , std::size_t stride
+        , std::size_t n
+        , double* values
+        , std::size_t values_stride
+        , const dbcppp_Message** messages
+        , DecodeStats* stats)
+    {
+        std::size_t decoded = 0;
+        for (std::size_t i = 0; i < n; i++)
+        {
+            auto msgi = static_cast<const MessageImpl*>(net.MessageById(ids[i]));
+            if (!msgi && stats)
+            {
+                stats->RecordUnknownId(ids[i]);
+            }
+            if (msgi && stride < msgi->MessageSize())
+            {
+                msgi = nullptr;
+            }
+            if (msgi)
+            {
+                decode_all(*msgi, payloads + i * stride, stride, values + i * values_stride, values_stride, stats);
+                decoded++;
+            }
+            if (messages)
+            {
+                messages[i] = reinterpret_cast<const dbcppp_Message*>(msgi);
+            }
+        }
+        return decoded;
+    }
+}
+
 extern "C"
 {
     DBCPPP_API const dbcppp_Attribute* dbcppp_AttributeCreate(
@@ -551,6 +646,11 @@ extern "C"
         auto msgi = reinterpret_cast<const MessageImpl*>(msg);
         return msgi->Comment().c_str();
     }
+    DBCPPP_API uint64_t dbcppp_MessageDecodeAll(const dbcppp_Message* msg, const uint8_t* data, size_t len, double* out)
+    {
+        auto msgi = reinterpret_cast<const MessageImpl*>(msg);
+        return decode_all(*msgi, data, len, out, msgi->Signals_Size(), nullptr);
+    }
 
     DBCPPP_API const dbcppp_Network* dbcppp_NetworkCreate(
           const char* version
@@ -688,6 +788,45 @@ extern "C"
         auto neti = reinterpret_cast<const NetworkImpl*>(net);
         return neti->Messages_Size();
     }
+    DBCPPP_API const dbcppp_Message* dbcppp_NetworkMessageById(const dbcppp_Network* net, uint64_t id)
+    {
+        auto neti = reinterpret_cast<const NetworkImpl*>(net);
+        return reinterpret_cast<const dbcppp_Message*>(neti->MessageById(id));
+    }
+    DBCPPP_API const dbcppp_Message* dbcppp_NetworkMessageByJ1939Id(const dbcppp_Network* net, uint32_t can_id, dbcppp_J1939Id* id)
+    {
+        auto neti = reinterpret_cast<const NetworkImpl*>(net);
+        J1939::Id parsed;
+        auto msg = neti->MessageByJ1939Id(can_id, &parsed);
+        if (id)
+        {
+            *id = {parsed.priority, parsed.pgn, parsed.source, parsed.destination};
+        }
+        return reinterpret_cast<const dbcppp_Message*>(msg);
+    }
+    DBCPPP_API uint64_t dbcppp_NetworkMaxSignalsPerMessage(const dbcppp_Network* net)
+    {
+        auto neti = reinterpret_cast<const NetworkImpl*>(net);
+        uint64_t result = 0;
+        for (const IMessage& msg : neti->Messages())
+        {
+            result = std::max(result, msg.Signals_Size());
+        }
+        return result;
+    }
+    DBCPPP_API size_t dbcppp_NetworkDecodeFrames(
+          const dbcppp_Network* net
+        , const uint32_t* ids
+        , const uint8_t* payloads
+        , size_t stride
+        , size_t n
+        , double* values
+        , size_t values_stride
+        , const dbcppp_Message** messages)
+    {
+        auto neti = reinterpret_cast<const NetworkImpl*>(net);
+        return decode_frames(*neti, ids, payloads, stride, n, values, values_stride, messages, nullptr);
+    }
     DBCPPP_API const dbcppp_EnvironmentVariable* dbcppp_NetworkEnvironmentVariables_Get(const dbcppp_Network* net, uint64_t i)
     {
         auto neti = reinterpret_cast<const NetworkImpl*>(net);
@@ -1195,4 +1334,85 @@ extern "C"
         auto ved = reinterpret_cast<const ValueEncodingDescriptionImpl*>(cved);
         return ved->Description().c_str();
     }
-}
\ No newline at end of file
+
+    DBCPPP_API dbcppp_DecodeStats* dbcppp_DecodeStatsCreate(const dbcppp_Network* net)
+    {
+        auto neti = reinterpret_cast<const NetworkImpl*>(net);
+        return reinterpret_cast<dbcppp_DecodeStats*>(new DecodeStats(*neti));
+    }
+    DBCPPP_API void dbcppp_DecodeStatsFree(dbcppp_DecodeStats* stats)
+    {
+        delete reinterpret_cast<DecodeStats*>(stats);
+    }
+    DBCPPP_API void dbcppp_DecodeStatsEnable(dbcppp_DecodeStats* stats, int enabled)
+    {
+        reinterpret_cast<DecodeStats*>(stats)->Enable(enabled != 0);
+    }
+    DBCPPP_API void dbcppp_DecodeStatsRecordFrames(
+          dbcppp_DecodeStats* stats
+        , const uint32_t* ids
+        , const uint8_t* payloads
+        , size_t stride
+        , size_t n)
+    {
+        auto statsi = reinterpret_cast<DecodeStats*>(stats);
+        if (!statsi->Enabled())
+        {
+            return;
+        }
+        for (size_t i = 0; i < n; i++)
+        {
+            auto msgi = static_cast<const MessageImpl*>(statsi->Network().MessageById(ids[i]));
+            if (!msgi)
+            {
+                statsi->RecordUnknownId(ids[i]);
+                continue;
+            }
+            with_padded_frame(*msgi, payloads + i * stride, stride,
+                [&](const uint8_t* data)
+                {
+                    statsi->RecordFrame(ids[i], data);
+                });
+        }
+    }
+    DBCPPP_API size_t dbcppp_DecodeStatsDecodeFrames(
+          dbcppp_DecodeStats* stats
+        , const uint32_t* ids
+        , const uint8_t* payloads
+        , size_t stride
+        , size_t n
+        , double* values
+        , size_t values_stride
+        , const dbcppp_Message** messages)
+    {
+        auto statsi = reinterpret_cast<DecodeStats*>(stats);
+        auto neti = static_cast<const NetworkImpl*>(&statsi->Network());
+        return decode_frames(*neti, ids, payloads, stride, n, values, values_stride, messages, statsi);
+    }
+    DBCPPP_API uint64_t dbcppp_DecodeStatsSnapshot(
+          const dbcppp_DecodeStats* stats
+        , dbcppp_MessageDecodeStats* messages
+        , uint64_t messages_size
+        , dbcppp_MessageDecodeStats* total)
+    {
+        auto statsi = reinterpret_cast<const DecodeStats*>(stats);
+        auto snapshot = statsi->Snapshot();
+        auto convert =
+            [](const MessageDecodeStats& stats)
+            {
+                return dbcppp_MessageDecodeStats{stats.frames, stats.signals_out_of_range, stats.unmatched_mux};
+            };
+        if (messages)
+        {
+            for (uint64_t i = 0; i < std::min<uint64_t>(messages_size, snapshot.messages.size()); i++)
+            {
+                messages[i] = convert(snapshot.messages[i]);
+            }
+        }
+        if (total)
+        {
+            *total = convert(snapshot.total);
+        }
+        return snapshot.unknown_ids;
+    }
+}
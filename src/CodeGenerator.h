@@ -0,0 +1,231 @@
+#pragma once
+
+#include <set>
+#include <map>
+#include <limits>
+#include <locale>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+#include "dbcppp/Network.h"
+
+// helpers shared by the code generators (Network2C, Network2Cpp)
+namespace dbcppp
+{
+    namespace CodeGenerator
+    {
+        inline std::string hex(uint64_t value)
+        {
+            std::ostringstream ss;
+            ss << "0x" << std::hex << value << "ull";
+            return ss.str();
+        }
+        // double literal which reads back as the same value
+        inline std::string literal(double value)
+        {
+            std::ostringstream ss;
+            ss.imbue(std::locale::classic());
+            ss << std::setprecision(17) << value;
+            std::string result = ss.str();
+            if (result.find_first_of(".e") == std::string::npos)
+            {
+                result += ".0";
+            }
+            return result;
+        }
+        inline std::string integer(uint64_t value)
+        {
+            return value > uint64_t(std::numeric_limits<int32_t>::max()) ? std::to_string(value) + "ull" : std::to_string(value);
+        }
+        inline bool is_signed(const ISignal& sig)
+        {
+            return sig.ExtendedValueType() == ISignal::EExtendedValueType::Integer
+                && sig.ValueType() == ISignal::EValueType::Signed;
+        }
+        // the bits of a signal which lie in one byte of the frame
+        struct Segment
+        {
+            uint64_t byte;
+            // position of the lowest bit of the segment within the byte
+            uint64_t lsb;
+            uint64_t width;
+            // position of the lowest bit of the segment within the raw value
+            uint64_t shift;
+        };
+        inline std::vector<Segment> segments(const ISignal& sig)
+        {
+            std::vector<Segment> result;
+            uint64_t remaining = sig.BitSize();
+            if (sig.ByteOrder() == ISignal::EByteOrder::LittleEndian)
+            {
+                // the start bit is the least significant bit, the value continues with the higher bits
+                uint64_t bit = sig.StartBit();
+                while (remaining)
+                {
+                    uint64_t lsb = bit % 8;
+                    uint64_t width = std::min(8 - lsb, remaining);
+                    result.push_back({bit / 8, lsb, width, sig.BitSize() - remaining});
+                    bit += width;
+                    remaining -= width;
+                }
+            }
+            else
+            {
+                // the start bit is the most significant bit, the value continues with the lower bits
+                // of the same byte and then with bit 7 of the next byte
+                uint64_t byte = sig.StartBit() / 8;
+                uint64_t msb = sig.StartBit() % 8;
+                while (remaining)
+                {
+                    uint64_t width = std::min(msb + 1, remaining);
+                    remaining -= width;
+                    result.push_back({byte, msb + 1 - width, width, remaining});
+                    byte++;
+                    msb = 7;
+                }
+            }
+            return result;
+        }
+        // number of bytes a frame must have to contain all signals of the message
+        inline uint64_t frame_size(const IMessage& msg)
+        {
+            uint64_t size = msg.MessageSize();
+            for (const ISignal& sig : msg.Signals())
+            {
+                for (const auto& seg : segments(sig))
+                {
+                    size = std::max(size, seg.byte + 1);
+                }
+            }
+            return size;
+        }
+        // message names are only unique together with the id
+        inline std::vector<std::pair<const IMessage*, std::string>> message_names(const INetwork& net)
+        {
+            std::map<std::string, std::size_t> name_count;
+            for (const IMessage& msg : net.Messages())
+            {
+                name_count[msg.Name()]++;
+            }
+            std::vector<std::pair<const IMessage*, std::string>> result;
+            for (const IMessage& msg : net.Messages())
+            {
+                std::string name = name_count[msg.Name()] > 1 ? msg.Name() + "_" + std::to_string(msg.Id()) : msg.Name();
+                result.push_back({&msg, name});
+            }
+            return result;
+        }
+        inline const ISignal* find_signal(const IMessage& msg, const std::string& name)
+        {
+            for (const ISignal& sig : msg.Signals())
+            {
+                if (sig.Name() == name)
+                {
+                    return &sig;
+                }
+            }
+            return nullptr;
+        }
+        // the switches the presence of a multiplexed signal depends on
+        inline std::vector<const ISignal*> multiplexer_switches(const IMessage& msg, const ISignal& sig)
+        {
+            std::vector<const ISignal*> result;
+            if (sig.MultiplexerIndicator() != ISignal::EMultiplexer::MuxValue)
+            {
+                return result;
+            }
+            if (sig.SignalMultiplexerValues_Size())
+            {
+                for (const auto& smv : sig.SignalMultiplexerValues())
+                {
+                    if (const auto* sw = find_signal(msg, smv.SwitchName()))
+                    {
+                        result.push_back(sw);
+                    }
+                }
+            }
+            else if (msg.MuxSignal())
+            {
+                result.push_back(msg.MuxSignal());
+            }
+            return result;
+        }
+        // number of switches between the signal and a signal which is always present
+        inline std::size_t multiplexer_depth(const IMessage& msg, const ISignal& sig, std::set<const ISignal*>& visited)
+        {
+            std::size_t depth = 0;
+            if (!visited.insert(&sig).second)
+            {
+                return depth;
+            }
+            for (const auto* sw : multiplexer_switches(msg, sig))
+            {
+                depth = std::max(depth, multiplexer_depth(msg, *sw, visited) + 1);
+            }
+            return depth;
+        }
+        // Expression which is true if the signal is present in the frame, "" if it always is. A signal which
+        // depends on a switch which is multiplexed itself is only present if the switch is present too.
+        // value returns the expression for the raw value of a switch.
+        template <class ValueFunc>
+        std::string multiplexer_condition(const IMessage& msg, const ISignal& sig, ValueFunc&& value, std::set<const ISignal*>& visited)
+        {
+            if (sig.MultiplexerIndicator() != ISignal::EMultiplexer::MuxValue || !visited.insert(&sig).second)
+            {
+                return "";
+            }
+            std::vector<std::string> terms;
+            if (sig.SignalMultiplexerValues_Size())
+            {
+                for (const auto& smv : sig.SignalMultiplexerValues())
+                {
+                    const auto* sw = find_signal(msg, smv.SwitchName());
+                    if (!sw || smv.ValueRanges_Size() == 0)
+                    {
+                        continue;
+                    }
+                    std::string field = value(*sw);
+                    std::string ranges;
+                    for (const auto& range : smv.ValueRanges())
+                    {
+                        if (!ranges.empty())
+                        {
+                            ranges += " || ";
+                        }
+                        if (range.from == range.to)
+                        {
+                            ranges += field + " == " + integer(range.from);
+                        }
+                        else if (range.from == 0)
+                        {
+                            ranges += field + " <= " + integer(range.to);
+                        }
+                        else
+                        {
+                            ranges += "(" + field + " >= " + integer(range.from) + " && " + field + " <= " + integer(range.to) + ")";
+                        }
+                    }
+                    terms.push_back(smv.ValueRanges_Size() > 1 ? "(" + ranges + ")" : ranges);
+                    std::string outer = multiplexer_condition(msg, *sw, value, visited);
+                    if (!outer.empty())
+                    {
+                        terms.push_back(outer);
+                    }
+                }
+            }
+            else if (msg.MuxSignal())
+            {
+                terms.push_back(value(*msg.MuxSignal()) + " == " + integer(sig.MultiplexerSwitchValue()));
+            }
+            std::string result;
+            for (const auto& term : terms)
+            {
+                result += (result.empty() ? "" : " && ") + term;
+            }
+            return result;
+        }
+    }
+}
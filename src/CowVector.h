@@ -0,0 +1,84 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <boost/iterator/indirect_iterator.hpp>
+
+namespace dbcppp
+{
+    // Vector whose elements are shared between its copies, copying it only copies pointers.
+    // An element is copied when it is modified through a vector which doesn't own it alone
+    // (copy-on-write), so the copies never see each others modifications.
+    template <class T>
+    class cow_vector
+    {
+    public:
+        using const_iterator = boost::indirect_iterator<typename std::vector<std::shared_ptr<T>>::const_iterator, const T>;
+
+        cow_vector() = default;
+        cow_vector(std::vector<T>&& items)
+        {
+            _items.reserve(items.size());
+            for (auto& item : items)
+            {
+                _items.push_back(std::make_shared<T>(std::move(item)));
+            }
+        }
+
+        std::size_t size() const
+        {
+            return _items.size();
+        }
+        std::size_t capacity() const
+        {
+            return _items.capacity();
+        }
+        bool empty() const
+        {
+            return _items.empty();
+        }
+        const T& operator[](std::size_t i) const
+        {
+            return *_items[i];
+        }
+        const_iterator begin() const
+        {
+            return const_iterator(_items.begin());
+        }
+        const_iterator end() const
+        {
+            return const_iterator(_items.end());
+        }
+        // element i for modification, copied first if it is shared
+        T& mut(std::size_t i)
+        {
+            auto& item = _items[i];
+            if (item.use_count() > 1)
+            {
+                item = std::make_shared<T>(*item);
+            }
+            return *item;
+        }
+        const std::shared_ptr<T>& shared(std::size_t i) const
+        {
+            return _items[i];
+        }
+        void push_back(T&& item)
+        {
+            _items.push_back(std::make_shared<T>(std::move(item)));
+        }
+        // shares the element with the vector it was taken from
+        void push_back(std::shared_ptr<T> item)
+        {
+            _items.push_back(std::move(item));
+        }
+        void reserve(std::size_t n)
+        {
+            _items.reserve(n);
+        }
+
+    private:
+        std::vector<std::shared_ptr<T>> _items;
+    };
+}
@@ -1,9 +1,11 @@
+#include <array>
 #include <iterator>
 #include <regex>
 #include <fstream>
 #include <variant>
 #include <sstream>
 #include <unordered_map>
+#include <memory_resource>
 #include <cassert>
 
 #include <boost/variant.hpp>
@@ -11,18 +13,28 @@
 #include "dbcppp/Network.h"
 #include "dbcppp/CApi.h"
 
-#include "DBCX3.h"
+#include "DBCAST2Network.h"
+#include "Parallel.h"
 
 using namespace dbcppp;
 using namespace dbcppp::DBCX3::AST;
 
 namespace
 {
-using AttributeList = std::vector<variant_attribute_t const*>;
+// The cache only lives while the AST is converted, so all of its nodes are
+// allocated from one monotonic arena and released at once.
+using cache_allocator_t = std::pmr::polymorphic_allocator<std::byte>;
+using AttributeList = std::pmr::vector<variant_attribute_t const*>;
 using Description = boost::variant<G_ValueDescriptionSignal, G_ValueDescriptionEnvVar>;
 
 struct SignalCache
 {
+    using allocator_type = cache_allocator_t;
+
+    explicit SignalCache(const allocator_type& alloc)
+        : Attributes(alloc)
+    {}
+
     AttributeList Attributes;
     Description const* Description_ = nullptr;
     variant_comment_t const* Comment = nullptr;
@@ -30,106 +42,61 @@ struct SignalCache
 
 struct MessageCache
 {
-    std::unordered_map<std::string_view, SignalCache> Signals;
+    using allocator_type = cache_allocator_t;
+
+    explicit MessageCache(const allocator_type& alloc)
+        : Signals(alloc)
+        , Attributes(alloc)
+    {}
+
+    std::pmr::unordered_map<std::string_view, SignalCache> Signals;
     AttributeList Attributes;
     variant_comment_t const* Comment = nullptr;
 };
 
 struct EnvVarCache
 {
+    using allocator_type = cache_allocator_t;
+
+    explicit EnvVarCache(const allocator_type& alloc)
+        : Attributes(alloc)
+    {}
+
     AttributeList Attributes;
-    Description const* Description_;
+    Description const* Description_ = nullptr;
     variant_comment_t const* Comment = nullptr;
 };
 
 struct NodeCache
 {
+    using allocator_type = cache_allocator_t;
+
+    explicit NodeCache(const allocator_type& alloc)
+        : Attributes(alloc)
+    {}
+
     AttributeList Attributes;
     variant_comment_t const* Comment = nullptr;
 };
 
 struct Cache
 {
+    explicit Cache(std::pmr::memory_resource* resource)
+        : NetworkAttributes(resource)
+        , EnvVars(resource)
+        , Nodes(resource)
+        , Messages(resource)
+    {}
+
     AttributeList NetworkAttributes;
     variant_comment_t const* NetworkComment = nullptr;
-    std::unordered_map<std::string_view, EnvVarCache> EnvVars;
-    std::unordered_map<std::string_view, NodeCache> Nodes;
-    std::unordered_map<uint64_t, MessageCache> Messages;
+    std::pmr::unordered_map<std::string_view, EnvVarCache> EnvVars;
+    std::pmr::unordered_map<std::string_view, NodeCache> Nodes;
+    std::pmr::unordered_map<uint64_t, MessageCache> Messages;
 };
 
 } // anon
 
-static auto getVersion(const G_Network& gnet)
-{
-    return gnet.version.version;
-}
-static auto getNewSymbols(const G_Network& gnet)
-{
-    std::vector<std::string> nodes;
-    for (const auto& ns : gnet.new_symbols)
-    {
-        nodes.push_back(ns);
-    }
-    return nodes;
-}
-static auto getSignalType(const G_Network& gnet, const G_ValueTable& vt)
-{
-    std::optional<std::unique_ptr<ISignalType>> signal_type;
-    auto iter = std::find_if(gnet.signal_types.begin(), gnet.signal_types.end(),
-        [&](const auto& st)
-        {
-            return st.value_table_name == vt.name;
-        });
-    if (iter != gnet.signal_types.end())
-    {
-        auto& st = *iter;
-        signal_type = ISignalType::Create(
-              std::string(st.name)
-            , st.size
-            , st.byte_order == '0' ? ISignal::EByteOrder::BigEndian : ISignal::EByteOrder::LittleEndian
-            , st.value_type == '+' ? ISignal::EValueType::Unsigned : ISignal::EValueType::Signed
-            , st.factor
-            , st.offset
-            , st.minimum
-            , st.maximum
-            , std::string(st.unit)
-            , st.default_value
-            , std::string(st.value_table_name));
-    }
-    return signal_type;
-}
-static auto getValueTables(const G_Network& gnet)
-{
-    std::vector<std::unique_ptr<IValueTable>> value_tables;
-    for (const auto& vt : gnet.value_tables)
-    {
-        auto sig_type = getSignalType(gnet, vt);
-        std::vector<std::unique_ptr<IValueEncodingDescription>> copy_ved;
-        for (const auto& ved : vt.value_encoding_descriptions)
-        {
-            auto desc = ved.description;
-            auto pved = IValueEncodingDescription::Create(ved.value, std::move(desc));
-            copy_ved.push_back(std::move(pved));
-        }
-        auto nvt = IValueTable::Create(std::string(vt.name), std::move(sig_type), std::move(copy_ved));
-        value_tables.push_back(std::move(nvt));
-    }
-    return value_tables;
-}
-static auto getBitTiming(const G_Network& gnet)
-{
-    std::unique_ptr<IBitTiming> bit_timing;
-    if (gnet.bit_timing)
-    {
-        bit_timing = IBitTiming::Create(gnet.bit_timing->baudrate, gnet.bit_timing->BTR1, gnet.bit_timing->BTR2);
-    }
-    else
-    {
-        bit_timing = IBitTiming::Create(0, 0, 0);
-    }
-    return bit_timing;
-}
-
 template <class Variant>
 class Visitor
     : public boost::static_visitor<void>
@@ -183,9 +150,283 @@ inline auto boost_variant_to_std_variant(variant_attr_value_t const& attr)
     return value;
 }
 
+static auto makeValueEncodingDescriptions(const std::vector<G_ValueDescription>& vds)
+{
+    std::vector<ValueEncodingDescriptionImpl> value_descriptions;
+    value_descriptions.reserve(vds.size());
+    for (const auto& vd : vds)
+    {
+        value_descriptions.emplace_back(vd.value, std::string(vd.description));
+    }
+    return value_descriptions;
+}
+static auto makeSignalType(const G_SignalType& st)
+{
+    return SignalTypeImpl(
+          std::string(st.name)
+        , st.size
+        , st.byte_order == '0' ? ISignal::EByteOrder::BigEndian : ISignal::EByteOrder::LittleEndian
+        , st.value_type == '+' ? ISignal::EValueType::Unsigned : ISignal::EValueType::Signed
+        , st.factor
+        , st.offset
+        , st.minimum
+        , st.maximum
+        , std::string(st.unit)
+        , st.default_value
+        , std::string(st.value_table_name));
+}
+static auto makeValueTable(const G_ValueTable& vt, std::optional<SignalTypeImpl>&& signal_type)
+{
+    std::vector<ValueEncodingDescriptionImpl> copy_ved;
+    copy_ved.reserve(vt.value_encoding_descriptions.size());
+    for (const auto& ved : vt.value_encoding_descriptions)
+    {
+        copy_ved.emplace_back(ved.value, std::string(ved.description));
+    }
+    return ValueTableImpl(std::string(vt.name), std::move(signal_type), std::move(copy_ved));
+}
+static auto makeExtendedValueType(uint64_t value)
+{
+    ISignal::EExtendedValueType extended_value_type = ISignal::EExtendedValueType::Integer;
+    switch (value)
+    {
+    case 1: extended_value_type = ISignal::EExtendedValueType::Float; break;
+    case 2: extended_value_type = ISignal::EExtendedValueType::Double; break;
+    }
+    return extended_value_type;
+}
+static auto makeSignalMultiplexerValue(const G_SignalMultiplexerValue& gsmv)
+{
+    auto switch_name = gsmv.switch_name;
+    std::vector<ISignalMultiplexerValue::Range> value_ranges;
+    value_ranges.reserve(gsmv.value_ranges.size());
+    for (const auto& r : gsmv.value_ranges)
+    {
+        value_ranges.push_back({r.from, r.to});
+    }
+    return SignalMultiplexerValueImpl(std::move(switch_name), std::move(value_ranges));
+}
+static auto makeSignal(
+      const G_Signal& s
+    , uint64_t message_size
+    , std::vector<AttributeImpl>&& attribute_values
+    , std::vector<ValueEncodingDescriptionImpl>&& value_descriptions
+    , std::string&& comment
+    , ISignal::EExtendedValueType extended_value_type
+    , std::vector<SignalMultiplexerValueImpl>&& signal_multiplexer_values)
+{
+    std::vector<std::string> receivers;
+    auto multiplexer_indicator = ISignal::EMultiplexer::NoMux;
+    uint64_t multiplexer_switch_value = 0;
+    if (s.multiplexer_indicator)
+    {
+        auto m = *s.multiplexer_indicator;
+        if (m.substr(0, 1) == "M")
+        {
+            multiplexer_indicator = ISignal::EMultiplexer::MuxSwitch;
+        }
+        else
+        {
+            multiplexer_indicator = ISignal::EMultiplexer::MuxValue;
+            std::string value = m.substr(1, m.size());
+            multiplexer_switch_value = std::atoi(value.c_str());
+        }
+    }
+
+    receivers.reserve(s.receivers.size());
+
+    for (const auto& n : s.receivers)
+    {
+        receivers.emplace_back(n);
+    }
+
+    return SignalImpl(
+          message_size
+        , std::string(s.name)
+        , multiplexer_indicator
+        , multiplexer_switch_value
+        , s.start_bit
+        , s.signal_size
+        , s.byte_order == '0' ? ISignal::EByteOrder::BigEndian : ISignal::EByteOrder::LittleEndian
+        , s.value_type == '+' ? ISignal::EValueType::Unsigned : ISignal::EValueType::Signed
+        , s.factor
+        , s.offset
+        , s.minimum
+        , s.maximum
+        , std::string(s.unit)
+        , std::move(receivers)
+        , std::move(attribute_values)
+        , std::move(value_descriptions)
+        , std::move(comment)
+        , extended_value_type
+        , std::move(signal_multiplexer_values));
+}
+static auto makeSignalGroup(const G_SignalGroup& sg)
+{
+    auto name = sg.signal_group_name;
+    auto signal_names = sg.signal_names;
+    return SignalGroupImpl(
+          sg.message_id
+        , std::move(name)
+        , sg.repetitions
+        , std::move(signal_names));
+}
+static auto makeEnvironmentVariable(
+      const G_EnvironmentVariable& ev
+    , std::vector<ValueEncodingDescriptionImpl>&& value_descriptions
+    , std::vector<AttributeImpl>&& attribute_values
+    , std::string&& comment)
+{
+    IEnvironmentVariable::EVarType var_type;
+    IEnvironmentVariable::EAccessType access_type;
+    std::vector<std::string> access_nodes = ev.access_nodes;
+    switch (ev.var_type)
+    {
+    case 0: var_type = IEnvironmentVariable::EVarType::Integer; break;
+    case 1: var_type = IEnvironmentVariable::EVarType::Float; break;
+    case 2: var_type = IEnvironmentVariable::EVarType::String; break;
+    }
+    access_type = IEnvironmentVariable::EAccessType::Unrestricted;
+    if (ev.access_type == "DUMMY_NODE_VECTOR0")         access_type = IEnvironmentVariable::EAccessType::Unrestricted;
+    else if (ev.access_type == "DUMMY_NODE_VECTOR1")    access_type = IEnvironmentVariable::EAccessType::Read;
+    else if (ev.access_type == "DUMMY_NODE_VECTOR2")    access_type = IEnvironmentVariable::EAccessType::Write;
+    else if (ev.access_type == "DUMMY_NODE_VECTOR3")    access_type = IEnvironmentVariable::EAccessType::ReadWrite;
+    else if (ev.access_type == "DUMMY_NODE_VECTOR8000") access_type = IEnvironmentVariable::EAccessType::Unrestricted_;
+    else if (ev.access_type == "DUMMY_NODE_VECTOR8001") access_type = IEnvironmentVariable::EAccessType::Read_;
+    else if (ev.access_type == "DUMMY_NODE_VECTOR8002") access_type = IEnvironmentVariable::EAccessType::Write_;
+    else if (ev.access_type == "DUMMY_NODE_VECTOR8003") access_type = IEnvironmentVariable::EAccessType::ReadWrite_;
+    return EnvironmentVariableImpl(
+          std::string(ev.name)
+        , var_type
+        , ev.minimum
+        , ev.maximum
+        , std::string(ev.unit)
+        , ev.initial_value
+        , ev.id
+        , access_type
+        , std::move(access_nodes)
+        , std::move(value_descriptions)
+        , 0
+        , std::move(attribute_values)
+        , std::move(comment));
+}
+static auto makeAttributeDefinition(const G_AttributeDefinition& ad)
+{
+    struct VisitorValueType
+    {
+        IAttributeDefinition::value_type_t operator()(const G_AttributeValueTypeInt& cn)
+        {
+            IAttributeDefinition::ValueTypeInt vt;
+            vt.minimum = cn.minimum;
+            vt.maximum = cn.maximum;
+            return vt;
+        }
+        IAttributeDefinition::value_type_t operator()(const G_AttributeValueTypeHex& cn)
+        {
+            IAttributeDefinition::ValueTypeHex vt;
+            vt.minimum = cn.minimum;
+            vt.maximum = cn.maximum;
+            return vt;
+        }
+        IAttributeDefinition::value_type_t operator()(const G_AttributeValueTypeFloat& cn)
+        {
+            IAttributeDefinition::ValueTypeFloat vt;
+            vt.minimum = cn.minimum;
+            vt.maximum = cn.maximum;
+            return vt;
+        }
+        IAttributeDefinition::value_type_t operator()(const G_AttributeValueTypeString& cn)
+        {
+            return IAttributeDefinition::ValueTypeString();
+        }
+        IAttributeDefinition::value_type_t operator()(const G_AttributeValueTypeEnum& cn)
+        {
+            IAttributeDefinition::ValueTypeEnum vt;
+            for (auto& e : cn.values)
+            {
+                vt.values.emplace_back(e);
+            }
+            return vt;
+        }
+    };
+
+    IAttributeDefinition::EObjectType object_type;
+    auto cvt = ad.value_type;
+    if (!ad.object_type)
+    {
+        object_type = IAttributeDefinition::EObjectType::Network;
+    }
+    else if (*ad.object_type == "BU_")
+    {
+        object_type = IAttributeDefinition::EObjectType::Node;
+    }
+    else if (*ad.object_type == "BO_")
+    {
+        object_type = IAttributeDefinition::EObjectType::Message;
+    }
+    else if (*ad.object_type == "SG_")
+    {
+        object_type = IAttributeDefinition::EObjectType::Signal;
+    }
+    else
+    {
+        object_type = IAttributeDefinition::EObjectType::EnvironmentVariable;
+    }
+    VisitorValueType vvt;
+    auto value = boost_variant_to_std_variant(cvt.value);
+    return AttributeDefinitionImpl(std::string(ad.name), object_type, std::visit(vvt, value));
+}
+
+static auto getVersion(const G_Network& gnet)
+{
+    return gnet.version.version;
+}
+static auto getNewSymbols(const G_Network& gnet)
+{
+    std::vector<std::string> nodes;
+    nodes.reserve(gnet.new_symbols.size());
+    for (const auto& ns : gnet.new_symbols)
+    {
+        nodes.push_back(ns);
+    }
+    return nodes;
+}
+static auto getSignalType(const G_Network& gnet, const G_ValueTable& vt)
+{
+    std::optional<SignalTypeImpl> signal_type;
+    auto iter = std::find_if(gnet.signal_types.begin(), gnet.signal_types.end(),
+        [&](const auto& st)
+        {
+            return st.value_table_name == vt.name;
+        });
+    if (iter != gnet.signal_types.end())
+    {
+        signal_type.emplace(makeSignalType(*iter));
+    }
+    return signal_type;
+}
+static auto getValueTables(const G_Network& gnet)
+{
+    std::vector<ValueTableImpl> value_tables;
+    value_tables.reserve(gnet.value_tables.size());
+    for (const auto& vt : gnet.value_tables)
+    {
+        value_tables.emplace_back(makeValueTable(vt, getSignalType(gnet, vt)));
+    }
+    return value_tables;
+}
+static auto getBitTiming(const G_Network& gnet)
+{
+    if (gnet.bit_timing)
+    {
+        return BitTimingImpl(gnet.bit_timing->baudrate, gnet.bit_timing->BTR1, gnet.bit_timing->BTR2);
+    }
+    return BitTimingImpl(0, 0, 0);
+}
+
 static auto getAttributeValues(const G_Network& gnet, const G_Node& n, Cache const& cache)
 {
-    std::vector<std::unique_ptr<IAttribute>> attribute_values;
+    std::vector<AttributeImpl> attribute_values;
 
     auto node_it = cache.Nodes.find(n.name);
 
@@ -196,8 +437,7 @@ static auto getAttributeValues(const G_Network& gnet, const G_Node& n, Cache con
             auto const& attr = boost::get<G_AttributeNode>(*av);
             auto name = attr.attribute_name;
             auto value{boost_variant_to_std_variant(attr.value)};
-            auto attribute = IAttribute::Create(std::move(name), IAttributeDefinition::EObjectType::Node, std::move(value));
-            attribute_values.emplace_back(std::move(attribute));
+            attribute_values.emplace_back(std::move(name), IAttributeDefinition::EObjectType::Node, std::move(value));
         }
     }
 
@@ -218,19 +458,19 @@ static auto getComment(const G_Network& gnet, const G_Node& n, Cache const& cach
 }
 static auto getNodes(const G_Network& gnet, Cache const& cache)
 {
-    std::vector<std::unique_ptr<INode>> nodes;
+    std::vector<NodeImpl> nodes;
+    nodes.reserve(gnet.nodes.size());
     for (const auto& n : gnet.nodes)
     {
         auto comment = getComment(gnet, n, cache);
         auto attribute_values = getAttributeValues(gnet, n, cache);
-        auto nn = INode::Create(std::string(n.name), std::move(comment), std::move(attribute_values));
-        nodes.push_back(std::move(nn));
+        nodes.emplace_back(std::string(n.name), std::move(comment), std::move(attribute_values));
     }
     return nodes;
 }
 static auto getAttributeValues(const G_Network& gnet, const G_Message& m, const G_Signal& s, Cache const& cache)
 {
-    std::vector<std::unique_ptr<IAttribute>> attribute_values;
+    std::vector<AttributeImpl> attribute_values;
     auto const message_it = cache.Messages.find(m.id);
 
     if (message_it != cache.Messages.end()) {
@@ -243,8 +483,7 @@ static auto getAttributeValues(const G_Network& gnet, const G_Message& m, const
             {
                 auto const& attr = boost::get<G_AttributeSignal>(*av);
                 auto value{boost_variant_to_std_variant(attr.value)};
-                auto attribute = IAttribute::Create(std::string(attr.attribute_name), IAttributeDefinition::EObjectType::Signal, std::move(value));
-                attribute_values.emplace_back(std::move(attribute));
+                attribute_values.emplace_back(std::string(attr.attribute_name), IAttributeDefinition::EObjectType::Signal, std::move(value));
             }
         }
 
@@ -254,7 +493,7 @@ static auto getAttributeValues(const G_Network& gnet, const G_Message& m, const
 }
 static auto getValueDescriptions(const G_Network& gnet, const G_Message& m, const G_Signal& s, Cache const& cache)
 {
-    std::vector<std::unique_ptr<IValueEncodingDescription>> value_descriptions;
+    std::vector<ValueEncodingDescriptionImpl> value_descriptions;
     auto const message_it = cache.Messages.find(m.id);
 
     if (message_it != cache.Messages.end()) {
@@ -263,15 +502,7 @@ static auto getValueDescriptions(const G_Network& gnet, const G_Message& m, cons
         if (signal_it != message_it->second.Signals.end()) {
             if (signal_it->second.Description_) {
                 auto const& vds = boost::get<G_ValueDescriptionSignal>(*signal_it->second.Description_).value_descriptions;
-
-                value_descriptions.reserve(vds.size());
-
-                for (const auto& vd : vds)
-                {
-                    auto desc = vd.description;
-                    auto pvd = IValueEncodingDescription::Create(vd.value, std::move(desc));
-                    value_descriptions.push_back(std::move(pvd));
-                }
+                value_descriptions = makeValueEncodingDescriptions(vds);
             }
         }
     }
@@ -304,94 +535,38 @@ static auto getSignalExtendedValueType(const G_Network& gnet, const G_Message& m
         });
     if (iter != gnet.signal_extended_value_types.end())
     {
-        switch (iter->value)
-        {
-        case 1: extended_value_type = ISignal::EExtendedValueType::Float; break;
-        case 2: extended_value_type = ISignal::EExtendedValueType::Double; break;
-        }
+        extended_value_type = makeExtendedValueType(iter->value);
     }
     return extended_value_type;
 }
 static auto getSignalMultiplexerValues(const G_Network& gnet, const std::string& s, const uint64_t m)
 {
-    std::vector<std::unique_ptr<ISignalMultiplexerValue>> signal_multiplexer_values;
+    std::vector<SignalMultiplexerValueImpl> signal_multiplexer_values;
     for (const auto& gsmv : gnet.signal_multiplexer_values)
     {
         if (gsmv.signal_name == s && gsmv.message_id == m)
         {
-            auto switch_name = gsmv.switch_name;
-            std::vector<ISignalMultiplexerValue::Range> value_ranges;
-            for (const auto& r : gsmv.value_ranges)
-            {
-                value_ranges.push_back({r.from, r.to});
-            }
-            auto signal_multiplexer_value = ISignalMultiplexerValue::Create(
-                  std::move(switch_name)
-                , std::move(value_ranges));
-            signal_multiplexer_values.push_back(std::move(signal_multiplexer_value));
+            signal_multiplexer_values.emplace_back(makeSignalMultiplexerValue(gsmv));
         }
     }
     return signal_multiplexer_values;
 }
 static auto getSignals(const G_Network& gnet, const G_Message& m, Cache const& cache)
 {
-    std::vector<std::unique_ptr<ISignal>> signals;
+    std::vector<SignalImpl> signals;
 
     signals.reserve(m.signals.size());
 
     for (const G_Signal& s : m.signals)
     {
-        std::vector<std::string> receivers;
-        auto attribute_values = getAttributeValues(gnet, m, s, cache);
-        auto value_descriptions = getValueDescriptions(gnet, m, s, cache);
-        auto extended_value_type = getSignalExtendedValueType(gnet, m, s);
-        auto multiplexer_indicator = ISignal::EMultiplexer::NoMux;
-        auto comment = getComment(gnet, m, s, cache);
-        auto signal_multiplexer_values = getSignalMultiplexerValues(gnet, s.name, m.id);
-        uint64_t multiplexer_switch_value = 0;
-        if (s.multiplexer_indicator)
-        {
-            auto m = *s.multiplexer_indicator;
-            if (m.substr(0, 1) == "M")
-            {
-                multiplexer_indicator = ISignal::EMultiplexer::MuxSwitch;
-            }
-            else
-            {
-                multiplexer_indicator = ISignal::EMultiplexer::MuxValue;
-                std::string value = m.substr(1, m.size());
-                multiplexer_switch_value = std::atoi(value.c_str());
-            }
-        }
-
-        receivers.reserve(s.receivers.size());
-
-        for (const auto& n : s.receivers)
-        {
-            receivers.emplace_back(n);
-        }
-
-        auto ns = ISignal::Create(
-              m.size
-            , std::string(s.name)
-            , multiplexer_indicator
-            , multiplexer_switch_value
-            , s.start_bit
-            , s.signal_size
-            , s.byte_order == '0' ? ISignal::EByteOrder::BigEndian : ISignal::EByteOrder::LittleEndian
-            , s.value_type == '+' ? ISignal::EValueType::Unsigned : ISignal::EValueType::Signed
-            , s.factor
-            , s.offset
-            , s.minimum
-            , s.maximum
-            , std::string(s.unit)
-            , std::move(receivers)
-            , std::move(attribute_values)
-            , std::move(value_descriptions)
-            , std::move(comment)
-            , extended_value_type
-            , std::move(signal_multiplexer_values));
-        signals.emplace_back(std::move(ns));
+        signals.emplace_back(makeSignal(
+              s
+            , m.size
+            , getAttributeValues(gnet, m, s, cache)
+            , getValueDescriptions(gnet, m, s, cache)
+            , getComment(gnet, m, s, cache)
+            , getSignalExtendedValueType(gnet, m, s)
+            , getSignalMultiplexerValues(gnet, s.name, m.id)));
     }
     return signals;
 }
@@ -414,7 +589,7 @@ static auto getMessageTransmitters(const G_Network& gnet, const G_Message& m)
 }
 static auto getAttributeValues(const G_Network& gnet, const G_Message& m, Cache const& cache)
 {
-    std::vector<std::unique_ptr<IAttribute>> attribute_values;
+    std::vector<AttributeImpl> attribute_values;
 
     auto message_it = cache.Messages.find(m.id);
 
@@ -424,8 +599,7 @@ static auto getAttributeValues(const G_Network& gnet, const G_Message& m, Cache
         for (auto av: message_it->second.Attributes) {
             auto const& attr = boost::get<G_AttributeMessage>(*av);
             auto value{boost_variant_to_std_variant(attr.value)};
-            auto attribute = IAttribute::Create(std::string(attr.attribute_name), IAttributeDefinition::EObjectType::Message, std::move(value));
-            attribute_values.emplace_back(std::move(attribute));
+            attribute_values.emplace_back(std::string(attr.attribute_name), IAttributeDefinition::EObjectType::Message, std::move(value));
         }
     }
     return attribute_values;
@@ -444,37 +618,31 @@ static auto getComment(const G_Network& gnet, const G_Message& m, Cache const& c
 }
 static auto getSignalGroups(const G_Network& gnet, const G_Message& m)
 {
-    std::vector<std::unique_ptr<ISignalGroup>> signal_groups;
+    std::vector<SignalGroupImpl> signal_groups;
     for (const auto& sg : gnet.signal_groups)
     {
         if (sg.message_id == m.id)
         {
-            auto name = sg.signal_group_name;
-            auto signal_names = sg.signal_names;
-            auto signal_group = ISignalGroup::Create(
-                  sg.message_id
-                , std::move(name)
-                , sg.repetitions
-                , std::move(signal_names));
-            signal_groups.push_back(std::move(signal_group));
+            signal_groups.emplace_back(makeSignalGroup(sg));
         }
     }
     return signal_groups;
 }
-static auto getMessages(const G_Network& gnet, Cache const& cache)
+static auto getMessages(const G_Network& gnet, std::size_t begin, std::size_t end, Cache const& cache)
 {
-    std::vector<std::unique_ptr<IMessage>> messages;
+    std::vector<MessageImpl> messages;
 
-    messages.reserve(cache.Messages.size());
+    messages.reserve(end - begin);
 
-    for (const auto& m : gnet.messages)
+    for (std::size_t i = begin; i < end; i++)
     {
+        const auto& m = gnet.messages[i];
         auto message_transmitters = getMessageTransmitters(gnet, m);
         auto signals = getSignals(gnet, m, cache);
         auto attribute_values = getAttributeValues(gnet, m, cache);
         auto comment = getComment(gnet, m, cache);
         auto signal_groups = getSignalGroups(gnet, m);
-        auto msg = IMessage::Create(
+        messages.emplace_back(
               m.id
             , std::string(m.name)
             , m.size
@@ -484,34 +652,54 @@ static auto getMessages(const G_Network& gnet, Cache const& cache)
             , std::move(attribute_values)
             , std::move(comment)
             , std::move(signal_groups));
-        messages.emplace_back(std::move(msg));
+    }
+    return messages;
+}
+// fewer messages per partition aren't worth handing them to another thread
+static constexpr std::size_t min_messages_per_partition = 64;
+static auto getMessages(const G_Network& gnet, Cache const& cache, std::size_t threads)
+{
+    threads = resolve_thread_count(threads);
+    std::size_t n_partitions = std::min(threads * 4, gnet.messages.size() / min_messages_per_partition);
+    if (threads == 1 || n_partitions <= 1)
+    {
+        return getMessages(gnet, 0, gnet.messages.size(), cache);
+    }
+    // every message only reads the AST and the cache, so contiguous ranges of them can be
+    // converted independently and concatenated afterwards to keep the original order
+    std::vector<std::vector<MessageImpl>> partitions(n_partitions);
+    parallel_for(n_partitions, threads,
+        [&](std::size_t i)
+        {
+            partitions[i] = getMessages(gnet
+                , gnet.messages.size() * i / n_partitions
+                , gnet.messages.size() * (i + 1) / n_partitions
+                , cache);
+        });
+    std::vector<MessageImpl> messages;
+    messages.reserve(gnet.messages.size());
+    for (auto& partition : partitions)
+    {
+        std::move(partition.begin(), partition.end(), std::back_inserter(messages));
     }
     return messages;
 }
 static auto getValueDescriptions(const G_Network& gnet, const G_EnvironmentVariable& ev, Cache const& cache)
 {
-    std::vector<std::unique_ptr<IValueEncodingDescription>> value_descriptions;
+    std::vector<ValueEncodingDescriptionImpl> value_descriptions;
     auto env_it = cache.EnvVars.find(ev.name);
 
     if (env_it != cache.EnvVars.end()) {
         if (env_it->second.Description_) {
             auto const& vds = boost::get<G_ValueDescriptionEnvVar>(*env_it->second.Description_).value_descriptions;
-
-            value_descriptions.reserve(vds.size());
-
-            for (const auto& vd : vds)
-            {
-                auto desc = vd.description;
-                auto pvd = IValueEncodingDescription::Create(vd.value, std::move(desc));
-                value_descriptions.push_back(std::move(pvd));
-            }
+            value_descriptions = makeValueEncodingDescriptions(vds);
         }
     }
     return value_descriptions;
 }
 static auto getAttributeValues(const G_Network& gnet, const G_EnvironmentVariable& ev, const Cache& cache)
 {
-    std::vector<std::unique_ptr<IAttribute>> attribute_values;
+    std::vector<AttributeImpl> attribute_values;
 
     auto env_it = cache.EnvVars.find(ev.name);
 
@@ -521,8 +709,7 @@ static auto getAttributeValues(const G_Network& gnet, const G_EnvironmentVariabl
         for (auto av : env_it->second.Attributes) {
             auto const& attr = boost::get<G_AttributeEnvVar>(*av);
             auto value = boost_variant_to_std_variant(attr.value);
-            auto attribute = IAttribute::Create(std::string(attr.attribute_name), IAttributeDefinition::EObjectType::EnvironmentVariable, std::move(value));
-            attribute_values.push_back(std::move(attribute));
+            attribute_values.emplace_back(std::string(attr.attribute_name), IAttributeDefinition::EObjectType::EnvironmentVariable, std::move(value));
         }
     }
 
@@ -542,145 +729,51 @@ static auto getComment(const G_Network& gnet, const G_EnvironmentVariable& ev, C
 }
 static auto getEnvironmentVariables(const G_Network& gnet, Cache const& cache)
 {
-    std::vector<std::unique_ptr<IEnvironmentVariable>> environment_variables;
+    std::vector<EnvironmentVariableImpl> environment_variables;
+    environment_variables.reserve(gnet.environment_variables.size());
     for (const auto& ev : gnet.environment_variables)
     {
-        IEnvironmentVariable::EVarType var_type;
-        IEnvironmentVariable::EAccessType access_type;
-        std::vector<std::string> access_nodes = ev.access_nodes;
-        auto value_descriptions = getValueDescriptions(gnet, ev, cache);
-        auto attribute_values = getAttributeValues(gnet, ev, cache);
-        auto comment = getComment(gnet, ev, cache);
-        uint64_t data_size = 0;
-        switch (ev.var_type)
-        {
-        case 0: var_type = IEnvironmentVariable::EVarType::Integer; break;
-        case 1: var_type = IEnvironmentVariable::EVarType::Float; break;
-        case 2: var_type = IEnvironmentVariable::EVarType::String; break;
-        }
-        access_type = IEnvironmentVariable::EAccessType::Unrestricted;
-        if (ev.access_type == "DUMMY_NODE_VECTOR0")         access_type = IEnvironmentVariable::EAccessType::Unrestricted;
-        else if (ev.access_type == "DUMMY_NODE_VECTOR1")    access_type = IEnvironmentVariable::EAccessType::Read;
-        else if (ev.access_type == "DUMMY_NODE_VECTOR2")    access_type = IEnvironmentVariable::EAccessType::Write;
-        else if (ev.access_type == "DUMMY_NODE_VECTOR3")    access_type = IEnvironmentVariable::EAccessType::ReadWrite;
-        else if (ev.access_type == "DUMMY_NODE_VECTOR8000") access_type = IEnvironmentVariable::EAccessType::Unrestricted_;
-        else if (ev.access_type == "DUMMY_NODE_VECTOR8001") access_type = IEnvironmentVariable::EAccessType::Read_;
-        else if (ev.access_type == "DUMMY_NODE_VECTOR8002") access_type = IEnvironmentVariable::EAccessType::Write_;
-        else if (ev.access_type == "DUMMY_NODE_VECTOR8003") access_type = IEnvironmentVariable::EAccessType::ReadWrite_;
+        auto& env_var = environment_variables.emplace_back(makeEnvironmentVariable(
+              ev
+            , getValueDescriptions(gnet, ev, cache)
+            , getAttributeValues(gnet, ev, cache)
+            , getComment(gnet, ev, cache)));
         for (auto& evd : gnet.environment_variable_datas)
         {
             if (evd.name == ev.name)
             {
-                var_type = IEnvironmentVariable::EVarType::Data;
-                data_size = evd.size;
+                env_var.varType() = IEnvironmentVariable::EVarType::Data;
+                env_var.dataSize() = evd.size;
                 break;
             }
         }
-        auto env_var = IEnvironmentVariable::Create(
-              std::string(ev.name)
-            , var_type
-            , ev.minimum
-            , ev.maximum
-            , std::string(ev.unit)
-            , ev.initial_value
-            , ev.id
-            , access_type
-            , std::move(access_nodes)
-            , std::move(value_descriptions)
-            , data_size
-            , std::move(attribute_values)
-            , std::move(comment));
-        environment_variables.push_back(std::move(env_var));
     }
     return environment_variables;
 }
 static auto getAttributeDefinitions(const G_Network& gnet)
 {
-    std::vector<std::unique_ptr<IAttributeDefinition>> attribute_definitions;
-    struct VisitorValueType
+    std::vector<AttributeDefinitionImpl> attribute_definitions;
+    attribute_definitions.reserve(gnet.attribute_definitions.size());
+    for (const auto& ad : gnet.attribute_definitions)
     {
-        IAttributeDefinition::value_type_t operator()(const G_AttributeValueTypeInt& cn)
-        {
-            IAttributeDefinition::ValueTypeInt vt;
-            vt.minimum = cn.minimum;
-            vt.maximum = cn.maximum;
-            return vt;
-        }
-        IAttributeDefinition::value_type_t operator()(const G_AttributeValueTypeHex& cn)
-        {
-            IAttributeDefinition::ValueTypeHex vt;
-            vt.minimum = cn.minimum;
-            vt.maximum = cn.maximum;
-            return vt;
-        }
-        IAttributeDefinition::value_type_t operator()(const G_AttributeValueTypeFloat& cn)
-        {
-            IAttributeDefinition::ValueTypeFloat vt;
-            vt.minimum = cn.minimum;
-            vt.maximum = cn.maximum;
-            return vt;
-        }
-        IAttributeDefinition::value_type_t operator()(const G_AttributeValueTypeString& cn)
-        {
-            return IAttributeDefinition::ValueTypeString();
-        }
-        IAttributeDefinition::value_type_t operator()(const G_AttributeValueTypeEnum& cn)
-        {
-            IAttributeDefinition::ValueTypeEnum vt;
-            for (auto& e : cn.values)
-            {
-                vt.values.emplace_back(e);
-            }
-            return vt;
-        }
-    };
-
-    for (const auto& ad : gnet.attribute_definitions)
-    {
-        IAttributeDefinition::EObjectType object_type;
-        auto cvt = ad.value_type;
-        if (!ad.object_type)
-        {
-            object_type = IAttributeDefinition::EObjectType::Network;
-        }
-        else if (*ad.object_type == "BU_")
-        {
-            object_type = IAttributeDefinition::EObjectType::Node;
-        }
-        else if (*ad.object_type == "BO_")
-        {
-            object_type = IAttributeDefinition::EObjectType::Message;
-        }
-        else if (*ad.object_type == "SG_")
-        {
-            object_type = IAttributeDefinition::EObjectType::Signal;
-        }
-        else
-        {
-            object_type = IAttributeDefinition::EObjectType::EnvironmentVariable;
-        }
-        VisitorValueType vvt;
-        auto value = boost_variant_to_std_variant(cvt.value);
-        std::visit(vvt, value);
-        auto nad = IAttributeDefinition::Create(std::move(std::string(ad.name)), object_type, std::visit(vvt, value));
-        attribute_definitions.push_back(std::move(nad));
+        attribute_definitions.emplace_back(makeAttributeDefinition(ad));
     }
     return attribute_definitions;
 }
 static auto getAttributeDefaults(const G_Network& gnet)
 {
-    std::vector<std::unique_ptr<IAttribute>> attribute_defaults;
+    std::vector<AttributeImpl> attribute_defaults;
+    attribute_defaults.reserve(gnet.attribute_defaults.size());
     for (auto& ad : gnet.attribute_defaults)
     {
         auto value = boost_variant_to_std_variant(ad.value);
-        auto nad = IAttribute::Create(std::string(ad.name), IAttributeDefinition::EObjectType::Network, value);
-        attribute_defaults.push_back(std::move(nad));
+        attribute_defaults.emplace_back(std::string(ad.name), IAttributeDefinition::EObjectType::Network, std::move(value));
     }
     return attribute_defaults;
 }
 static auto getAttributeValues(const G_Network& gnet, Cache const& cache)
 {
-    std::vector<std::unique_ptr<IAttribute>> attribute_values;
+    std::vector<AttributeImpl> attribute_values;
 
     attribute_values.reserve(cache.NetworkAttributes.size());
 
@@ -688,11 +781,10 @@ static auto getAttributeValues(const G_Network& gnet, Cache const& cache)
     {
         auto const& attr = boost::get<G_AttributeNetwork>(*av);
         auto value{boost_variant_to_std_variant(attr.value)};
-        auto attribute = IAttribute::Create(
-            std::string(attr.attribute_name)
+        attribute_values.emplace_back(
+              std::string(attr.attribute_name)
             , IAttributeDefinition::EObjectType::Network
             , std::move(value));
-        attribute_values.emplace_back(std::move(attribute));
     }
     return attribute_values;
 }
@@ -704,57 +796,30 @@ static auto getComment(const G_Network& gnet, Cache const& cache)
     }
     return comment;
 }
-
-std::unique_ptr<INetwork> DBCAST2Network(const G_Network& gnet)
+static void buildCache(const G_Network& gnet, Cache& cache)
 {
-    Cache cache;
-
     for (const auto& av : gnet.attribute_values)
     {
         switch (av.which()) {
         case 0: {
-            auto const& attr = boost::get<G_AttributeNetwork>(av);
             cache.NetworkAttributes.emplace_back(&av);
         } break;
         case 1: {
             auto const& attr = boost::get<G_AttributeNode>(av);
-            auto node_it = cache.Nodes.find(attr.node_name);
-            if (node_it == cache.Nodes.end()) {
-                node_it = cache.Nodes.emplace(attr.node_name, NodeCache()).first;
-            }
-            node_it->second.Attributes.emplace_back(&av);
+            cache.Nodes[attr.node_name].Attributes.emplace_back(&av);
         } break;
         case 2: {
             auto const& attr = boost::get<G_AttributeMessage>(av);
-            auto it = cache.Messages.find(attr.message_id);
-            if (it == cache.Messages.end()) {
-                it = cache.Messages.emplace(attr.message_id, MessageCache()).first;
-            }
-
-            it->second.Attributes.emplace_back(&av);
+            cache.Messages[attr.message_id].Attributes.emplace_back(&av);
         } break;
         case 3: {
             auto const& attr = boost::get<G_AttributeSignal>(av);
-            auto message_it = cache.Messages.find(attr.message_id);
-            if (message_it == cache.Messages.end()) {
-                message_it = cache.Messages.emplace(attr.message_id, MessageCache()).first;
-            }
-
-            auto& signals = message_it->second.Signals;
-            auto signal_it = signals.find(attr.signal_name);
-            if (signal_it == signals.end()) {
-                signal_it = signals.emplace(attr.signal_name, SignalCache()).first;
-            }
-
-            signal_it->second.Attributes.emplace_back(&av);
+            auto& signals = cache.Messages[attr.message_id].Signals;
+            signals[attr.signal_name].Attributes.emplace_back(&av);
         } break;
         case 4: {
             auto const& attr = boost::get<G_AttributeEnvVar>(av);
-            auto envvar_it = cache.EnvVars.find(attr.env_var_name);
-            if (envvar_it == cache.EnvVars.end()) {
-                envvar_it = cache.EnvVars.emplace(attr.env_var_name, EnvVarCache()).first;
-            }
-            envvar_it->second.Attributes.emplace_back(&av);
+            cache.EnvVars[attr.env_var_name].Attributes.emplace_back(&av);
         } break;
         default:
             assert(false && "Unhandled variant member");
@@ -767,26 +832,12 @@ std::unique_ptr<INetwork> DBCAST2Network(const G_Network& gnet)
         switch (vd.description.which()) {
         case 0: {
             auto const& desc = boost::get<G_ValueDescriptionSignal>(vd.description);
-            auto message_it = cache.Messages.find(desc.message_id);
-            if (message_it == cache.Messages.end()) {
-                message_it = cache.Messages.emplace(desc.message_id, MessageCache()).first;
-            }
-
-            auto& signals = message_it->second.Signals;
-            auto signal_it = signals.find(desc.signal_name);
-            if (signal_it == signals.end()) {
-                signal_it = signals.emplace(desc.signal_name, SignalCache()).first;
-            }
-
-            signal_it->second.Description_ = &vd.description;
+            auto& signals = cache.Messages[desc.message_id].Signals;
+            signals[desc.signal_name].Description_ = &vd.description;
         } break;
         case 1: {
             auto const& desc = boost::get<G_ValueDescriptionEnvVar>(vd.description);
-            auto envvar_it = cache.EnvVars.find(desc.env_var_name);
-            if (envvar_it == cache.EnvVars.end()) {
-                envvar_it = cache.EnvVars.emplace(desc.env_var_name, EnvVarCache()).first;
-            }
-            envvar_it->second.Description_ = &vd.description;
+            cache.EnvVars[desc.env_var_name].Description_ = &vd.description;
         } break;
         default:
             assert(false && "Unhandled variant member");
@@ -798,75 +849,626 @@ std::unique_ptr<INetwork> DBCAST2Network(const G_Network& gnet)
     {
         switch (comment.comment.which()) {
         case 0: {
-            auto const& c = boost::get<G_CommentNetwork>(comment.comment);
             cache.NetworkComment = &comment.comment;
         } break;
         case 1: {
             auto const& c = boost::get<G_CommentNode>(comment.comment);
-            auto node_it = cache.Nodes.find(c.node_name);
-            if (node_it == cache.Nodes.end()) {
-                node_it = cache.Nodes.emplace(c.node_name, NodeCache()).first;
-            }
-            node_it->second.Comment = &comment.comment;
+            cache.Nodes[c.node_name].Comment = &comment.comment;
         } break;
         case 2: {
             auto const& c = boost::get<G_CommentMessage>(comment.comment);
-            auto message_it = cache.Messages.find(c.message_id);
-            if (message_it == cache.Messages.end()) {
-                message_it = cache.Messages.emplace(c.message_id, MessageCache()).first;
-            }
-            message_it->second.Comment = &comment.comment;
+            cache.Messages[c.message_id].Comment = &comment.comment;
         } break;
         case 3: {
             auto const& c = boost::get<G_CommentSignal>(comment.comment);
-            auto message_it = cache.Messages.find(c.message_id);
-            if (message_it == cache.Messages.end()) {
-                message_it = cache.Messages.emplace(c.message_id, MessageCache()).first;
-            }
-
-            auto signal_it = message_it->second.Signals.find(c.signal_name);
-            if (signal_it == message_it->second.Signals.end()) {
-                signal_it = message_it->second.Signals.emplace(c.signal_name, SignalCache()).first;
-            }
-            signal_it->second.Comment = &comment.comment;
+            auto& signals = cache.Messages[c.message_id].Signals;
+            signals[c.signal_name].Comment = &comment.comment;
         } break;
         case 4: {
             auto const& c = boost::get<G_CommentEnvVar>(comment.comment);
-            auto envvar_it = cache.EnvVars.find(c.env_var_name);
-            if (envvar_it == cache.EnvVars.end()) {
-                envvar_it = cache.EnvVars.emplace(c.env_var_name, EnvVarCache()).first;
-            }
-            envvar_it->second.Comment = &comment.comment;
+            cache.EnvVars[c.env_var_name].Comment = &comment.comment;
         } break;
         default:
             assert(false && "Unhandled variant member");
             break;
         }
     }
+}
 
-    return INetwork::Create(
+std::unique_ptr<INetwork> dbcppp::DBCAST2Network(const G_Network& gnet, std::size_t threads, LoadStatsRecorder* recorder)
+{
+    LoadStatsRecorder no_stats(nullptr);
+    if (!recorder)
+    {
+        recorder = &no_stats;
+    }
+    // rough upper bound of the cache size, so that the arena usually gets away with one block
+    std::size_t n_cache_entries =
+          gnet.attribute_values.size()
+        + gnet.value_descriptions_sig_env_var.size()
+        + gnet.comments.size();
+    std::pmr::monotonic_buffer_resource resource(std::max<std::size_t>(n_cache_entries * 128, 1024));
+    Cache cache(&resource);
+
+    buildCache(gnet, cache);
+    recorder->Phase("build cache");
+
+    // the objects are constructed in place into the vectors which are moved into the NetworkImpl,
+    // this avoids a heap allocated temporary for every single object of the network
+    auto nodes = getNodes(gnet, cache);
+    auto value_tables = getValueTables(gnet);
+    auto messages = getMessages(gnet, cache, threads);
+    auto environment_variables = getEnvironmentVariables(gnet, cache);
+    auto attribute_definitions = getAttributeDefinitions(gnet);
+    auto attribute_defaults = getAttributeDefaults(gnet);
+    auto attribute_values = getAttributeValues(gnet, cache);
+    recorder->Phase("create objects");
+
+    auto network = std::make_unique<NetworkImpl>(
           getVersion(gnet)
         , getNewSymbols(gnet)
         , getBitTiming(gnet)
-        , getNodes(gnet, cache)
-        , getValueTables(gnet)
-        , getMessages(gnet, cache)
-        , getEnvironmentVariables(gnet, cache)
-        , getAttributeDefinitions(gnet)
-        , getAttributeDefaults(gnet)
-        , getAttributeValues(gnet, cache)
+        , std::move(nodes)
+        , std::move(value_tables)
+        , std::move(messages)
+        , std::move(environment_variables)
+        , std::move(attribute_definitions)
+        , std::move(attribute_defaults)
+        , std::move(attribute_values)
         , getComment(gnet, cache));
+    recorder->Phase("build network");
+    return network;
 }
 
-std::unique_ptr<INetwork> INetwork::LoadDBCFromIs(std::istream& is)
+namespace
 {
-    std::string str((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
-    std::unique_ptr<dbcppp::INetwork> network;
-    std::string error_message;
-    if (auto gnet = dbcppp::DBCX3::ParseFromMemory(str.c_str(), str.c_str() + str.size(), error_message))
+// the statements in the order of LoadStats::ast_nodes
+enum EAstNode
+{
+    AstNodes,
+    AstValueTables,
+    AstMessages,
+    AstSignals,
+    AstMessageTransmitters,
+    AstEnvironmentVariables,
+    AstEnvironmentVariableDatas,
+    AstSignalTypes,
+    AstComments,
+    AstAttributeDefinitions,
+    AstAttributeDefaults,
+    AstAttributeValues,
+    AstValueDescriptions,
+    AstSignalGroups,
+    AstSignalExtendedValueTypes,
+    AstSignalMultiplexerValues,
+    AstNodeCount
+};
+const char* ast_node_names[AstNodeCount] =
+{
+    "nodes",
+    "value tables",
+    "messages",
+    "signals",
+    "message transmitters",
+    "environment variables",
+    "environment variable data",
+    "signal types",
+    "comments",
+    "attribute definitions",
+    "attribute defaults",
+    "attribute values",
+    "value descriptions",
+    "signal groups",
+    "signal extended value types",
+    "signal multiplexer values"
+};
+using AstNodeCounts = std::array<uint64_t, AstNodeCount>;
+
+AstNodeCounts countAstNodes(const G_Network& gnet)
+{
+    AstNodeCounts counts{};
+    counts[AstNodes] = gnet.nodes.size();
+    counts[AstValueTables] = gnet.value_tables.size();
+    counts[AstMessages] = gnet.messages.size();
+    for (const auto& msg : gnet.messages)
+    {
+        counts[AstSignals] += msg.signals.size();
+    }
+    counts[AstMessageTransmitters] = gnet.message_transmitters.size();
+    counts[AstEnvironmentVariables] = gnet.environment_variables.size();
+    counts[AstEnvironmentVariableDatas] = gnet.environment_variable_datas.size();
+    counts[AstSignalTypes] = gnet.signal_types.size();
+    counts[AstComments] = gnet.comments.size();
+    counts[AstAttributeDefinitions] = gnet.attribute_definitions.size();
+    counts[AstAttributeDefaults] = gnet.attribute_defaults.size();
+    counts[AstAttributeValues] = gnet.attribute_values.size();
+    counts[AstValueDescriptions] = gnet.value_descriptions_sig_env_var.size();
+    counts[AstSignalGroups] = gnet.signal_groups.size();
+    counts[AstSignalExtendedValueTypes] = gnet.signal_extended_value_types.size();
+    counts[AstSignalMultiplexerValues] = gnet.signal_multiplexer_values.size();
+    return counts;
+}
+void recordAstNodes(LoadStatsRecorder& recorder, const AstNodeCounts& counts)
+{
+    for (std::size_t i = 0; i < AstNodeCount; i++)
+    {
+        recorder.AstNode(ast_node_names[i], counts[i]);
+    }
+}
+
+// Counts the statements passed to the builder and measures the time spent in the builder,
+// which the streaming parser interleaves with the parsing.
+class MeasuringHandler final
+    : public DBCX3::ParserHandler
+{
+public:
+    MeasuringHandler(NetworkBuilder& builder)
+        : _builder(builder)
+    {
+        _create.name = "create objects";
+    }
+
+    virtual bool Wants(EStatement statement) const override
+    {
+        return _builder.Wants(statement);
+    }
+    virtual void OnVersion(std::string&& version) override
+    {
+        Forward([&] { _builder.OnVersion(std::move(version)); });
+    }
+    virtual void OnNewSymbols(std::vector<std::string>&& new_symbols) override
+    {
+        Forward([&] { _builder.OnNewSymbols(std::move(new_symbols)); });
+    }
+    virtual void OnBitTiming(G_BitTiming&& bit_timing) override
+    {
+        Forward([&] { _builder.OnBitTiming(std::move(bit_timing)); });
+    }
+    virtual void OnNode(G_Node&& node) override
+    {
+        Forward(AstNodes, [&] { _builder.OnNode(std::move(node)); });
+    }
+    virtual void OnValueTable(G_ValueTable&& value_table) override
+    {
+        Forward(AstValueTables, [&] { _builder.OnValueTable(std::move(value_table)); });
+    }
+    virtual void OnMessage(G_Message&& message) override
+    {
+        Forward(AstMessages, [&] { _builder.OnMessage(std::move(message)); });
+    }
+    virtual void OnSignal(G_Signal&& signal) override
+    {
+        Forward(AstSignals, [&] { _builder.OnSignal(std::move(signal)); });
+    }
+    virtual void OnMessageEnd() override
+    {
+        Forward([&] { _builder.OnMessageEnd(); });
+    }
+    virtual void OnMessageTransmitter(G_MessageTransmitter&& message_transmitter) override
+    {
+        Forward(AstMessageTransmitters, [&] { _builder.OnMessageTransmitter(std::move(message_transmitter)); });
+    }
+    virtual void OnEnvironmentVariable(G_EnvironmentVariable&& environment_variable) override
+    {
+        Forward(AstEnvironmentVariables, [&] { _builder.OnEnvironmentVariable(std::move(environment_variable)); });
+    }
+    virtual void OnEnvironmentVariableData(G_EnvironmentVariableData&& environment_variable_data) override
+    {
+        Forward(AstEnvironmentVariableDatas, [&] { _builder.OnEnvironmentVariableData(std::move(environment_variable_data)); });
+    }
+    virtual void OnSignalType(G_SignalType&& signal_type) override
+    {
+        Forward(AstSignalTypes, [&] { _builder.OnSignalType(std::move(signal_type)); });
+    }
+    virtual void OnComment(G_Comment&& comment) override
+    {
+        Forward(AstComments, [&] { _builder.OnComment(std::move(comment)); });
+    }
+    virtual void OnAttributeDefinition(G_AttributeDefinition&& attribute_definition) override
+    {
+        Forward(AstAttributeDefinitions, [&] { _builder.OnAttributeDefinition(std::move(attribute_definition)); });
+    }
+    virtual void OnAttributeDefault(G_Attribute&& attribute_default) override
+    {
+        Forward(AstAttributeDefaults, [&] { _builder.OnAttributeDefault(std::move(attribute_default)); });
+    }
+    virtual void OnAttributeValue(variant_attribute_t&& attribute_value) override
+    {
+        Forward(AstAttributeValues, [&] { _builder.OnAttributeValue(std::move(attribute_value)); });
+    }
+    virtual void OnValueDescription(G_ValueDescriptionSigEnvVar&& value_description) override
+    {
+        Forward(AstValueDescriptions, [&] { _builder.OnValueDescription(std::move(value_description)); });
+    }
+    virtual void OnSignalGroup(G_SignalGroup&& signal_group) override
+    {
+        Forward(AstSignalGroups, [&] { _builder.OnSignalGroup(std::move(signal_group)); });
+    }
+    virtual void OnSignalExtendedValueType(G_SignalExtendedValueType&& signal_extended_value_type) override
+    {
+        Forward(AstSignalExtendedValueTypes, [&] { _builder.OnSignalExtendedValueType(std::move(signal_extended_value_type)); });
+    }
+    virtual void OnSignalMultiplexerValue(G_SignalMultiplexerValue&& signal_multiplexer_value) override
+    {
+        Forward(AstSignalMultiplexerValues, [&] { _builder.OnSignalMultiplexerValue(std::move(signal_multiplexer_value)); });
+    }
+
+    const AstNodeCounts& Counts() const
+    {
+        return _counts;
+    }
+    LoadStats::Phase& Create()
+    {
+        return _create;
+    }
+
+private:
+    template <class Func>
+    void Forward(Func&& func)
     {
-        network = DBCAST2Network(*gnet);
+        LoadStatsRecorder::Measure(_create, std::forward<Func>(func));
     }
+    template <class Func>
+    void Forward(EAstNode node, Func&& func)
+    {
+        _counts[node]++;
+        Forward(std::forward<Func>(func));
+    }
+
+    NetworkBuilder& _builder;
+    AstNodeCounts _counts{};
+    LoadStats::Phase _create;
+};
+} // anon
+
+template <class Func>
+void NetworkBuilder::ForEachMessage(uint64_t message_id, Func&& func)
+{
+    auto range = _message_indices.equal_range(message_id);
+    for (auto iter = range.first; iter != range.second; iter++)
+    {
+        func(_messages[iter->second]);
+    }
+}
+template <class Func>
+void NetworkBuilder::ForEachSignal(uint64_t message_id, const std::string& signal_name, Func&& func)
+{
+    ForEachMessage(message_id,
+        [&](MessageImpl& msg)
+        {
+            for (auto& sig : msg.signals())
+            {
+                if (sig.Name() == signal_name)
+                {
+                    func(msg, sig);
+                }
+            }
+        });
+}
+template <class Func>
+void NetworkBuilder::ForEachNode(const std::string& node_name, Func&& func)
+{
+    auto range = _node_indices.equal_range(node_name);
+    for (auto iter = range.first; iter != range.second; iter++)
+    {
+        func(_nodes[iter->second]);
+    }
+}
+template <class Func>
+void NetworkBuilder::ForEachValueTable(const std::string& value_table_name, Func&& func)
+{
+    auto range = _value_table_indices.equal_range(value_table_name);
+    for (auto iter = range.first; iter != range.second; iter++)
+    {
+        func(_value_tables[iter->second]);
+    }
+}
+template <class Func>
+void NetworkBuilder::ForEachEnvironmentVariable(const std::string& env_var_name, Func&& func)
+{
+    auto range = _environment_variable_indices.equal_range(env_var_name);
+    for (auto iter = range.first; iter != range.second; iter++)
+    {
+        func(_environment_variables[iter->second]);
+    }
+}
+void NetworkBuilder::OnVersion(std::string&& version)
+{
+    _version = std::move(version);
+}
+void NetworkBuilder::OnNewSymbols(std::vector<std::string>&& new_symbols)
+{
+    _new_symbols = std::move(new_symbols);
+}
+void NetworkBuilder::OnBitTiming(G_BitTiming&& bit_timing)
+{
+    _bit_timing.emplace(bit_timing.baudrate, bit_timing.BTR1, bit_timing.BTR2);
+}
+void NetworkBuilder::OnNode(G_Node&& node)
+{
+    _node_indices.emplace(node.name, _nodes.size());
+    _nodes.emplace_back(std::move(node.name), std::string(), std::vector<AttributeImpl>());
+}
+void NetworkBuilder::OnValueTable(G_ValueTable&& value_table)
+{
+    _value_table_indices.emplace(value_table.name, _value_tables.size());
+    _value_tables.emplace_back(makeValueTable(value_table, std::nullopt));
+}
+void NetworkBuilder::OnMessage(G_Message&& message)
+{
+    _message = std::move(message);
+    _signals.clear();
+}
+void NetworkBuilder::OnSignal(G_Signal&& signal)
+{
+    _signals.emplace_back(makeSignal(
+          signal
+        , _message.size
+        , std::vector<AttributeImpl>()
+        , std::vector<ValueEncodingDescriptionImpl>()
+        , std::string()
+        , ISignal::EExtendedValueType::Integer
+        , std::vector<SignalMultiplexerValueImpl>()));
+}
+void NetworkBuilder::OnMessageEnd()
+{
+    _message_indices.emplace(_message.id, _messages.size());
+    _messages.emplace_back(
+          _message.id
+        , std::move(_message.name)
+        , _message.size
+        , std::move(_message.transmitter)
+        , std::vector<std::string>()
+        , std::move(_signals)
+        , std::vector<AttributeImpl>()
+        , std::string()
+        , std::vector<SignalGroupImpl>());
+    _signals.clear();
+}
+void NetworkBuilder::OnMessageTransmitter(G_MessageTransmitter&& message_transmitter)
+{
+    ForEachMessage(message_transmitter.id,
+        [&](MessageImpl& msg)
+        {
+            if (msg.messageTransmitters().empty())
+            {
+                msg.messageTransmitters() = message_transmitter.transmitters;
+            }
+        });
+}
+void NetworkBuilder::OnEnvironmentVariable(G_EnvironmentVariable&& environment_variable)
+{
+    _environment_variable_indices.emplace(environment_variable.name, _environment_variables.size());
+    _environment_variables.emplace_back(makeEnvironmentVariable(
+          environment_variable
+        , std::vector<ValueEncodingDescriptionImpl>()
+        , std::vector<AttributeImpl>()
+        , std::string()));
+}
+void NetworkBuilder::OnEnvironmentVariableData(G_EnvironmentVariableData&& environment_variable_data)
+{
+    ForEachEnvironmentVariable(environment_variable_data.name,
+        [&](EnvironmentVariableImpl& env_var)
+        {
+            if (env_var.varType() != IEnvironmentVariable::EVarType::Data)
+            {
+                env_var.varType() = IEnvironmentVariable::EVarType::Data;
+                env_var.dataSize() = environment_variable_data.size;
+            }
+        });
+}
+void NetworkBuilder::OnSignalType(G_SignalType&& signal_type)
+{
+    ForEachValueTable(signal_type.value_table_name,
+        [&](ValueTableImpl& value_table)
+        {
+            if (!value_table.signalType())
+            {
+                value_table.signalType().emplace(makeSignalType(signal_type));
+            }
+        });
+}
+void NetworkBuilder::OnComment(G_Comment&& comment)
+{
+    switch (comment.comment.which()) {
+    case 0: {
+        _comment = std::move(boost::get<G_CommentNetwork>(comment.comment).comment);
+    } break;
+    case 1: {
+        auto& c = boost::get<G_CommentNode>(comment.comment);
+        ForEachNode(c.node_name, [&](NodeImpl& node) { node.comment() = c.comment; });
+    } break;
+    case 2: {
+        auto& c = boost::get<G_CommentMessage>(comment.comment);
+        ForEachMessage(c.message_id, [&](MessageImpl& msg) { msg.comment() = c.comment; });
+    } break;
+    case 3: {
+        auto& c = boost::get<G_CommentSignal>(comment.comment);
+        ForEachSignal(c.message_id, c.signal_name, [&](MessageImpl&, SignalImpl& sig) { sig.comment() = c.comment; });
+    } break;
+    case 4: {
+        auto& c = boost::get<G_CommentEnvVar>(comment.comment);
+        ForEachEnvironmentVariable(c.env_var_name, [&](EnvironmentVariableImpl& env_var) { env_var.comment() = c.comment; });
+    } break;
+    default:
+        assert(false && "Unhandled variant member");
+        break;
+    }
+}
+void NetworkBuilder::OnAttributeDefinition(G_AttributeDefinition&& attribute_definition)
+{
+    _attribute_definitions.emplace_back(makeAttributeDefinition(attribute_definition));
+}
+void NetworkBuilder::OnAttributeDefault(G_Attribute&& attribute_default)
+{
+    _attribute_defaults.emplace_back(
+          std::move(attribute_default.name)
+        , IAttributeDefinition::EObjectType::Network
+        , boost_variant_to_std_variant(attribute_default.value));
+}
+void NetworkBuilder::OnAttributeValue(variant_attribute_t&& attribute_value)
+{
+    switch (attribute_value.which()) {
+    case 0: {
+        auto& attr = boost::get<G_AttributeNetwork>(attribute_value);
+        _attribute_values.emplace_back(
+              std::move(attr.attribute_name)
+            , IAttributeDefinition::EObjectType::Network
+            , boost_variant_to_std_variant(attr.value));
+    } break;
+    case 1: {
+        auto& attr = boost::get<G_AttributeNode>(attribute_value);
+        ForEachNode(attr.node_name,
+            [&](NodeImpl& node)
+            {
+                node.attributeValues().emplace_back(
+                      std::string(attr.attribute_name)
+                    , IAttributeDefinition::EObjectType::Node
+                    , boost_variant_to_std_variant(attr.value));
+            });
+    } break;
+    case 2: {
+        auto& attr = boost::get<G_AttributeMessage>(attribute_value);
+        ForEachMessage(attr.message_id,
+            [&](MessageImpl& msg)
+            {
+                msg.attributeValues().emplace_back(
+                      std::string(attr.attribute_name)
+                    , IAttributeDefinition::EObjectType::Message
+                    , boost_variant_to_std_variant(attr.value));
+            });
+    } break;
+    case 3: {
+        auto& attr = boost::get<G_AttributeSignal>(attribute_value);
+        ForEachSignal(attr.message_id, attr.signal_name,
+            [&](MessageImpl&, SignalImpl& sig)
+            {
+                sig.attributeValues().emplace_back(
+                      std::string(attr.attribute_name)
+                    , IAttributeDefinition::EObjectType::Signal
+                    , boost_variant_to_std_variant(attr.value));
+            });
+    } break;
+    case 4: {
+        auto& attr = boost::get<G_AttributeEnvVar>(attribute_value);
+        ForEachEnvironmentVariable(attr.env_var_name,
+            [&](EnvironmentVariableImpl& env_var)
+            {
+                env_var.attributeValues().emplace_back(
+                      std::string(attr.attribute_name)
+                    , IAttributeDefinition::EObjectType::EnvironmentVariable
+                    , boost_variant_to_std_variant(attr.value));
+            });
+    } break;
+    default:
+        assert(false && "Unhandled variant member");
+        break;
+    }
+}
+void NetworkBuilder::OnValueDescription(G_ValueDescriptionSigEnvVar&& value_description)
+{
+    switch (value_description.description.which()) {
+    case 0: {
+        auto& desc = boost::get<G_ValueDescriptionSignal>(value_description.description);
+        ForEachSignal(desc.message_id, desc.signal_name,
+            [&](MessageImpl&, SignalImpl& sig)
+            {
+                sig.valueEncodingDescriptions() = makeValueEncodingDescriptions(desc.value_descriptions);
+            });
+    } break;
+    case 1: {
+        auto& desc = boost::get<G_ValueDescriptionEnvVar>(value_description.description);
+        ForEachEnvironmentVariable(desc.env_var_name,
+            [&](EnvironmentVariableImpl& env_var)
+            {
+                env_var.valueEncodingDescriptions() = makeValueEncodingDescriptions(desc.value_descriptions);
+            });
+    } break;
+    default:
+        assert(false && "Unhandled variant member");
+        break;
+    }
+}
+void NetworkBuilder::OnSignalGroup(G_SignalGroup&& signal_group)
+{
+    ForEachMessage(signal_group.message_id,
+        [&](MessageImpl& msg)
+        {
+            msg.signalGroups().emplace_back(makeSignalGroup(signal_group));
+        });
+}
+void NetworkBuilder::OnSignalExtendedValueType(G_SignalExtendedValueType&& signal_extended_value_type)
+{
+    auto key = std::make_pair(signal_extended_value_type.message_id, signal_extended_value_type.signal_name);
+    if (!_signals_with_extended_value_type.insert(std::move(key)).second)
+    {
+        return;
+    }
+    auto extended_value_type = makeExtendedValueType(signal_extended_value_type.value);
+    ForEachSignal(signal_extended_value_type.message_id, signal_extended_value_type.signal_name,
+        [&](MessageImpl& msg, SignalImpl& sig)
+        {
+            sig.setExtendedValueType(extended_value_type, msg.MessageSize());
+        });
+}
+void NetworkBuilder::OnSignalMultiplexerValue(G_SignalMultiplexerValue&& signal_multiplexer_value)
+{
+    ForEachSignal(signal_multiplexer_value.message_id, signal_multiplexer_value.signal_name,
+        [&](MessageImpl&, SignalImpl& sig)
+        {
+            sig.signalMultiplexerValues().emplace_back(makeSignalMultiplexerValue(signal_multiplexer_value));
+        });
+}
+LoadOptions LoadOptions::DecodeOnly()
+{
+    LoadOptions options;
+    options.comments = false;
+    options.attribute_definitions = false;
+    options.attribute_values = false;
+    options.environment_variables = false;
+    options.signal_groups = false;
+    return options;
+}
+NetworkBuilder::NetworkBuilder(const LoadOptions& options)
+    : _options(options)
+{}
+bool NetworkBuilder::Wants(EStatement statement) const
+{
+    switch (statement)
+    {
+    case EStatement::Comment:                   return _options.comments;
+    case EStatement::AttributeDefinition:       return _options.attribute_definitions;
+    case EStatement::AttributeDefault:          return _options.attribute_values;
+    case EStatement::AttributeValue:            return _options.attribute_values;
+    case EStatement::ValueTable:                return _options.value_descriptions;
+    case EStatement::SignalType:                return _options.value_descriptions;
+    case EStatement::ValueDescription:          return _options.value_descriptions;
+    case EStatement::EnvironmentVariable:       return _options.environment_variables;
+    case EStatement::EnvironmentVariableData:   return _options.environment_variables;
+    case EStatement::SignalGroup:               return _options.signal_groups;
+    }
+    return true;
+}
+std::unique_ptr<INetwork> NetworkBuilder::Finish()
+{
+    return std::make_unique<NetworkImpl>(
+          std::move(_version)
+        , std::move(_new_symbols)
+        , _bit_timing ? std::move(*_bit_timing) : BitTimingImpl(0, 0, 0)
+        , std::move(_nodes)
+        , std::move(_value_tables)
+        , std::move(_messages)
+        , std::move(_environment_variables)
+        , std::move(_attribute_definitions)
+        , std::move(_attribute_defaults)
+        , std::move(_attribute_values)
+        , std::move(_comment));
+}
+
+std::unique_ptr<INetwork> INetwork::LoadDBCFromIs(std::istream& is)
+{
+    std::string error_message;
+    auto network = LoadDBCFromIs(is, error_message);
     if (!network) {
         std::cerr << error_message <<std::endl;
     }
@@ -875,16 +1477,54 @@ std::unique_ptr<INetwork> INetwork::LoadDBCFromIs(std::istream& is)
 
 std::unique_ptr<INetwork> INetwork::LoadDBCFromIs(std::istream& is, std::string &error_message)
 {
+    return LoadDBCFromIs(is, LoadOptions(), error_message);
+}
+
+// smaller inputs aren't worth the overhead of splitting them
+static constexpr std::size_t min_parallel_chunk_size = 256 * 1024;
+std::unique_ptr<INetwork> INetwork::LoadDBCFromIs(std::istream& is, const LoadOptions& options, std::string& error_message)
+{
+    LoadStatsRecorder recorder(options.stats);
     std::string str((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    recorder.Phase("read");
     std::unique_ptr<dbcppp::INetwork> network;
-    if (auto gnet = dbcppp::DBCX3::ParseFromMemory(str.c_str(), str.c_str() + str.size(), error_message))
-    {
-        try {
-            network = DBCAST2Network(*gnet);
-        } catch (const std::exception &e) {
-            error_message = e.what();
+    try {
+        NetworkBuilder builder(options);
+        auto threads = resolve_thread_count(options.threads);
+        if (threads > 1)
+        {
+            // a few chunks per thread keep the threads busy if the statements are unevenly expensive
+            auto chunk_size = std::max<std::size_t>(min_parallel_chunk_size, str.size() / (threads * 4));
+            auto gnet = dbcppp::DBCX3::ParseFromMemoryParallel(str.c_str(), str.c_str() + str.size(), threads, chunk_size, builder, error_message);
+            recorder.Phase("parse");
+            if (gnet)
+            {
+                if (recorder.Enabled())
+                {
+                    recordAstNodes(recorder, countAstNodes(*gnet));
+                }
+                network = DBCAST2Network(*gnet, threads, &recorder);
+            }
+        }
+        else if (recorder.Enabled())
+        {
+            MeasuringHandler handler(builder);
+            if (dbcppp::DBCX3::ParseFromMemory(str.c_str(), str.c_str() + str.size(), handler, error_message))
+            {
+                recorder.Phase("parse", std::move(handler.Create()));
+                recordAstNodes(recorder, handler.Counts());
+                network = builder.Finish();
+                recorder.Phase("build network");
+            }
+        }
+        else if (dbcppp::DBCX3::ParseFromMemory(str.c_str(), str.c_str() + str.size(), builder, error_message))
+        {
+            network = builder.Finish();
         }
+    } catch (const std::exception &e) {
+        error_message = e.what();
     }
+    recorder.Finish(network.get());
     return network;
 }
 
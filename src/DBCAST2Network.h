@@ -0,0 +1,95 @@
+#pragma once
+
+#include <set>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+#include "dbcppp/Network.h"
+#include "dbcppp/LoadOptions.h"
+#include "NetworkImpl.h"
+#include "LoadStatsRecorder.h"
+#include "DBCX3.h"
+
+namespace dbcppp
+{
+    // The messages are converted on up to threads threads (0 = hardware concurrency),
+    // the result doesn't depend on the number of threads.
+    std::unique_ptr<INetwork> DBCPPP_API DBCAST2Network(
+          const DBCX3::AST::G_Network& gnet
+        , std::size_t threads = 1
+        , LoadStatsRecorder* recorder = nullptr);
+
+    // Builds the network directly from the events of the streaming parser. Every statement is applied
+    // to the already built objects as soon as it is parsed, so the AST never exists as a whole.
+    // Statements which refer to an object (attributes, comments, value descriptions, ...) are expected
+    // to follow the object's definition, as the DBC format prescribes it.
+    class DBCPPP_API NetworkBuilder final
+        : public DBCX3::ParserHandler
+    {
+    public:
+        NetworkBuilder(const LoadOptions& options = LoadOptions());
+
+        virtual bool Wants(EStatement statement) const override;
+        virtual void OnVersion(std::string&& version) override;
+        virtual void OnNewSymbols(std::vector<std::string>&& new_symbols) override;
+        virtual void OnBitTiming(DBCX3::AST::G_BitTiming&& bit_timing) override;
+        virtual void OnNode(DBCX3::AST::G_Node&& node) override;
+        virtual void OnValueTable(DBCX3::AST::G_ValueTable&& value_table) override;
+        virtual void OnMessage(DBCX3::AST::G_Message&& message) override;
+        virtual void OnSignal(DBCX3::AST::G_Signal&& signal) override;
+        virtual void OnMessageEnd() override;
+        virtual void OnMessageTransmitter(DBCX3::AST::G_MessageTransmitter&& message_transmitter) override;
+        virtual void OnEnvironmentVariable(DBCX3::AST::G_EnvironmentVariable&& environment_variable) override;
+        virtual void OnEnvironmentVariableData(DBCX3::AST::G_EnvironmentVariableData&& environment_variable_data) override;
+        virtual void OnSignalType(DBCX3::AST::G_SignalType&& signal_type) override;
+        virtual void OnComment(DBCX3::AST::G_Comment&& comment) override;
+        virtual void OnAttributeDefinition(DBCX3::AST::G_AttributeDefinition&& attribute_definition) override;
+        virtual void OnAttributeDefault(DBCX3::AST::G_Attribute&& attribute_default) override;
+        virtual void OnAttributeValue(DBCX3::AST::variant_attribute_t&& attribute_value) override;
+        virtual void OnValueDescription(DBCX3::AST::G_ValueDescriptionSigEnvVar&& value_description) override;
+        virtual void OnSignalGroup(DBCX3::AST::G_SignalGroup&& signal_group) override;
+        virtual void OnSignalExtendedValueType(DBCX3::AST::G_SignalExtendedValueType&& signal_extended_value_type) override;
+        virtual void OnSignalMultiplexerValue(DBCX3::AST::G_SignalMultiplexerValue&& signal_multiplexer_value) override;
+
+        // moves everything built so far into the network, the builder must not be used afterwards
+        std::unique_ptr<INetwork> Finish();
+
+    private:
+        template <class Func>
+        void ForEachMessage(uint64_t message_id, Func&& func);
+        template <class Func>
+        void ForEachSignal(uint64_t message_id, const std::string& signal_name, Func&& func);
+        template <class Func>
+        void ForEachNode(const std::string& node_name, Func&& func);
+        template <class Func>
+        void ForEachValueTable(const std::string& value_table_name, Func&& func);
+        template <class Func>
+        void ForEachEnvironmentVariable(const std::string& env_var_name, Func&& func);
+
+        LoadOptions _options;
+
+        std::string _version;
+        std::vector<std::string> _new_symbols;
+        std::optional<BitTimingImpl> _bit_timing;
+        std::vector<NodeImpl> _nodes;
+        std::vector<ValueTableImpl> _value_tables;
+        std::vector<MessageImpl> _messages;
+        std::vector<EnvironmentVariableImpl> _environment_variables;
+        std::vector<AttributeDefinitionImpl> _attribute_definitions;
+        std::vector<AttributeImpl> _attribute_defaults;
+        std::vector<AttributeImpl> _attribute_values;
+        std::string _comment;
+
+        // the message whose signals are currently parsed
+        DBCX3::AST::G_Message _message;
+        std::vector<SignalImpl> _signals;
+
+        std::unordered_multimap<uint64_t, std::size_t> _message_indices;
+        std::unordered_multimap<std::string, std::size_t> _node_indices;
+        std::unordered_multimap<std::string, std::size_t> _value_table_indices;
+        std::unordered_multimap<std::string, std::size_t> _environment_variable_indices;
+        // only the first SIG_VALTYPE_ of a signal is taken into account
+        std::set<std::pair<uint64_t, std::string>> _signals_with_extended_value_type;
+    };
+}
@@ -1,4 +1,9 @@
 
+#include <cctype>
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+
 #include <boost/spirit/home/x3.hpp>
 #include <boost/fusion/include/adapt_struct.hpp>
 #include <boost/spirit/home/x3/support/utility/error_reporting.hpp>
@@ -7,6 +12,7 @@
 
 #include "NetworkImpl.h"
 #include "DBCX3.h"
+#include "Parallel.h"
 
 #include "DBCX3AdaptStructs.inl"
 
@@ -54,6 +60,7 @@ namespace dbcppp::DBCX3::Grammar
     static const rule<struct TagValueTableName, std::string> value_table_name("ValueTableName");
     static const rule<struct TagValueEncodingDescription, G_ValueEncodingDescription> value_encoding_description("ValueEncodingDescription");
     static const rule<struct TagMessage, G_Message> message("Message");
+    static const rule<struct TagMessageHeader, G_Message> message_header("MessageHeader");
     static const rule<struct TagMessageId, uint64_t> message_id("MessageID");
     static const rule<struct TagMessageName, std::string> message_name("MessageName");
     static const rule<struct TagMessageSize, uint64_t> message_size("MessageSize");
@@ -202,6 +209,8 @@ namespace dbcppp::DBCX3::Grammar
 
     static const auto message_def = lexeme[lit("BO_") >> omit[skipper]] > message_id > message_name
         > ':' > message_size > skip(blank)[transmitter > (eol | eoi)] > *signal;
+    static const auto message_header_def = lexeme[lit("BO_") >> omit[skipper]] > message_id > message_name
+        > ':' > message_size > skip(blank)[transmitter > (eol | eoi)] >> attr(std::vector<G_Signal>());
     static const auto message_id_def = unsigned_int;
     static const auto message_name_def = C_identifier;
     static const auto message_size_def = unsigned_int;
@@ -322,6 +331,7 @@ namespace dbcppp::DBCX3::Grammar
     BOOST_SPIRIT_DEFINE(value_table_name);
     BOOST_SPIRIT_DEFINE(value_encoding_description);
     BOOST_SPIRIT_DEFINE(message);
+    BOOST_SPIRIT_DEFINE(message_header);
     BOOST_SPIRIT_DEFINE(message_id);
     BOOST_SPIRIT_DEFINE(message_name);
     BOOST_SPIRIT_DEFINE(message_size);
@@ -399,6 +409,7 @@ namespace dbcppp::DBCX3::Grammar
     struct TagValueTableName                : error_handler, annotate_on_success {};
     struct TagValueEncodingDescription      : error_handler, annotate_on_success {};
     struct TagTagMessage                    : error_handler, annotate_on_success {};
+    struct TagMessageHeader                 : error_handler, annotate_on_success {};
     struct TagMessageId                     : error_handler, annotate_on_success {};
     struct TagMessageName                   : error_handler, annotate_on_success {};
     struct TagMessageSize                   : error_handler, annotate_on_success {};
@@ -452,23 +463,602 @@ namespace dbcppp::DBCX3::Grammar
     struct TagSignalMultiplexerValue        : error_handler, annotate_on_success {};
     struct TagNetwork                       : error_handler, annotate_on_success {};
 }
+namespace
+{
+    // Error handler for the first parse attempt. It neither records the positions of the AST nodes
+    // nor reports errors, if the input doesn't parse it's parsed again with the x3::error_handler.
+    struct FastErrorHandler
+    {
+        template <class T>
+        void tag(T&, const char*, const char*)
+        {}
+        void operator()(const char*, const std::string&)
+        {}
+    };
+
+    template <class ErrorHandler>
+    bool parseNetwork(const char* begin, const char* end, ErrorHandler& error_handler, dbcppp::DBCX3::AST::G_Network& gnet)
+    {
+        using boost::spirit::x3::with;
+        using boost::spirit::x3::error_handler_tag;
+        auto const parser =
+            with<error_handler_tag>(std::ref(error_handler))
+            [
+                dbcppp::DBCX3::Grammar::network
+            ];
+        return phrase_parse(begin, end, parser, dbcppp::DBCX3::Grammar::skipper, gnet) && begin == end;
+    }
+}
 std::optional<dbcppp::DBCX3::AST::G_Network> dbcppp::DBCX3::ParseFromMemory(const char* begin, const char* end, std::string &error_message)
 {
-    using boost::spirit::x3::with;
-    using boost::spirit::x3::error_handler_tag;
+    {
+        FastErrorHandler error_handler;
+        dbcppp::DBCX3::AST::G_Network gnet;
+        if (parseNetwork(begin, end, error_handler, gnet))
+        {
+            return gnet;
+        }
+    }
+    return ParseFromMemoryAnnotated(begin, end, error_message);
+}
+std::optional<dbcppp::DBCX3::AST::G_Network> dbcppp::DBCX3::ParseFromMemoryAnnotated(const char* begin, const char* end, std::string &error_message)
+{
     using error_handler_type = boost::spirit::x3::error_handler<const char*>;
     std::ostringstream error_stream; 
     error_handler_type error_handler(begin, end, error_stream);
-    auto const parser =
-        with<error_handler_tag>(std::ref(error_handler))
-        [
-            dbcppp::DBCX3::Grammar::network
-        ];
     dbcppp::DBCX3::AST::G_Network gnet;
-    if (phrase_parse(begin, end, parser, Grammar::skipper, gnet) && begin == end)
+    if (parseNetwork(begin, end, error_handler, gnet))
     {
         return gnet;
     }
     error_message = error_stream.str();
     return std::nullopt;
-}
\ No newline at end of file
+}
+namespace
+{
+    using dbcppp::DBCX3::ParserHandler;
+
+    struct Keyword
+    {
+        std::string_view name;
+        ParserHandler::EStatement statement;
+    };
+    static const Keyword keywords[] =
+    {
+        {"VAL_TABLE_",      ParserHandler::EStatement::ValueTable},
+        {"BO_",             ParserHandler::EStatement::Message},
+        {"BO_TX_BU_",       ParserHandler::EStatement::MessageTransmitter},
+        {"EV_",             ParserHandler::EStatement::EnvironmentVariable},
+        {"ENVVAR_DATA_",    ParserHandler::EStatement::EnvironmentVariableData},
+        {"SGTYPE_",         ParserHandler::EStatement::SignalType},
+        {"CM_",             ParserHandler::EStatement::Comment},
+        {"BA_DEF_",         ParserHandler::EStatement::AttributeDefinition},
+        {"BA_DEF_DEF_",     ParserHandler::EStatement::AttributeDefault},
+        {"BA_DEF_DEF_REL_", ParserHandler::EStatement::AttributeDefault},
+        {"BA_",             ParserHandler::EStatement::AttributeValue},
+        {"VAL_",            ParserHandler::EStatement::ValueDescription},
+        {"SIG_GROUP_",      ParserHandler::EStatement::SignalGroup},
+        {"SIG_VALTYPE_",    ParserHandler::EStatement::SignalExtendedValueType},
+        {"SG_MUL_VAL_",     ParserHandler::EStatement::SignalMultiplexerValue}
+    };
+
+    // skips whitespaces and comments and returns the keyword the next statement starts with
+    std::string_view peekKeyword(const char*& iter, const char* end)
+    {
+        boost::spirit::x3::phrase_parse(iter, end, boost::spirit::x3::eps, dbcppp::DBCX3::Grammar::skipper);
+        auto keyword_end = iter;
+        while (keyword_end != end && (std::isalnum(static_cast<unsigned char>(*keyword_end)) || *keyword_end == '_'))
+        {
+            keyword_end++;
+        }
+        return std::string_view(iter, keyword_end - iter);
+    }
+    // skips a ';' terminated statement without parsing it, a ';' in a string or comment doesn't end it
+    void skipStatement(const char*& iter, const char* end)
+    {
+        bool quoted = false;
+        for (; iter != end; iter++)
+        {
+            if (quoted)
+            {
+                if (*iter == '\\' && iter + 1 != end)
+                {
+                    iter++;
+                }
+                else if (*iter == '"')
+                {
+                    quoted = false;
+                }
+            }
+            else if (*iter == '"')
+            {
+                quoted = true;
+            }
+            else if (*iter == '/' && iter + 1 != end && iter[1] == '/')
+            {
+                iter = std::find(iter, end, '\n');
+                if (iter == end)
+                {
+                    break;
+                }
+            }
+            else if (*iter == '/' && iter + 1 != end && iter[1] == '*')
+            {
+                static const char block_comment_end[] = "*/";
+                iter = std::search(iter + 2, end, block_comment_end, block_comment_end + 2);
+                if (iter == end)
+                {
+                    break;
+                }
+                iter++;
+            }
+            else if (*iter == ';')
+            {
+                iter++;
+                break;
+            }
+        }
+    }
+    void skipLine(const char*& iter, const char* end)
+    {
+        iter = std::find(iter, end, '\n');
+    }
+    const Keyword* findKeyword(std::string_view name)
+    {
+        auto kw = std::find_if(std::begin(keywords), std::end(keywords),
+            [&](const Keyword& k) { return k.name == name; });
+        return kw != std::end(keywords) ? kw : nullptr;
+    }
+
+    template <class ErrorHandler>
+    class StatementParser
+    {
+    public:
+        StatementParser(const char* begin, const char* end, ParserHandler& handler, ErrorHandler& error_handler)
+            : _iter(begin)
+            , _end(end)
+            , _handler(handler)
+            , _error_handler(error_handler)
+        {}
+
+        // VERSION, NS_, BS_ and BU_
+        bool ParseHeader()
+        {
+            using namespace dbcppp::DBCX3::AST;
+            namespace Grammar = dbcppp::DBCX3::Grammar;
+            bool success = Dispatch(Grammar::version, std::string(), &ParserHandler::OnVersion);
+            if (success && peekKeyword(_iter, _end) == "NS_")
+            {
+                success = Dispatch(Grammar::new_symbols, std::vector<std::string>(), &ParserHandler::OnNewSymbols);
+            }
+            success = success && Dispatch(Grammar::bit_timing, G_BitTiming{}, &ParserHandler::OnBitTiming);
+            std::vector<G_Node> nodes;
+            success = success && Parse(Grammar::nodes, nodes);
+            if (success)
+            {
+                for (auto& node : nodes)
+                {
+                    _handler.OnNode(std::move(node));
+                }
+            }
+            return success;
+        }
+        // everything following the header up to the end of the input
+        bool ParseStatements()
+        {
+            using namespace dbcppp::DBCX3::AST;
+            namespace Grammar = dbcppp::DBCX3::Grammar;
+            bool success = true;
+            while (success)
+            {
+                auto keyword = peekKeyword(_iter, _end);
+                if (_iter == _end)
+                {
+                    break;
+                }
+                auto kw = findKeyword(keyword);
+                if (!kw)
+                {
+                    _error_handler(_iter, "Error! Unexpected statement here:");
+                    success = false;
+                    break;
+                }
+                if (kw->statement == ParserHandler::EStatement::Message)
+                {
+                    bool wanted = _handler.Wants(ParserHandler::EStatement::Message);
+                    if (wanted)
+                    {
+                        success = Dispatch(Grammar::message_header, G_Message(), &ParserHandler::OnMessage);
+                    }
+                    else
+                    {
+                        skipLine(_iter, _end);
+                    }
+                    while (success && peekKeyword(_iter, _end) == "SG_")
+                    {
+                        if (wanted)
+                        {
+                            success = Dispatch(Grammar::signal, G_Signal(), &ParserHandler::OnSignal);
+                        }
+                        else
+                        {
+                            skipLine(_iter, _end);
+                        }
+                    }
+                    if (success && wanted)
+                    {
+                        _handler.OnMessageEnd();
+                    }
+                    continue;
+                }
+                if (!_handler.Wants(kw->statement))
+                {
+                    skipStatement(_iter, _end);
+                    continue;
+                }
+                switch (kw->statement)
+                {
+                case ParserHandler::EStatement::ValueTable:
+                    success = Dispatch(Grammar::value_table, G_ValueTable(), &ParserHandler::OnValueTable);
+                    break;
+                case ParserHandler::EStatement::MessageTransmitter:
+                    success = Dispatch(Grammar::message_transmitter, G_MessageTransmitter(), &ParserHandler::OnMessageTransmitter);
+                    break;
+                case ParserHandler::EStatement::EnvironmentVariable:
+                    success = Dispatch(Grammar::environment_variable, G_EnvironmentVariable(), &ParserHandler::OnEnvironmentVariable);
+                    break;
+                case ParserHandler::EStatement::EnvironmentVariableData:
+                    success = Dispatch(Grammar::environment_variable_data, G_EnvironmentVariableData(), &ParserHandler::OnEnvironmentVariableData);
+                    break;
+                case ParserHandler::EStatement::SignalType:
+                    success = Dispatch(Grammar::signal_type, G_SignalType(), &ParserHandler::OnSignalType);
+                    break;
+                case ParserHandler::EStatement::Comment:
+                    success = Dispatch(Grammar::comment, G_Comment(), &ParserHandler::OnComment);
+                    break;
+                case ParserHandler::EStatement::AttributeDefinition:
+                    success = Dispatch(Grammar::attribute_definition, G_AttributeDefinition(), &ParserHandler::OnAttributeDefinition);
+                    break;
+                case ParserHandler::EStatement::AttributeDefault:
+                    success = Dispatch(Grammar::attribute_default, G_Attribute(), &ParserHandler::OnAttributeDefault);
+                    break;
+                case ParserHandler::EStatement::AttributeValue:
+                    success = Dispatch(Grammar::attribute_value_ent, variant_attribute_t(), &ParserHandler::OnAttributeValue);
+                    break;
+                case ParserHandler::EStatement::ValueDescription:
+                    success = Dispatch(Grammar::value_description_sig_env_var, G_ValueDescriptionSigEnvVar(), &ParserHandler::OnValueDescription);
+                    break;
+                case ParserHandler::EStatement::SignalGroup:
+                    success = Dispatch(Grammar::signal_group, G_SignalGroup(), &ParserHandler::OnSignalGroup);
+                    break;
+                case ParserHandler::EStatement::SignalExtendedValueType:
+                    success = Dispatch(Grammar::signal_extended_value_type, G_SignalExtendedValueType(), &ParserHandler::OnSignalExtendedValueType);
+                    break;
+                case ParserHandler::EStatement::SignalMultiplexerValue:
+                    success = Dispatch(Grammar::signal_multiplexer_value, G_SignalMultiplexerValue(), &ParserHandler::OnSignalMultiplexerValue);
+                    break;
+                }
+            }
+            return success;
+        }
+        const char* Position() const
+        {
+            return _iter;
+        }
+
+    private:
+        template <class Rule, class Attribute>
+        bool Parse(const Rule& rule, Attribute& attribute)
+        {
+            using boost::spirit::x3::with;
+            using boost::spirit::x3::error_handler_tag;
+            auto const parser =
+                with<error_handler_tag>(std::ref(_error_handler))
+                [
+                    boost::spirit::x3::expect[rule]
+                ];
+            try
+            {
+                return phrase_parse(_iter, _end, parser, dbcppp::DBCX3::Grammar::skipper, attribute);
+            }
+            catch (const boost::spirit::x3::expectation_failure<const char*>& x)
+            {
+                _error_handler(x.where(), "Error! Expecting: " + x.which() + " here:");
+            }
+            return false;
+        }
+        template <class Rule, class Attribute, class Callback>
+        bool Dispatch(const Rule& rule, Attribute&& attribute, Callback callback)
+        {
+            if (!Parse(rule, attribute))
+            {
+                return false;
+            }
+            (_handler.*callback)(std::move(attribute));
+            return true;
+        }
+
+        const char* _iter;
+        const char* _end;
+        ParserHandler& _handler;
+        ErrorHandler& _error_handler;
+    };
+
+    template <class ErrorHandler>
+    bool parseStatements(const char* begin, const char* end, ParserHandler& handler, ErrorHandler& error_handler)
+    {
+        StatementParser<ErrorHandler> parser(begin, end, handler, error_handler);
+        return parser.ParseHeader() && parser.ParseStatements();
+    }
+
+    // skips the same statements as the wrapped handler but ignores all events,
+    // used to parse the input again for the error message
+    class WantsOnlyHandler
+        : public ParserHandler
+    {
+    public:
+        WantsOnlyHandler(const ParserHandler& handler)
+            : _handler(handler)
+        {}
+        virtual bool Wants(EStatement statement) const override
+        {
+            return _handler.Wants(statement);
+        }
+
+    private:
+        const ParserHandler& _handler;
+    };
+
+    // collects the statements into a (partial) AST, skipping the same statements as the filter
+    class NetworkCollector
+        : public ParserHandler
+    {
+    public:
+        NetworkCollector(const ParserHandler& filter, dbcppp::DBCX3::AST::G_Network& gnet)
+            : _filter(filter)
+            , _gnet(gnet)
+        {}
+        virtual bool Wants(EStatement statement) const override
+        {
+            return _filter.Wants(statement);
+        }
+        virtual void OnVersion(std::string&& version) override
+        {
+            _gnet.version.version = std::move(version);
+        }
+        virtual void OnNewSymbols(std::vector<std::string>&& new_symbols) override
+        {
+            _gnet.new_symbols = std::move(new_symbols);
+        }
+        virtual void OnBitTiming(dbcppp::DBCX3::AST::G_BitTiming&& bit_timing) override
+        {
+            _gnet.bit_timing = std::move(bit_timing);
+        }
+        virtual void OnNode(dbcppp::DBCX3::AST::G_Node&& node) override
+        {
+            _gnet.nodes.push_back(std::move(node));
+        }
+        virtual void OnValueTable(dbcppp::DBCX3::AST::G_ValueTable&& value_table) override
+        {
+            _gnet.value_tables.push_back(std::move(value_table));
+        }
+        virtual void OnMessage(dbcppp::DBCX3::AST::G_Message&& message) override
+        {
+            _gnet.messages.push_back(std::move(message));
+        }
+        virtual void OnSignal(dbcppp::DBCX3::AST::G_Signal&& signal) override
+        {
+            _gnet.messages.back().signals.push_back(std::move(signal));
+        }
+        virtual void OnMessageTransmitter(dbcppp::DBCX3::AST::G_MessageTransmitter&& message_transmitter) override
+        {
+            _gnet.message_transmitters.push_back(std::move(message_transmitter));
+        }
+        virtual void OnEnvironmentVariable(dbcppp::DBCX3::AST::G_EnvironmentVariable&& environment_variable) override
+        {
+            _gnet.environment_variables.push_back(std::move(environment_variable));
+        }
+        virtual void OnEnvironmentVariableData(dbcppp::DBCX3::AST::G_EnvironmentVariableData&& environment_variable_data) override
+        {
+            _gnet.environment_variable_datas.push_back(std::move(environment_variable_data));
+        }
+        virtual void OnSignalType(dbcppp::DBCX3::AST::G_SignalType&& signal_type) override
+        {
+            _gnet.signal_types.push_back(std::move(signal_type));
+        }
+        virtual void OnComment(dbcppp::DBCX3::AST::G_Comment&& comment) override
+        {
+            _gnet.comments.push_back(std::move(comment));
+        }
+        virtual void OnAttributeDefinition(dbcppp::DBCX3::AST::G_AttributeDefinition&& attribute_definition) override
+        {
+            _gnet.attribute_definitions.push_back(std::move(attribute_definition));
+        }
+        virtual void OnAttributeDefault(dbcppp::DBCX3::AST::G_Attribute&& attribute_default) override
+        {
+            _gnet.attribute_defaults.push_back(std::move(attribute_default));
+        }
+        virtual void OnAttributeValue(dbcppp::DBCX3::AST::variant_attribute_t&& attribute_value) override
+        {
+            _gnet.attribute_values.push_back(std::move(attribute_value));
+        }
+        virtual void OnValueDescription(dbcppp::DBCX3::AST::G_ValueDescriptionSigEnvVar&& value_description) override
+        {
+            _gnet.value_descriptions_sig_env_var.push_back(std::move(value_description));
+        }
+        virtual void OnSignalGroup(dbcppp::DBCX3::AST::G_SignalGroup&& signal_group) override
+        {
+            _gnet.signal_groups.push_back(std::move(signal_group));
+        }
+        virtual void OnSignalExtendedValueType(dbcppp::DBCX3::AST::G_SignalExtendedValueType&& signal_extended_value_type) override
+        {
+            _gnet.signal_extended_value_types.push_back(std::move(signal_extended_value_type));
+        }
+        virtual void OnSignalMultiplexerValue(dbcppp::DBCX3::AST::G_SignalMultiplexerValue&& signal_multiplexer_value) override
+        {
+            _gnet.signal_multiplexer_values.push_back(std::move(signal_multiplexer_value));
+        }
+
+    private:
+        const ParserHandler& _filter;
+        dbcppp::DBCX3::AST::G_Network& _gnet;
+    };
+
+    // Returns the positions at which the statements following the header can be split into chunks
+    // of at least chunk_size bytes. A chunk starts at a line which starts with a top level keyword
+    // outside of strings and comments, the first chunk starts at begin.
+    std::vector<const char*> findChunkBoundaries(const char* begin, const char* end, std::size_t chunk_size)
+    {
+        std::vector<const char*> boundaries{begin};
+        if (static_cast<std::size_t>(end - begin) <= chunk_size)
+        {
+            return boundaries;
+        }
+        auto next = begin + chunk_size;
+        bool line_start = true;
+        auto iter = begin;
+        while (iter != end)
+        {
+            if (*iter == '"')
+            {
+                for (iter++; iter != end && *iter != '"'; iter++)
+                {
+                    if (*iter == '\\' && iter + 1 != end)
+                    {
+                        iter++;
+                    }
+                }
+                if (iter != end)
+                {
+                    iter++;
+                }
+                line_start = false;
+            }
+            else if (*iter == '/' && iter + 1 != end && iter[1] == '/')
+            {
+                iter = std::find(iter, end, '\n');
+            }
+            else if (*iter == '/' && iter + 1 != end && iter[1] == '*')
+            {
+                static const char block_comment_end[] = "*/";
+                iter = std::search(iter + 2, end, block_comment_end, block_comment_end + 2);
+                iter = iter != end ? iter + 2 : end;
+                line_start = false;
+            }
+            else if (*iter == '\n')
+            {
+                line_start = true;
+                iter++;
+            }
+            else if (line_start && std::isspace(static_cast<unsigned char>(*iter)))
+            {
+                iter++;
+            }
+            else
+            {
+                if (line_start && iter >= next)
+                {
+                    auto keyword_end = iter;
+                    while (keyword_end != end && (std::isalnum(static_cast<unsigned char>(*keyword_end)) || *keyword_end == '_'))
+                    {
+                        keyword_end++;
+                    }
+                    if (findKeyword(std::string_view(iter, keyword_end - iter)))
+                    {
+                        boundaries.push_back(iter);
+                        if (static_cast<std::size_t>(end - iter) <= chunk_size)
+                        {
+                            break;
+                        }
+                        next = iter + chunk_size;
+                    }
+                }
+                line_start = false;
+                iter++;
+            }
+        }
+        return boundaries;
+    }
+
+    template <class T>
+    void append(std::vector<T>& to, std::vector<T>&& from)
+    {
+        to.insert(to.end(), std::make_move_iterator(from.begin()), std::make_move_iterator(from.end()));
+    }
+    void appendStatements(dbcppp::DBCX3::AST::G_Network& gnet, dbcppp::DBCX3::AST::G_Network&& chunk)
+    {
+        append(gnet.value_tables, std::move(chunk.value_tables));
+        append(gnet.messages, std::move(chunk.messages));
+        append(gnet.message_transmitters, std::move(chunk.message_transmitters));
+        append(gnet.environment_variables, std::move(chunk.environment_variables));
+        append(gnet.environment_variable_datas, std::move(chunk.environment_variable_datas));
+        append(gnet.signal_types, std::move(chunk.signal_types));
+        append(gnet.comments, std::move(chunk.comments));
+        append(gnet.attribute_definitions, std::move(chunk.attribute_definitions));
+        append(gnet.attribute_defaults, std::move(chunk.attribute_defaults));
+        append(gnet.attribute_values, std::move(chunk.attribute_values));
+        append(gnet.value_descriptions_sig_env_var, std::move(chunk.value_descriptions_sig_env_var));
+        append(gnet.signal_groups, std::move(chunk.signal_groups));
+        append(gnet.signal_extended_value_types, std::move(chunk.signal_extended_value_types));
+        append(gnet.signal_multiplexer_values, std::move(chunk.signal_multiplexer_values));
+    }
+}
+bool dbcppp::DBCX3::ParseFromMemory(const char* begin, const char* end, ParserHandler& handler, std::string& error_message)
+{
+    FastErrorHandler fast_error_handler;
+    if (parseStatements(begin, end, handler, fast_error_handler))
+    {
+        return true;
+    }
+    using error_handler_type = boost::spirit::x3::error_handler<const char*>;
+    std::ostringstream error_stream;
+    error_handler_type error_handler(begin, end, error_stream);
+    WantsOnlyHandler wants_only(handler);
+    parseStatements(begin, end, wants_only, error_handler);
+    error_message = error_stream.str();
+    return false;
+}
+std::optional<dbcppp::DBCX3::AST::G_Network> dbcppp::DBCX3::ParseFromMemoryParallel(
+      const char* begin, const char* end
+    , std::size_t threads, std::size_t chunk_size
+    , const ParserHandler& filter, std::string& error_message)
+{
+    AST::G_Network gnet;
+    {
+        FastErrorHandler error_handler;
+        NetworkCollector collector(filter, gnet);
+        StatementParser<FastErrorHandler> header_parser(begin, end, collector, error_handler);
+        if (header_parser.ParseHeader())
+        {
+            auto boundaries = findChunkBoundaries(header_parser.Position(), end, chunk_size);
+            std::vector<AST::G_Network> chunks(boundaries.size());
+            std::vector<char> results(boundaries.size(), false);
+            parallel_for(boundaries.size(), threads,
+                [&](std::size_t i)
+                {
+                    auto chunk_end = i + 1 < boundaries.size() ? boundaries[i + 1] : end;
+                    FastErrorHandler chunk_error_handler;
+                    NetworkCollector chunk_collector(filter, chunks[i]);
+                    StatementParser<FastErrorHandler> parser(boundaries[i], chunk_end, chunk_collector, chunk_error_handler);
+                    results[i] = parser.ParseStatements();
+                });
+            if (std::all_of(results.begin(), results.end(), [](char result) { return result; }))
+            {
+                for (auto& chunk : chunks)
+                {
+                    appendStatements(gnet, std::move(chunk));
+                }
+                return gnet;
+            }
+        }
+    }
+    // either the input is erroneous or a statement continued on a line starting with a keyword,
+    // parsing sequentially handles both cases
+    gnet = AST::G_Network();
+    NetworkCollector collector(filter, gnet);
+    if (ParseFromMemory(begin, end, collector, error_message))
+    {
+        return gnet;
+    }
+    return std::nullopt;
+}
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <vector>
+#include <optional>
 
 #include <boost/variant.hpp>
 #include <boost/optional.hpp>
@@ -311,6 +312,77 @@ namespace dbcppp
                 std::vector<G_SignalMultiplexerValue> signal_multiplexer_values;
             };
         }
+        // Tries a fast parse without position annotation first and only if that fails
+        // parses again with annotation to produce a meaningful error message.
         std::optional<AST::G_Network> DBCPPP_API ParseFromMemory(const char* begin, const char* end, std::string &error_message);
+        // Always parses with position annotation and error reporting.
+        std::optional<AST::G_Network> DBCPPP_API ParseFromMemoryAnnotated(const char* begin, const char* end, std::string &error_message);
+
+        // Receives the statements of a DBC in the order they appear in the input while it is parsed,
+        // so no complete AST::G_Network has to be kept in memory.
+        class ParserHandler
+        {
+        public:
+            enum class EStatement
+            {
+                ValueTable,
+                Message,
+                MessageTransmitter,
+                EnvironmentVariable,
+                EnvironmentVariableData,
+                SignalType,
+                Comment,
+                AttributeDefinition,
+                AttributeDefault,
+                AttributeValue,
+                ValueDescription,
+                SignalGroup,
+                SignalExtendedValueType,
+                SignalMultiplexerValue
+            };
+
+            virtual ~ParserHandler() = default;
+
+            // Statements the handler doesn't want are skipped without being parsed.
+            // The header (VERSION, NS_, BS_, BU_) is always parsed.
+            virtual bool Wants(EStatement) const { return true; }
+
+            virtual void OnVersion(std::string&&) {}
+            virtual void OnNewSymbols(std::vector<std::string>&&) {}
+            virtual void OnBitTiming(AST::G_BitTiming&&) {}
+            virtual void OnNode(AST::G_Node&&) {}
+            virtual void OnValueTable(AST::G_ValueTable&&) {}
+            // OnMessage is followed by one OnSignal per signal of the message and OnMessageEnd,
+            // the signals member of the passed message is always empty
+            virtual void OnMessage(AST::G_Message&&) {}
+            virtual void OnSignal(AST::G_Signal&&) {}
+            virtual void OnMessageEnd() {}
+            virtual void OnMessageTransmitter(AST::G_MessageTransmitter&&) {}
+            virtual void OnEnvironmentVariable(AST::G_EnvironmentVariable&&) {}
+            virtual void OnEnvironmentVariableData(AST::G_EnvironmentVariableData&&) {}
+            virtual void OnSignalType(AST::G_SignalType&&) {}
+            virtual void OnComment(AST::G_Comment&&) {}
+            virtual void OnAttributeDefinition(AST::G_AttributeDefinition&&) {}
+            virtual void OnAttributeDefault(AST::G_Attribute&&) {}
+            virtual void OnAttributeValue(AST::variant_attribute_t&&) {}
+            virtual void OnValueDescription(AST::G_ValueDescriptionSigEnvVar&&) {}
+            virtual void OnSignalGroup(AST::G_SignalGroup&&) {}
+            virtual void OnSignalExtendedValueType(AST::G_SignalExtendedValueType&&) {}
+            virtual void OnSignalMultiplexerValue(AST::G_SignalMultiplexerValue&&) {}
+        };
+        // Streaming variant of ParseFromMemory which reports every statement to the handler as soon as it is parsed.
+        // Like ParseFromMemory it parses without annotation first, so the handler may already have received
+        // the statements up to the erroneous one when false is returned.
+        // Unlike the AST variant the statements following the node list (BU_) may appear in any order.
+        bool DBCPPP_API ParseFromMemory(const char* begin, const char* end, ParserHandler& handler, std::string& error_message);
+        // Splits the statements following the header into chunks of at least chunk_size bytes at lines starting
+        // with a top level keyword and parses the chunks on up to threads threads (0 = hardware concurrency).
+        // The statements of the chunks are concatenated in input order, so the result equals the one of the
+        // sequential parse. Statements filter doesn't want are skipped. If a chunk doesn't parse, the input
+        // is parsed again sequentially, which also produces the error message.
+        std::optional<AST::G_Network> DBCPPP_API ParseFromMemoryParallel(
+              const char* begin, const char* end
+            , std::size_t threads, std::size_t chunk_size
+            , const ParserHandler& filter, std::string& error_message);
     }
 }
\ No newline at end of file
@@ -0,0 +1,237 @@
+#include <array>
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "dbcppp/DecodeStats.h"
+#include "Multiplexer.h"
+#include "MuxConditions.h"
+
+using namespace dbcppp;
+
+namespace
+{
+    enum ECounter
+    {
+        Frames,
+        SignalsOutOfRange,
+        UnmatchedMux,
+        CountersPerMessage
+    };
+    struct MessageInfo
+    {
+        // signals with a range
+        std::vector<std::size_t> checked_signals;
+        std::vector<MuxSwitch> switches;
+        MuxConditions conditions;
+    };
+
+    // the serials aren't reused, so the cache of a thread never matches stats which replaced destroyed ones
+    std::atomic<uint64_t> next_serial{1};
+    // a few slots so that a thread which records into several stats alternately doesn't take the mutex every time
+    struct ThreadCache
+    {
+        struct Slot
+        {
+            uint64_t serial = 0;
+            void* block = nullptr;
+        };
+        std::array<Slot, 4> slots;
+        // the slot which is replaced next
+        std::size_t next = 0;
+    };
+    thread_local ThreadCache thread_cache;
+
+    MessageInfo make_message_info(const IMessage& msg)
+    {
+        MessageInfo info{{}, mux_switches(msg), MuxConditions(msg)};
+        for (std::size_t i = 0; i < msg.Signals_Size(); i++)
+        {
+            if (msg.Signals_Get(i).Minimum() < msg.Signals_Get(i).Maximum())
+            {
+                info.checked_signals.push_back(i);
+            }
+        }
+        return info;
+    }
+    bool unmatched_mux(const MessageInfo& info, const void* data)
+    {
+        for (const auto& sw : info.switches)
+        {
+            if (!info.conditions.Present(sw.index, data))
+            {
+                continue;
+            }
+            uint64_t raw = sw.signal->Decode(data);
+            bool matched = false;
+            for (const auto& range : sw.values)
+            {
+                matched |= raw >= range.from && raw <= range.to;
+            }
+            if (!matched)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+struct DecodeStats::Block
+{
+    explicit Block(std::size_t messages)
+        // the last counter counts the unknown ids
+        : counters(new std::atomic<uint64_t>[messages * CountersPerMessage + 1]())
+    {}
+    // only the owning thread writes, so a relaxed load and store is enough and cheaper than fetch_add
+    void Add(std::size_t i, uint64_t n)
+    {
+        counters[i].store(counters[i].load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    std::unique_ptr<std::atomic<uint64_t>[]> counters;
+};
+class DecodeStats::Impl
+{
+public:
+    Impl(const INetwork& net)
+        : net(net)
+        , serial(next_serial.fetch_add(1))
+    {
+        infos.reserve(net.Messages_Size());
+        for (std::size_t i = 0; i < net.Messages_Size(); i++)
+        {
+            const IMessage& msg = net.Messages_Get(i);
+            index_by_id.emplace(msg.Id(), i);
+            index_by_message.emplace(&msg, i);
+            infos.push_back(make_message_info(msg));
+        }
+    }
+    void Record(Block& block, std::size_t index, uint64_t out_of_range, bool unmatched) const
+    {
+        block.Add(index * CountersPerMessage + Frames, 1);
+        if (out_of_range)
+        {
+            block.Add(index * CountersPerMessage + SignalsOutOfRange, out_of_range);
+        }
+        if (unmatched)
+        {
+            block.Add(index * CountersPerMessage + UnmatchedMux, 1);
+        }
+    }
+
+    const INetwork& net;
+    const uint64_t serial;
+    std::unordered_map<uint64_t, std::size_t> index_by_id;
+    std::unordered_map<const IMessage*, std::size_t> index_by_message;
+    std::vector<MessageInfo> infos;
+
+    mutable std::mutex mutex;
+    // a thread which reuses the id of a finished thread continues its block
+    std::unordered_map<std::thread::id, std::unique_ptr<Block>> blocks;
+};
+
+DecodeStats::DecodeStats(const INetwork& net, bool enabled)
+    : _enabled(enabled)
+    , _impl(std::make_unique<Impl>(net))
+{}
+DecodeStats::~DecodeStats() = default;
+const INetwork& DecodeStats::Network() const
+{
+    return _impl->net;
+}
+DecodeStats::Block& DecodeStats::block()
+{
+    for (const auto& slot : thread_cache.slots)
+    {
+        if (slot.serial == _impl->serial)
+        {
+            return *static_cast<Block*>(slot.block);
+        }
+    }
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+    auto& block = _impl->blocks[std::this_thread::get_id()];
+    if (!block)
+    {
+        block = std::make_unique<Block>(_impl->infos.size());
+    }
+    auto& slot = thread_cache.slots[thread_cache.next];
+    thread_cache.next = (thread_cache.next + 1) % thread_cache.slots.size();
+    slot.serial = _impl->serial;
+    slot.block = block.get();
+    return *block;
+}
+void DecodeStats::recordFrame(uint64_t id, const void* data)
+{
+    auto iter = _impl->index_by_id.find(id);
+    if (iter == _impl->index_by_id.end())
+    {
+        recordUnknownId(id);
+        return;
+    }
+    std::size_t index = iter->second;
+    const IMessage& msg = _impl->net.Messages_Get(index);
+    const MessageInfo& info = _impl->infos[index];
+    uint64_t out_of_range = 0;
+    for (auto i : info.checked_signals)
+    {
+        const ISignal& sig = msg.Signals_Get(i);
+        if (info.conditions.Present(i, data))
+        {
+            double phys = sig.RawToPhys(sig.Decode(data));
+            out_of_range += phys < sig.Minimum() || phys > sig.Maximum();
+        }
+    }
+    _impl->Record(block(), index, out_of_range, unmatched_mux(info, data));
+}
+void DecodeStats::recordDecoded(const IMessage& msg, const void* data, const double* values, std::size_t count)
+{
+    auto iter = _impl->index_by_message.find(&msg);
+    if (iter == _impl->index_by_message.end())
+    {
+        return;
+    }
+    std::size_t index = iter->second;
+    const MessageInfo& info = _impl->infos[index];
+    uint64_t out_of_range = 0;
+    for (auto i : info.checked_signals)
+    {
+        if (i < count && !std::isnan(values[i]))
+        {
+            const ISignal& sig = msg.Signals_Get(i);
+            out_of_range += values[i] < sig.Minimum() || values[i] > sig.Maximum();
+        }
+    }
+    _impl->Record(block(), index, out_of_range, unmatched_mux(info, data));
+}
+void DecodeStats::recordUnknownId(uint64_t)
+{
+    block().Add(_impl->infos.size() * CountersPerMessage, 1);
+}
+DecodeStatsSnapshot DecodeStats::Snapshot() const
+{
+    DecodeStatsSnapshot result;
+    std::size_t messages = _impl->infos.size();
+    result.messages.resize(messages);
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+    for (const auto& entry : _impl->blocks)
+    {
+        const auto& counters = entry.second->counters;
+        for (std::size_t i = 0; i < messages; i++)
+        {
+            auto& stats = result.messages[i];
+            stats.frames += counters[i * CountersPerMessage + Frames].load(std::memory_order_relaxed);
+            stats.signals_out_of_range += counters[i * CountersPerMessage + SignalsOutOfRange].load(std::memory_order_relaxed);
+            stats.unmatched_mux += counters[i * CountersPerMessage + UnmatchedMux].load(std::memory_order_relaxed);
+        }
+        result.unknown_ids += counters[messages * CountersPerMessage].load(std::memory_order_relaxed);
+    }
+    for (const auto& stats : result.messages)
+    {
+        result.total.frames += stats.frames;
+        result.total.signals_out_of_range += stats.signals_out_of_range;
+        result.total.unmatched_mux += stats.unmatched_mux;
+    }
+    return result;
+}
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include "EnvironmentVariableImpl.h"
+#include "MemoryCounter.h"
 
 using namespace dbcppp;
 
@@ -149,12 +150,33 @@ const std::string& EnvironmentVariableImpl::Comment() const
 {
     return _comment;
 }
+IEnvironmentVariable::EVarType& EnvironmentVariableImpl::varType()
+{
+    return _var_type;
+}
+std::vector<ValueEncodingDescriptionImpl>& EnvironmentVariableImpl::valueEncodingDescriptions()
+{
+    return _value_encoding_descriptions;
+}
+uint64_t& EnvironmentVariableImpl::dataSize()
+{
+    return _data_size;
+}
+std::vector<AttributeImpl>& EnvironmentVariableImpl::attributeValues()
+{
+    return _attribute_values;
+}
+std::string& EnvironmentVariableImpl::comment()
+{
+    return _comment;
+}
 bool EnvironmentVariableImpl::operator==(const IEnvironmentVariable& rhs) const
 {
     bool result = true;
     result &= _name == rhs.Name();
     result &= _var_type == rhs.VarType();
     result &= _minimum == rhs.Minimum();
+    result &= _maximum == rhs.Maximum();
     result &= _unit == rhs.Unit();
     result &= _initial_value == rhs.InitialValue();
     result &= _ev_id == rhs.EvId();
@@ -184,4 +206,15 @@ bool EnvironmentVariableImpl::operator==(const IEnvironmentVariable& rhs) const
 bool EnvironmentVariableImpl::operator!=(const IEnvironmentVariable& rhs) const
 {
     return !(*this == rhs);
-}
\ No newline at end of file
+}
+void EnvironmentVariableImpl::CountMemory(MemoryCounter& counter) const
+{
+    using EEntity = MemoryCounter::EEntity;
+    using ECategory = MemoryCounter::ECategory;
+    counter.Add(EEntity::EnvironmentVariables, ECategory::Names, _name);
+    counter.Add(EEntity::EnvironmentVariables, ECategory::Other, _unit);
+    counter.Add(EEntity::EnvironmentVariables, ECategory::Names, _access_nodes);
+    counter.Add(EEntity::EnvironmentVariables, ECategory::Comments, _comment);
+    counter.Objects(EEntity::ValueEncodingDescriptions, _value_encoding_descriptions);
+    counter.Objects(EEntity::Attributes, _attribute_values);
+}
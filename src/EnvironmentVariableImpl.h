@@ -7,6 +7,8 @@
 
 namespace dbcppp
 {
+    class MemoryCounter;
+
     class EnvironmentVariableImpl final
         : public IEnvironmentVariable
     {
@@ -45,9 +47,17 @@ namespace dbcppp
         virtual uint64_t AttributeValues_Size() const override;
         virtual const std::string& Comment() const override;
         
+        EVarType& varType();
+        std::vector<ValueEncodingDescriptionImpl>& valueEncodingDescriptions();
+        uint64_t& dataSize();
+        std::vector<AttributeImpl>& attributeValues();
+        std::string& comment();
+        
         virtual bool operator==(const IEnvironmentVariable& rhs) const override;
         virtual bool operator!=(const IEnvironmentVariable& rhs) const override;
 
+        void CountMemory(MemoryCounter& counter) const;
+
     private:
         std::string _name;
         EVarType _var_type;
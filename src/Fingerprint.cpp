@@ -0,0 +1,200 @@
+#include <cstring>
+#include "Fingerprint.h"
+#include "dbcppp/SignalGroup.h"
+
+using namespace dbcppp;
+
+namespace
+{
+    // finalizer of splitmix64
+    uint64_t mix(uint64_t x)
+    {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111eb;
+        x ^= x >> 31;
+        return x;
+    }
+}
+
+void Hasher::Add(uint64_t value)
+{
+    _low = mix(_low ^ value);
+    _high = mix(_high + ((value << 32) | (value >> 32)) + 0x9e3779b97f4a7c15);
+}
+void Hasher::Add(int64_t value)
+{
+    Add(static_cast<uint64_t>(value));
+}
+void Hasher::Add(double value)
+{
+    // -0.0 == 0.0
+    if (value == 0.)
+    {
+        value = 0.;
+    }
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    Add(bits);
+}
+void Hasher::Add(const std::string& value)
+{
+    Add(static_cast<uint64_t>(value.size()));
+    for (std::size_t i = 0; i < value.size(); i += 8)
+    {
+        // assembled bytewise, so the result doesn't depend on the endianness
+        uint64_t word = 0;
+        for (std::size_t j = i; j < value.size() && j < i + 8; j++)
+        {
+            word |= uint64_t(static_cast<unsigned char>(value[j])) << ((j - i) * 8);
+        }
+        Add(word);
+    }
+}
+void Hasher::Add(const Hash128& value)
+{
+    Add(value.low);
+    Add(value.high);
+}
+Hash128 Hasher::Finish() const
+{
+    return {_low, _high};
+}
+
+Hash128 dbcppp::fingerprint(const std::string& str)
+{
+    Hasher hasher;
+    hasher.Add(str);
+    return hasher.Finish();
+}
+Hash128 dbcppp::fingerprint(const IAttribute& attribute)
+{
+    Hasher hasher;
+    hasher.Add(attribute.Name());
+    hasher.Add(static_cast<uint64_t>(attribute.ObjectType()));
+    const auto& value = attribute.Value();
+    hasher.Add(static_cast<uint64_t>(value.index()));
+    std::visit([&](const auto& v) { hasher.Add(v); }, value);
+    return hasher.Finish();
+}
+Hash128 dbcppp::fingerprint(const IAttributeDefinition& attribute_definition)
+{
+    Hasher hasher;
+    hasher.Add(attribute_definition.Name());
+    hasher.Add(static_cast<uint64_t>(attribute_definition.ObjectType()));
+    const auto& value_type = attribute_definition.ValueType();
+    hasher.Add(static_cast<uint64_t>(value_type.index()));
+    if (auto vt = std::get_if<IAttributeDefinition::ValueTypeInt>(&value_type))
+    {
+        hasher.Add(vt->minimum);
+        hasher.Add(vt->maximum);
+    }
+    else if (auto vt = std::get_if<IAttributeDefinition::ValueTypeHex>(&value_type))
+    {
+        hasher.Add(vt->minimum);
+        hasher.Add(vt->maximum);
+    }
+    else if (auto vt = std::get_if<IAttributeDefinition::ValueTypeFloat>(&value_type))
+    {
+        hasher.Add(vt->minimum);
+        hasher.Add(vt->maximum);
+    }
+    else if (auto vt = std::get_if<IAttributeDefinition::ValueTypeEnum>(&value_type))
+    {
+        hasher.AddUnordered(vt->values);
+    }
+    return hasher.Finish();
+}
+Hash128 dbcppp::fingerprint(const IBitTiming& bit_timing)
+{
+    Hasher hasher;
+    hasher.Add(bit_timing.Baudrate());
+    hasher.Add(bit_timing.BTR1());
+    hasher.Add(bit_timing.BTR2());
+    return hasher.Finish();
+}
+Hash128 dbcppp::fingerprint(const IEnvironmentVariable& environment_variable)
+{
+    Hasher hasher;
+    hasher.Add(environment_variable.Name());
+    hasher.Add(static_cast<uint64_t>(environment_variable.VarType()));
+    hasher.Add(environment_variable.Minimum());
+    hasher.Add(environment_variable.Maximum());
+    hasher.Add(environment_variable.Unit());
+    hasher.Add(environment_variable.InitialValue());
+    hasher.Add(environment_variable.EvId());
+    hasher.Add(static_cast<uint64_t>(environment_variable.AccessType()));
+    hasher.AddUnordered(environment_variable.AccessNodes());
+    hasher.AddUnordered(environment_variable.ValueEncodingDescriptions());
+    hasher.Add(environment_variable.DataSize());
+    hasher.AddUnordered(environment_variable.AttributeValues());
+    hasher.Add(environment_variable.Comment());
+    return hasher.Finish();
+}
+Hash128 dbcppp::fingerprint(const INode& node)
+{
+    Hasher hasher;
+    hasher.Add(node.Name());
+    hasher.Add(node.Comment());
+    hasher.AddUnordered(node.AttributeValues());
+    return hasher.Finish();
+}
+Hash128 dbcppp::fingerprint(const ISignalGroup& signal_group)
+{
+    Hasher hasher;
+    hasher.Add(signal_group.MessageId());
+    hasher.Add(signal_group.Name());
+    hasher.Add(signal_group.Repetitions());
+    hasher.AddUnordered(signal_group.SignalNames());
+    return hasher.Finish();
+}
+Hash128 dbcppp::fingerprint(const ISignalMultiplexerValue& signal_multiplexer_value)
+{
+    Hasher hasher;
+    hasher.Add(signal_multiplexer_value.SwitchName());
+    hasher.AddUnordered(signal_multiplexer_value.ValueRanges());
+    return hasher.Finish();
+}
+Hash128 dbcppp::fingerprint(const ISignalMultiplexerValue::Range& range)
+{
+    Hasher hasher;
+    hasher.Add(static_cast<uint64_t>(range.from));
+    hasher.Add(static_cast<uint64_t>(range.to));
+    return hasher.Finish();
+}
+Hash128 dbcppp::fingerprint(const ISignalType& signal_type)
+{
+    Hasher hasher;
+    hasher.Add(signal_type.Name());
+    hasher.Add(signal_type.SignalSize());
+    hasher.Add(static_cast<uint64_t>(signal_type.ValueType()));
+    hasher.Add(signal_type.Factor());
+    hasher.Add(signal_type.Offset());
+    hasher.Add(signal_type.Minimum());
+    hasher.Add(signal_type.Maximum());
+    hasher.Add(signal_type.Unit());
+    hasher.Add(signal_type.DefaultValue());
+    hasher.Add(signal_type.ValueTable());
+    return hasher.Finish();
+}
+Hash128 dbcppp::fingerprint(const IValueEncodingDescription& value_encoding_description)
+{
+    Hasher hasher;
+    hasher.Add(value_encoding_description.Value());
+    hasher.Add(value_encoding_description.Description());
+    return hasher.Finish();
+}
+Hash128 dbcppp::fingerprint(const IValueTable& value_table)
+{
+    Hasher hasher;
+    hasher.Add(value_table.Name());
+    auto signal_type = value_table.SignalType();
+    hasher.Add(static_cast<uint64_t>(signal_type.has_value()));
+    if (signal_type)
+    {
+        hasher.Add(fingerprint(signal_type->get()));
+    }
+    hasher.AddUnordered(value_table.ValueEncodingDescriptions());
+    return hasher.Finish();
+}
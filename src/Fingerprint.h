@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include "dbcppp/Hash128.h"
+#include "dbcppp/Network.h"
+
+namespace dbcppp
+{
+    // Structural hashes over the same properties the operator== of the objects compare.
+    // Signals, messages and networks cache theirs and provide them through Fingerprint().
+    Hash128 fingerprint(const std::string& str);
+    Hash128 fingerprint(const IAttribute& attribute);
+    Hash128 fingerprint(const IAttributeDefinition& attribute_definition);
+    Hash128 fingerprint(const IBitTiming& bit_timing);
+    Hash128 fingerprint(const IEnvironmentVariable& environment_variable);
+    Hash128 fingerprint(const INode& node);
+    Hash128 fingerprint(const ISignalGroup& signal_group);
+    Hash128 fingerprint(const ISignalMultiplexerValue& signal_multiplexer_value);
+    Hash128 fingerprint(const ISignalMultiplexerValue::Range& range);
+    Hash128 fingerprint(const ISignalType& signal_type);
+    Hash128 fingerprint(const IValueEncodingDescription& value_encoding_description);
+    Hash128 fingerprint(const IValueTable& value_table);
+    inline Hash128 fingerprint(const ISignal& signal) { return signal.Fingerprint(); }
+    inline Hash128 fingerprint(const IMessage& message) { return message.Fingerprint(); }
+
+    // Stable (independent of platform and run) 128 bit hash, not meant to be cryptographically secure.
+    class Hasher
+    {
+    public:
+        void Add(uint64_t value);
+        void Add(int64_t value);
+        void Add(double value);
+        void Add(const std::string& value);
+        void Add(const Hash128& value);
+        // The fingerprints of the elements are summed up, so the order of the elements doesn't matter,
+        // just like for the operator== of the objects, which searches every element in the other object.
+        template <class Range>
+        void AddUnordered(Range&& range)
+        {
+            Hash128 sum;
+            uint64_t count = 0;
+            for (const auto& item : range)
+            {
+                auto hash = fingerprint(item);
+                sum.low += hash.low;
+                sum.high += hash.high;
+                count++;
+            }
+            Add(count);
+            Add(sum);
+        }
+        Hash128 Finish() const;
+
+    private:
+        uint64_t _low = 0x243f6a8885a308d3;
+        uint64_t _high = 0x13198a2e03707344;
+    };
+
+    // Fingerprint which is computed on first use. Computing it concurrently from several threads is fine,
+    // the objects have to reset it in every non-const accessor.
+    class FingerprintCache
+    {
+    public:
+        FingerprintCache() = default;
+        FingerprintCache(const FingerprintCache& other)
+        {
+            *this = other;
+        }
+        FingerprintCache& operator=(const FingerprintCache& other)
+        {
+            _low.store(other._low.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            _high.store(other._high.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            _valid.store(other._valid.load(std::memory_order_acquire), std::memory_order_release);
+            return *this;
+        }
+
+        template <class Func>
+        Hash128 Get(Func&& compute) const
+        {
+            if (_valid.load(std::memory_order_acquire))
+            {
+                return {_low.load(std::memory_order_relaxed), _high.load(std::memory_order_relaxed)};
+            }
+            Hash128 hash = compute();
+            _low.store(hash.low, std::memory_order_relaxed);
+            _high.store(hash.high, std::memory_order_relaxed);
+            _valid.store(true, std::memory_order_release);
+            return hash;
+        }
+        void Reset()
+        {
+            _valid.store(false, std::memory_order_relaxed);
+        }
+
+    private:
+        mutable std::atomic<bool> _valid{false};
+        mutable std::atomic<uint64_t> _low{0};
+        mutable std::atomic<uint64_t> _high{0};
+    };
+}
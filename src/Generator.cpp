@@ -0,0 +1,390 @@
+#include <random>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+
+#include "dbcppp/Generator.h"
+#include "Multiplexer.h"
+
+using namespace dbcppp;
+using namespace dbcppp::Generator;
+
+namespace
+{
+    // std::mt19937_64 is specified exactly, the distributions of the standard library aren't,
+    // so the draws are done by hand to get the same output with every standard library
+    using rng_t = std::mt19937_64;
+    uint64_t draw(rng_t& rng, uint64_t n)
+    {
+        return n ? rng() % n : 0;
+    }
+    template <class T, std::size_t N>
+    const T& pick(rng_t& rng, const T (&values)[N])
+    {
+        return values[draw(rng, N)];
+    }
+
+    struct GenSignal
+    {
+        std::string name;
+        uint64_t start_bit;
+        uint64_t bit_size;
+        bool is_signed;
+        // 0: integer, 1: float, 2: double like SIG_VALTYPE_
+        int value_type;
+        // "", "M", "m<value>" or "m<value>M"
+        std::string multiplexer;
+        // for SG_MUL_VAL_, empty if the signal isn't described there
+        std::string switch_name;
+        uint64_t switch_value;
+        double factor;
+        double offset;
+        double minimum;
+        double maximum;
+        std::string unit;
+        uint64_t start_value;
+    };
+    struct GenMessage
+    {
+        uint64_t id;
+        std::string name;
+        uint64_t size;
+        std::size_t transmitter;
+        std::size_t receiver;
+        uint64_t cycle_time;
+        bool big_endian;
+        std::vector<GenSignal> signals;
+    };
+
+    std::vector<GenMessage> generate_messages(const DBCOptions& options)
+    {
+        static const double factors[] = {1., 1., 0.1, 0.5, 0.01, 0.25};
+        static const double offsets[] = {0., 0., -40., 100., -1000.};
+        static const char* units[] = {"", "km/h", "rpm", "degC", "V", "A", "%"};
+        static const uint64_t cycle_times[] = {10, 20, 50, 100, 100, 200, 500, 1000};
+
+        rng_t rng(options.seed);
+        std::size_t nodes = std::max<std::size_t>(options.nodes, 1);
+        uint64_t mux_values = std::min<uint64_t>(std::max<uint64_t>(options.mux_values, 1), 256);
+        bool extended_ids = options.extended_ids || options.messages > 0x700;
+        std::vector<GenMessage> messages;
+        messages.reserve(options.messages);
+        for (std::size_t m = 0; m < options.messages; m++)
+        {
+            GenMessage msg;
+            msg.id = extended_ids ? 0x80000000 | (0x18000000 + m) : 0x100 + m;
+            msg.name = "MSG_" + std::to_string(m);
+            msg.size = options.can_fd ? 64 : 8;
+            msg.transmitter = m % nodes;
+            msg.receiver = (m + 1) % nodes;
+            msg.cycle_time = pick(rng, cycle_times);
+            msg.big_endian = draw(rng, 2);
+            uint64_t total_bits = msg.size * 8;
+            uint64_t pos = 0;
+
+            std::size_t signals = std::min<std::size_t>(options.signals_per_message, total_bits);
+            std::size_t depth = std::min<std::size_t>(options.mux_depth, std::min<std::size_t>(signals, total_bits / 8));
+            bool extended_mux = depth > 1 || (depth == 1 && options.extended_mux);
+            auto add_signal =
+                [&](GenSignal&& sig)
+                {
+                    // big endian signals are laid out from the msb of byte 0 on, their start bit is the msb
+                    sig.start_bit = msg.big_endian ? pos / 8 * 8 + 7 - pos % 8 : pos;
+                    pos += sig.bit_size;
+                    msg.signals.push_back(std::move(sig));
+                };
+            for (std::size_t k = 0; k < depth; k++)
+            {
+                GenSignal sig{};
+                sig.name = msg.name + "_MUX_" + std::to_string(k);
+                sig.bit_size = 8;
+                sig.multiplexer = k == 0 ? "M" : "m0M";
+                // each switch is only present if the switch above it is 0
+                sig.switch_name = k == 0 ? "" : msg.signals.back().name;
+                sig.factor = 1.;
+                sig.maximum = double(mux_values - 1);
+                add_signal(std::move(sig));
+            }
+            std::size_t data_signals = signals - depth;
+            for (std::size_t j = 0; j < data_signals; j++)
+            {
+                GenSignal sig{};
+                sig.name = "SIG_" + std::to_string(m) + "_" + std::to_string(j);
+                // leave at least one bit for each of the remaining signals
+                uint64_t available = total_bits - pos - (data_signals - j - 1);
+                if (options.float_signals && j % 4 == 2 && available >= 32)
+                {
+                    sig.bit_size = 32;
+                    sig.value_type = 1;
+                }
+                else if (options.double_signals && j % 4 == 3 && available >= 64)
+                {
+                    sig.bit_size = 64;
+                    sig.value_type = 2;
+                }
+                else
+                {
+                    uint64_t width = (total_bits - pos) / (data_signals - j);
+                    sig.bit_size = 1 + draw(rng, std::min<uint64_t>(width, 32));
+                }
+                sig.is_signed = sig.value_type != 0 || (sig.bit_size > 1 && draw(rng, 3) == 0);
+                if (sig.value_type == 0)
+                {
+                    sig.factor = pick(rng, factors);
+                    sig.offset = pick(rng, offsets);
+                    double raw_min = sig.is_signed ? -double(1ull << (sig.bit_size - 1)) : 0.;
+                    double raw_max = sig.is_signed ? double(1ull << (sig.bit_size - 1)) - 1. : double((1ull << (sig.bit_size - 1)) - 1) * 2. + 1.;
+                    sig.minimum = sig.offset + sig.factor * raw_min;
+                    sig.maximum = sig.offset + sig.factor * raw_max;
+                }
+                else
+                {
+                    sig.factor = 1.;
+                }
+                sig.unit = pick(rng, units);
+                sig.start_value = draw(rng, 3) == 0 ? draw(rng, 100) : 0;
+                // the first signal is always present
+                if (depth && j)
+                {
+                    std::size_t level = j % depth;
+                    sig.switch_value = (j / depth) % mux_values;
+                    sig.multiplexer = "m" + std::to_string(sig.switch_value);
+                    sig.switch_name = msg.signals[level].name;
+                }
+                add_signal(std::move(sig));
+            }
+            // plain multiplexing doesn't need SG_MUL_VAL_
+            if (!extended_mux)
+            {
+                for (auto& sig : msg.signals)
+                {
+                    sig.switch_name.clear();
+                }
+            }
+            messages.push_back(std::move(msg));
+        }
+        return messages;
+    }
+    std::string number(double value)
+    {
+        std::ostringstream ss;
+        ss.imbue(std::locale::classic());
+        ss << std::setprecision(17) << value;
+        return ss.str();
+    }
+}
+
+void Generator::GenerateDBC(std::ostream& os, const DBCOptions& options)
+{
+    auto messages = generate_messages(options);
+    std::size_t nodes = std::max<std::size_t>(options.nodes, 1);
+    auto node_name = [](std::size_t n) { return "ECU_" + std::to_string(n); };
+
+    os << "VERSION \"synthetic\"\n\n";
+    os << "NS_ :\n\tCM_\n\tBA_DEF_\n\tBA_\n\tVAL_\n\tBA_DEF_DEF_\n\tSIG_VALTYPE_\n\tSG_MUL_VAL_\n\n";
+    os << "BS_:\n\n";
+    os << "BU_:";
+    for (std::size_t n = 0; n < nodes; n++)
+    {
+        os << " " << node_name(n);
+    }
+    os << "\n\n";
+    for (const auto& msg : messages)
+    {
+        os << "BO_ " << msg.id << " " << msg.name << ": " << msg.size << " " << node_name(msg.transmitter) << "\n";
+        for (const auto& sig : msg.signals)
+        {
+            os << " SG_ " << sig.name << " " << sig.multiplexer << (sig.multiplexer.empty() ? "" : " ")
+                << ": " << sig.start_bit << "|" << sig.bit_size << "@" << (msg.big_endian ? "0" : "1") << (sig.is_signed ? "-" : "+")
+                << " (" << number(sig.factor) << "," << number(sig.offset) << ")"
+                << " [" << number(sig.minimum) << "|" << number(sig.maximum) << "]"
+                << " \"" << sig.unit << "\" " << node_name(msg.receiver) << "\n";
+        }
+        os << "\n";
+    }
+    if (options.comments)
+    {
+        os << "CM_ \"Synthetic network, seed " << options.seed << "\";\n";
+        for (std::size_t n = 0; n < nodes; n++)
+        {
+            os << "CM_ BU_ " << node_name(n) << " \"Synthetic node " << n << "\";\n";
+        }
+        for (const auto& msg : messages)
+        {
+            os << "CM_ BO_ " << msg.id << " \"Synthetic message " << msg.name << "\";\n";
+            for (const auto& sig : msg.signals)
+            {
+                os << "CM_ SG_ " << msg.id << " " << sig.name << " \"Synthetic signal " << sig.name << "\";\n";
+            }
+        }
+        os << "\n";
+    }
+    if (options.attributes)
+    {
+        os << "BA_DEF_ \"BusType\" STRING ;\n";
+        os << "BA_DEF_ BU_ \"NodeLayerModules\" STRING ;\n";
+        os << "BA_DEF_ BO_ \"GenMsgCycleTime\" INT 0 10000;\n";
+        os << "BA_DEF_ BO_ \"GenMsgSendType\" ENUM \"Cyclic\",\"OnEvent\";\n";
+        os << "BA_DEF_ SG_ \"GenSigStartValue\" INT 0 100000;\n";
+        os << "BA_DEF_DEF_ \"BusType\" \"CAN\";\n";
+        os << "BA_DEF_DEF_ \"NodeLayerModules\" \"\";\n";
+        os << "BA_DEF_DEF_ \"GenMsgCycleTime\" 100;\n";
+        os << "BA_DEF_DEF_ \"GenMsgSendType\" \"Cyclic\";\n";
+        os << "BA_DEF_DEF_ \"GenSigStartValue\" 0;\n";
+        os << "BA_ \"BusType\" \"" << (options.can_fd ? "CAN FD" : "CAN") << "\";\n";
+        for (std::size_t n = 0; n < nodes; n++)
+        {
+            os << "BA_ \"NodeLayerModules\" BU_ " << node_name(n) << " \"CANoeILNVector.dll\";\n";
+        }
+        for (const auto& msg : messages)
+        {
+            os << "BA_ \"GenMsgCycleTime\" BO_ " << msg.id << " " << msg.cycle_time << ";\n";
+            if (msg.cycle_time >= 500)
+            {
+                os << "BA_ \"GenMsgSendType\" BO_ " << msg.id << " 1;\n";
+            }
+            for (const auto& sig : msg.signals)
+            {
+                if (sig.start_value)
+                {
+                    os << "BA_ \"GenSigStartValue\" SG_ " << msg.id << " " << sig.name << " " << sig.start_value << ";\n";
+                }
+            }
+        }
+        os << "\n";
+    }
+    if (options.value_descriptions)
+    {
+        for (const auto& msg : messages)
+        {
+            for (const auto& sig : msg.signals)
+            {
+                if (!sig.multiplexer.empty() && sig.multiplexer.back() == 'M')
+                {
+                    os << "VAL_ " << msg.id << " " << sig.name;
+                    for (uint64_t v = 0; v <= uint64_t(sig.maximum); v++)
+                    {
+                        os << " " << v << " \"Mode_" << v << "\"";
+                    }
+                    os << " ;\n";
+                }
+                else if (sig.bit_size == 1)
+                {
+                    os << "VAL_ " << msg.id << " " << sig.name << " 0 \"Off\" 1 \"On\" ;\n";
+                }
+            }
+        }
+        os << "\n";
+    }
+    for (const auto& msg : messages)
+    {
+        for (const auto& sig : msg.signals)
+        {
+            if (sig.value_type)
+            {
+                os << "SIG_VALTYPE_ " << msg.id << " " << sig.name << " : " << sig.value_type << ";\n";
+            }
+        }
+    }
+    for (const auto& msg : messages)
+    {
+        for (const auto& sig : msg.signals)
+        {
+            if (!sig.switch_name.empty())
+            {
+                os << "SG_MUL_VAL_ " << msg.id << " " << sig.name << " " << sig.switch_name << " "
+                    << sig.switch_value << "-" << sig.switch_value << ";\n";
+            }
+        }
+    }
+}
+std::string Generator::GenerateDBC(const DBCOptions& options)
+{
+    std::ostringstream ss;
+    GenerateDBC(ss, options);
+    return ss.str();
+}
+void Generator::GenerateFrames(const INetwork& net, const FrameOptions& options, const std::function<void(const Frame&)>& on_frame)
+{
+    struct Candidate
+    {
+        const IMessage* message;
+        std::vector<MuxSwitch> switches;
+    };
+    // frames can't be longer than 64 bytes
+    std::vector<Candidate> candidates;
+    for (const IMessage& msg : net.Messages())
+    {
+        if (msg.MessageSize() > 64)
+        {
+            continue;
+        }
+        Candidate candidate{&msg, {}};
+        candidate.switches = mux_switches(msg);
+        candidates.push_back(std::move(candidate));
+    }
+    if (candidates.empty())
+    {
+        return;
+    }
+    rng_t rng(options.seed);
+    for (std::size_t i = 0; i < options.count; i++)
+    {
+        const auto& candidate = candidates[draw(rng, candidates.size())];
+        // the signals write whole 64 bit words
+        std::array<uint8_t, 64 + 16> buffer{};
+        Frame frame;
+        frame.id = uint32_t(candidate.message->Id());
+        frame.size = uint8_t(candidate.message->MessageSize());
+        for (std::size_t b = 0; b < frame.size; b += 8)
+        {
+            uint64_t word = rng();
+            std::memcpy(&buffer[b], &word, 8);
+        }
+        for (const auto& sw : candidate.switches)
+        {
+            const auto& range = sw.values[draw(rng, sw.values.size())];
+            uint64_t span = range.to - range.from + 1;
+            sw.signal->Encode(range.from + draw(rng, span), buffer.data());
+        }
+        std::fill(buffer.begin() + frame.size, buffer.end(), uint8_t(0));
+        std::copy(buffer.begin(), buffer.begin() + frame.data.size(), frame.data.begin());
+        on_frame(frame);
+    }
+}
+void Generator::WriteFrames(std::ostream& os, const INetwork& net, const FrameOptions& options)
+{
+    if (options.format == EFrameFormat::Binary)
+    {
+        GenerateFrames(net, options,
+            [&](const Frame& frame)
+            {
+                char record[72] = {};
+                for (std::size_t i = 0; i < 4; i++)
+                {
+                    record[i] = char(frame.id >> (8 * i));
+                }
+                record[4] = char(frame.size);
+                std::memcpy(record + 8, frame.data.data(), frame.data.size());
+                os.write(record, sizeof(record));
+            });
+        return;
+    }
+    std::ostringstream line;
+    line << std::uppercase << std::hex << std::setfill('0');
+    GenerateFrames(net, options,
+        [&](const Frame& frame)
+        {
+            line.str("");
+            bool extended = frame.id & 0x80000000;
+            line << "  " << options.interface_name << "  " << std::setw(extended ? 8 : 3) << (frame.id & 0x1FFFFFFF)
+                << std::dec << (frame.size > 9 ? "  [" : "   [") << unsigned(frame.size) << "] " << std::hex;
+            for (std::size_t i = 0; i < frame.size; i++)
+            {
+                line << " " << std::setw(2) << unsigned(frame.data[i]);
+            }
+            line << "\n";
+            os << line.str();
+        });
+}
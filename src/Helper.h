@@ -3,6 +3,10 @@
 
 #include <string>
 #include <memory>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <unordered_map>
 
 #include "Export.h"
 
@@ -68,34 +72,103 @@ namespace dbcppp
             v1 = std::move(v2);
         }
     }
-    template<typename T>
-    inline void unique_merge(std::vector<T>& v1, std::vector<T>& v2)
+    struct by_value
+    {
+        template<typename T>
+        const T& operator()(const T& item) const { return item; }
+    };
+    struct by_name
     {
-        for (T& item : v2) {
-            if (std::find(v1.begin(), v1.end(), item) == v1.end()) {
-                v1.push_back(std::move(item));
+        template<typename T>
+        const std::string& operator()(const T& item) const { return item.Name(); }
+    };
+    // Hash index over the elements of a vector by a key, so that merging another vector
+    // into it doesn't need a linear search for every merged element.
+    template<typename T, typename KeyFunc>
+    class merge_index
+    {
+    public:
+        using key_type = std::decay_t<std::invoke_result_t<KeyFunc, const T&>>;
+
+        merge_index(std::vector<T>& v, KeyFunc key = KeyFunc())
+            : _v(v)
+            , _key(std::move(key))
+        {
+            _index.reserve(v.size());
+            for (std::size_t i = 0; i < v.size(); i++) {
+                // first element wins, like a linear search would find it
+                _index.emplace(_key(v[i]), i);
             }
         }
+        // merges item into the element with the same key or appends it if there is none
+        template<typename Merge>
+        void merge(T&& item, Merge&& merge_func)
+        {
+            key_type key = _key(item);
+            auto it = _index.find(key);
+            if (it != _index.end()) {
+                merge_func(_v[it->second], std::move(item));
+            } else {
+                _index.emplace(std::move(key), _v.size());
+                _v.push_back(std::move(item));
+            }
+        }
+        template<typename Merge>
+        void merge(std::vector<T>& items, Merge&& merge_func)
+        {
+            for (T& item : items) {
+                merge(std::move(item), merge_func);
+            }
+        }
+
+    private:
+        std::vector<T>& _v;
+        KeyFunc _key;
+        std::unordered_map<key_type, std::size_t> _index;
+    };
+    // below this number of comparisons searching linearly is cheaper than building the index
+    constexpr std::size_t linear_merge_limit = 64;
+    template<typename T, typename KeyFunc, typename Merge>
+    inline void merge_by_key(std::vector<T>& v1, std::vector<T>& v2, KeyFunc key, Merge&& merge_func)
+    {
+        if (v1.size() * v2.size() <= linear_merge_limit) {
+            for (T& item2 : v2) {
+                auto it = std::find_if(v1.begin(), v1.end(), [&](const T& item1) {
+                    return key(item1) == key(item2);
+                });
+                if (it != v1.end()) {
+                    merge_func(*it, std::move(item2));
+                } else {
+                    v1.push_back(std::move(item2));
+                }
+            }
+        } else {
+            merge_index<T, KeyFunc>(v1, std::move(key)).merge(v2, merge_func);
+        }
+    }
+    template<typename T>
+    inline void keep_existing(T&, T&&)
+    {}
+    template<typename T>
+    inline void replace_existing(T& item1, T&& item2)
+    {
+        // same key replace it
+        item1 = std::move(item2);
+    }
+    template<typename T>
+    inline void unique_merge(std::vector<T>& v1, std::vector<T>& v2)
+    {
+        merge_by_key(v1, v2, by_value(), keep_existing<T>);
     }
     template<typename T, typename R>
     inline void unique_merge_by_attr(std::vector<T>& v1, std::vector<T>& v2, R (T::*func)() const)
     {
-        for (T& item2 : v2) {
-            auto it = std::find_if(v1.begin(), v1.end(), [&item2, func](const T& item1) {
-                return (item1.*func)() == (item2.*func)();
-            });
-            if (it != v1.end()) {
-                // same name replace it
-                *it = std::move(item2);
-            } else {
-                // insert new
-                v1.push_back(std::move(item2));
-            }
-        }
+        auto key = [func](const T& item) -> decltype(auto) { return (item.*func)(); };
+        merge_by_key(v1, v2, key, replace_existing<T>);
     }
     template<typename T>
     inline void unique_merge_by_name(std::vector<T>& v1, std::vector<T>& v2)
     {
-        unique_merge_by_attr(v1, v2, &T::Name);
+        merge_by_key(v1, v2, by_name(), replace_existing<T>);
     }
 }
@@ -0,0 +1,360 @@
+#include <limits>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "dbcppp/IsoTp.h"
+#include "SessionList.h"
+
+using namespace dbcppp;
+using namespace dbcppp::IsoTp;
+
+namespace
+{
+    enum EFrameType : uint8_t
+    {
+        SingleFrame = 0,
+        FirstFrame = 1,
+        ConsecutiveFrame = 2,
+        FlowControl = 3
+    };
+    enum EFlowStatus : uint8_t
+    {
+        ContinueToSend = 0,
+        Wait = 1,
+        Overflow = 2
+    };
+    constexpr std::size_t classic_frame_size = 8;
+    // CAN FD single frames carry up to 62 bytes
+    constexpr std::size_t max_single_frame_size = 62;
+    // the PDUs are decoded in place, which reads whole 64 bit words
+    constexpr std::size_t decode_padding = 8;
+    constexpr uint16_t no_channel = SessionList::none;
+    constexpr uint16_t no_buffer = std::numeric_limits<uint16_t>::max();
+
+    // the channels a frame id belongs to, an id can be the data id of one channel and the flow control id of another
+    struct Route
+    {
+        uint16_t data = no_channel;
+        uint16_t flow_control = no_channel;
+    };
+    struct Session
+    {
+        const IMessage* message;
+        // nullptr while no PDU is in progress
+        uint8_t* buffer = nullptr;
+        std::size_t capacity;
+        uint16_t pooled_buffer = no_buffer;
+        uint32_t size;
+        uint32_t received;
+        // the size of the first frame, the consecutive frames but the last one have the same size
+        std::size_t frame_size;
+        uint8_t next_sequence_number;
+        uint64_t last_us;
+    };
+
+    uint32_t read_u32_be(const uint8_t* data)
+    {
+        return (uint32_t(data[0]) << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+    }
+}
+
+class Reassembler::Impl
+{
+public:
+    Impl(const ReassemblerOptions& options, on_pdu_t&& on_pdu, const INetwork* net)
+        : _channels(options.channels)
+        , _max_size(options.max_size)
+        , _timeout_us(options.timeout_us)
+        , _on_pdu(std::move(on_pdu))
+        , _sessions(options.channels.size())
+        , _sessions_by_age(options.channels.size())
+    {
+        if (_channels.size() > no_channel)
+        {
+            throw std::runtime_error("IsoTp::Reassembler: too many channels");
+        }
+        std::size_t largest_message = 0;
+        for (std::size_t i = 0; i < _channels.size(); i++)
+        {
+            const auto& channel = _channels[i];
+            _sessions[i].message = net ? net->MessageById(channel.id) : nullptr;
+            if (_sessions[i].message)
+            {
+                largest_message = std::max<std::size_t>(largest_message, _sessions[i].message->MessageSize());
+            }
+            // the first channel of an id wins
+            auto& data_route = _routes[channel.id];
+            if (data_route.data == no_channel)
+            {
+                data_route.data = uint16_t(i);
+            }
+            auto& flow_control_route = _routes[channel.flow_control_id];
+            if (flow_control_route.flow_control == no_channel)
+            {
+                flow_control_route.flow_control = uint16_t(i);
+            }
+        }
+        _buffer_size = std::max(_max_size, largest_message) + decode_padding;
+        std::size_t pooled_buffers = std::min<std::size_t>(options.pooled_buffers, no_buffer);
+        _pool.resize(pooled_buffers * _buffer_size);
+        _free_buffers.reserve(pooled_buffers);
+        for (std::size_t i = pooled_buffers; i-- > 0;)
+        {
+            _free_buffers.push_back(uint16_t(i));
+        }
+        _single_frame.resize(std::max(_buffer_size, max_single_frame_size + decode_padding));
+    }
+
+    bool OnFrame(uint32_t id, const uint8_t* data, std::size_t size, uint64_t timestamp_us)
+    {
+        auto iter = _routes.find(id);
+        if (iter == _routes.end())
+        {
+            return false;
+        }
+        Expire(timestamp_us);
+        if (size == 0)
+        {
+            return true;
+        }
+        const Route& route = iter->second;
+        uint8_t frame_type = data[0] >> 4;
+        if (frame_type == FlowControl)
+        {
+            if (route.flow_control != no_channel)
+            {
+                OnFlowControl(route.flow_control, data[0] & 0xF, timestamp_us);
+            }
+            return true;
+        }
+        if (route.data == no_channel)
+        {
+            return true;
+        }
+        switch (frame_type)
+        {
+        case SingleFrame: OnSingleFrame(route.data, data, size); break;
+        case FirstFrame: OnFirstFrame(route.data, data, size, timestamp_us); break;
+        case ConsecutiveFrame: OnConsecutiveFrame(route.data, data, size, timestamp_us); break;
+        }
+        return true;
+    }
+    void Expire(uint64_t timestamp_us)
+    {
+        uint16_t oldest;
+        while ((oldest = _sessions_by_age.Oldest()) != no_channel && _sessions[oldest].last_us + _timeout_us < timestamp_us)
+        {
+            _stats.timed_out++;
+            Release(oldest);
+        }
+    }
+
+    std::size_t ActiveSessions() const
+    {
+        return _active_sessions;
+    }
+    const ReassemblerStats& Stats() const
+    {
+        return _stats;
+    }
+
+private:
+    void OnSingleFrame(uint16_t channel, const uint8_t* data, std::size_t size)
+    {
+        AbortInProgress(channel);
+        std::size_t length = data[0] & 0xF;
+        std::size_t offset = 1;
+        // CAN FD frames longer than 8 bytes carry the length in the second byte
+        if (size > classic_frame_size)
+        {
+            length = length == 0 ? data[1] : 0;
+            offset = 2;
+        }
+        uint8_t* buffer = _channels[channel].buffer;
+        std::size_t capacity = _channels[channel].capacity;
+        if (!buffer)
+        {
+            buffer = _single_frame.data();
+            capacity = _single_frame.size();
+        }
+        if (length == 0 || offset + length > size || length + decode_padding > capacity)
+        {
+            _stats.rejected++;
+            return;
+        }
+        std::memcpy(buffer, data + offset, length);
+        Deliver(channel, buffer, capacity, length);
+    }
+    void OnFirstFrame(uint16_t channel, const uint8_t* data, std::size_t size, uint64_t timestamp_us)
+    {
+        AbortInProgress(channel);
+        if (size < classic_frame_size)
+        {
+            _stats.rejected++;
+            return;
+        }
+        uint32_t length = ((data[0] & 0xF) << 8) | data[1];
+        std::size_t offset = 2;
+        // escape sequence for PDUs larger than 4095 bytes
+        if (length == 0)
+        {
+            length = read_u32_be(data + 2);
+            offset = 6;
+        }
+        auto& session = _sessions[channel];
+        const auto& config = _channels[channel];
+        session.pooled_buffer = no_buffer;
+        if (config.buffer)
+        {
+            session.buffer = config.buffer;
+            session.capacity = config.capacity;
+        }
+        else if (length <= _max_size && !_free_buffers.empty())
+        {
+            session.pooled_buffer = _free_buffers.back();
+            session.buffer = _pool.data() + std::size_t(session.pooled_buffer) * _buffer_size;
+            session.capacity = _buffer_size;
+            _free_buffers.pop_back();
+        }
+        // a PDU which fits into the first frame would have been a single frame
+        if (!session.buffer || length <= size - offset || length + decode_padding > session.capacity)
+        {
+            _stats.rejected++;
+            Release(channel, false);
+            return;
+        }
+        session.size = length;
+        session.received = uint32_t(size - offset);
+        session.frame_size = size;
+        session.next_sequence_number = 1;
+        session.last_us = timestamp_us;
+        std::memcpy(session.buffer, data + offset, session.received);
+        _sessions_by_age.Append(channel);
+        _active_sessions++;
+    }
+    void OnConsecutiveFrame(uint16_t channel, const uint8_t* data, std::size_t size, uint64_t timestamp_us)
+    {
+        auto& session = _sessions[channel];
+        if (!session.buffer)
+        {
+            return;
+        }
+        std::size_t remaining = session.size - session.received;
+        std::size_t length = std::min(remaining, size - 1);
+        if ((data[0] & 0xF) != session.next_sequence_number || (length < remaining && size != session.frame_size))
+        {
+            _stats.sequence_errors++;
+            Release(channel);
+            return;
+        }
+        std::memcpy(session.buffer + session.received, data + 1, length);
+        session.received += uint32_t(length);
+        session.next_sequence_number = (session.next_sequence_number + 1) & 0xF;
+        if (session.received < session.size)
+        {
+            session.last_us = timestamp_us;
+            _sessions_by_age.Touch(channel);
+            return;
+        }
+        Deliver(channel, session.buffer, session.capacity, session.size);
+        Release(channel);
+    }
+    void OnFlowControl(uint16_t channel, uint8_t flow_status, uint64_t timestamp_us)
+    {
+        auto& session = _sessions[channel];
+        if (!session.buffer)
+        {
+            return;
+        }
+        if (flow_status == Overflow)
+        {
+            _stats.aborted++;
+            Release(channel);
+            return;
+        }
+        // continue to send or wait, the sender has to send the next frame within the timeout again
+        session.last_us = timestamp_us;
+        _sessions_by_age.Touch(channel);
+    }
+
+    void Deliver(uint16_t channel, uint8_t* buffer, std::size_t capacity, std::size_t size)
+    {
+        Pdu pdu;
+        pdu.channel = &_channels[channel];
+        pdu.data = buffer;
+        pdu.size = size;
+        pdu.message = _sessions[channel].message;
+        // the buffer holds the rest of earlier PDUs
+        std::size_t decoded_size = std::max<std::size_t>(size, pdu.message ? pdu.message->MessageSize() : 0);
+        std::size_t end = std::min(decoded_size + decode_padding, capacity);
+        std::memset(buffer + size, 0, end - size);
+        _stats.completed++;
+        if (_on_pdu)
+        {
+            _on_pdu(pdu);
+        }
+    }
+    // a new PDU of the sender ends the one in progress
+    void AbortInProgress(uint16_t channel)
+    {
+        if (_sessions[channel].buffer)
+        {
+            _stats.aborted++;
+            Release(channel);
+        }
+    }
+    void Release(uint16_t channel, bool active = true)
+    {
+        auto& session = _sessions[channel];
+        if (active)
+        {
+            _sessions_by_age.Unlink(channel);
+            _active_sessions--;
+        }
+        if (session.pooled_buffer != no_buffer)
+        {
+            _free_buffers.push_back(session.pooled_buffer);
+            session.pooled_buffer = no_buffer;
+        }
+        session.buffer = nullptr;
+    }
+
+    const std::vector<Channel> _channels;
+    const std::size_t _max_size;
+    const uint64_t _timeout_us;
+    on_pdu_t _on_pdu;
+    std::unordered_map<uint32_t, Route> _routes;
+
+    std::vector<Session> _sessions;
+    SessionList _sessions_by_age;
+    std::size_t _active_sessions = 0;
+    std::size_t _buffer_size;
+    std::vector<uint8_t> _pool;
+    std::vector<uint16_t> _free_buffers;
+    std::vector<uint8_t> _single_frame;
+    ReassemblerStats _stats;
+};
+
+Reassembler::Reassembler(const ReassemblerOptions& options, on_pdu_t on_pdu, const INetwork* net)
+    : _impl(std::make_unique<Impl>(options, std::move(on_pdu), net))
+{}
+Reassembler::~Reassembler() = default;
+bool Reassembler::OnFrame(uint32_t id, const uint8_t* data, std::size_t size, uint64_t timestamp_us)
+{
+    return _impl->OnFrame(id, data, size, timestamp_us);
+}
+void Reassembler::Expire(uint64_t timestamp_us)
+{
+    _impl->Expire(timestamp_us);
+}
+std::size_t Reassembler::ActiveSessions() const
+{
+    return _impl->ActiveSessions();
+}
+const ReassemblerStats& Reassembler::Stats() const
+{
+    return _impl->Stats();
+}
@@ -0,0 +1,371 @@
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+#include "dbcppp/J1939.h"
+#include "SessionList.h"
+
+using namespace dbcppp;
+using namespace dbcppp::J1939;
+
+namespace
+{
+    enum ETpControl : uint8_t
+    {
+        TpRts = 16,
+        TpCts = 17,
+        TpEndOfMsgAck = 19,
+        TpBam = 32,
+        EtpRts = 20,
+        EtpCts = 21,
+        EtpDpo = 22,
+        EtpEndOfMsgAck = 23,
+        Abort = 255
+    };
+    enum EProtocol
+    {
+        Tp,
+        Etp
+    };
+    constexpr std::size_t bytes_per_packet = 7;
+    // the payloads are decoded in place, which reads whole 64 bit words
+    constexpr std::size_t decode_padding = 8;
+    constexpr uint16_t no_slot = SessionList::none;
+
+    uint32_t read_pgn(const uint8_t* data)
+    {
+        return data[5] | (data[6] << 8) | (uint32_t(data[7]) << 16);
+    }
+    uint32_t read_u24(const uint8_t* data)
+    {
+        return data[0] | (data[1] << 8) | (uint32_t(data[2]) << 16);
+    }
+    uint32_t read_u32(const uint8_t* data)
+    {
+        return read_u24(data) | (uint32_t(data[3]) << 24);
+    }
+    // the sessions are identified by protocol, originator and receiver,
+    // J1939-21 allows only one of them per protocol and pair at a time
+    std::size_t session_key(EProtocol protocol, uint8_t source, uint8_t destination)
+    {
+        return (std::size_t(protocol) << 16) | (std::size_t(source) << 8) | destination;
+    }
+
+    // whole packets and the padding, at least the largest message of the network is decoded in place
+    std::size_t buffer_size(std::size_t max_size, const INetwork* net)
+    {
+        std::size_t size = (max_size + bytes_per_packet - 1) / bytes_per_packet * bytes_per_packet;
+        if (net)
+        {
+            for (const IMessage& msg : net->Messages())
+            {
+                size = std::max<std::size_t>(size, msg.MessageSize());
+            }
+        }
+        return size + decode_padding;
+    }
+
+    struct Session
+    {
+        std::size_t key;
+        Id id;
+        uint32_t size;
+        uint32_t packets;
+        // number of the next packet, 1 based
+        uint32_t next_packet;
+        // the data packet offset of ETP, the sequence numbers of its data frames are relative to it
+        uint32_t packet_offset;
+        uint64_t last_us;
+        uint8_t* buffer;
+    };
+}
+
+class Reassembler::Impl
+{
+public:
+    Impl(const ReassemblerOptions& options, on_payload_t&& on_payload, const INetwork* net)
+        : _max_size(options.max_size)
+        , _timeout_us(options.timeout_us)
+        , _buffer_size(buffer_size(options.max_size, net))
+        , _on_payload(std::move(on_payload))
+        , _net(net)
+        , _slot_of_key(2 << 16, no_slot)
+        , _sessions_by_age(std::min<std::size_t>(options.max_sessions, no_slot))
+    {
+        std::size_t max_sessions = std::min<std::size_t>(options.max_sessions, no_slot);
+        _sessions.resize(max_sessions);
+        _buffers.resize(max_sessions * _buffer_size);
+        _free.reserve(max_sessions);
+        for (std::size_t i = max_sessions; i-- > 0;)
+        {
+            _sessions[i].buffer = _buffers.data() + i * _buffer_size;
+            _free.push_back(uint16_t(i));
+        }
+        if (_net)
+        {
+            // build the lookup table now instead of with the first payload
+            _net->MessageByJ1939Id(0);
+        }
+    }
+
+    bool OnFrame(uint32_t can_id, const uint8_t* data, std::size_t size, uint64_t timestamp_us)
+    {
+        Id id = ParseId(can_id);
+        switch (id.pgn)
+        {
+        case PGN_TP_CM: case PGN_TP_DT: case PGN_ETP_CM: case PGN_ETP_DT: break;
+        default: return false;
+        }
+        Expire(timestamp_us);
+        if (size < 8)
+        {
+            return true;
+        }
+        switch (id.pgn)
+        {
+        case PGN_TP_CM: OnTpCm(id, data, timestamp_us); break;
+        case PGN_ETP_CM: OnEtpCm(id, data, timestamp_us); break;
+        case PGN_TP_DT: OnDt(Tp, id, data, timestamp_us); break;
+        case PGN_ETP_DT: OnDt(Etp, id, data, timestamp_us); break;
+        }
+        return true;
+    }
+    void Expire(uint64_t timestamp_us)
+    {
+        uint16_t oldest;
+        while ((oldest = _sessions_by_age.Oldest()) != no_slot && _sessions[oldest].last_us + _timeout_us < timestamp_us)
+        {
+            _stats.timed_out++;
+            Release(oldest);
+        }
+    }
+
+    std::size_t ActiveSessions() const
+    {
+        return _sessions.size() - _free.size();
+    }
+    const ReassemblerStats& Stats() const
+    {
+        return _stats;
+    }
+
+private:
+    void OnTpCm(const Id& id, const uint8_t* data, uint64_t timestamp_us)
+    {
+        switch (data[0])
+        {
+        case TpRts:
+        case TpBam:
+        {
+            uint32_t size = data[1] | (data[2] << 8);
+            uint32_t packets = data[3];
+            if (size > 1785 || packets != (size + bytes_per_packet - 1) / bytes_per_packet)
+            {
+                _stats.rejected++;
+                return;
+            }
+            uint8_t destination = data[0] == TpBam ? GlobalAddress : id.destination;
+            Open(Tp, Id{id.priority, read_pgn(data), id.source, destination}, size, packets, timestamp_us);
+            break;
+        }
+        case TpCts:
+            // sent by the receiver, the next packet may be one which was sent before
+            if (auto session = Find(Tp, id.destination, id.source))
+            {
+                if (data[1])
+                {
+                    session->next_packet = data[2];
+                }
+                Touch(*session, timestamp_us);
+            }
+            break;
+        case TpEndOfMsgAck:
+            // the payload was delivered with its last packet already
+            if (auto session = Find(Tp, id.destination, id.source))
+            {
+                Release(Slot(*session));
+            }
+            break;
+        case Abort:
+            OnAbort(Tp, id);
+            break;
+        }
+    }
+    void OnEtpCm(const Id& id, const uint8_t* data, uint64_t timestamp_us)
+    {
+        switch (data[0])
+        {
+        case EtpRts:
+        {
+            uint32_t size = read_u32(data + 1);
+            Open(Etp, Id{id.priority, read_pgn(data), id.source, id.destination}, size
+                , uint32_t((uint64_t(size) + bytes_per_packet - 1) / bytes_per_packet), timestamp_us);
+            break;
+        }
+        case EtpCts:
+            if (auto session = Find(Etp, id.destination, id.source))
+            {
+                if (data[1])
+                {
+                    session->next_packet = read_u24(data + 2);
+                }
+                Touch(*session, timestamp_us);
+            }
+            break;
+        case EtpDpo:
+            if (auto session = Find(Etp, id.source, id.destination))
+            {
+                session->packet_offset = read_u24(data + 2);
+                Touch(*session, timestamp_us);
+            }
+            break;
+        case EtpEndOfMsgAck:
+            if (auto session = Find(Etp, id.destination, id.source))
+            {
+                Release(Slot(*session));
+            }
+            break;
+        case Abort:
+            OnAbort(Etp, id);
+            break;
+        }
+    }
+    void OnAbort(EProtocol protocol, const Id& id)
+    {
+        // either side may abort
+        if (auto session = Find(protocol, id.source, id.destination))
+        {
+            _stats.aborted++;
+            Release(Slot(*session));
+        }
+        if (auto session = Find(protocol, id.destination, id.source))
+        {
+            _stats.aborted++;
+            Release(Slot(*session));
+        }
+    }
+    void OnDt(EProtocol protocol, const Id& id, const uint8_t* data, uint64_t timestamp_us)
+    {
+        auto session = Find(protocol, id.source, id.destination);
+        if (!session)
+        {
+            return;
+        }
+        uint32_t packet = session->packet_offset + data[0];
+        if (data[0] == 0 || packet != session->next_packet || packet > session->packets)
+        {
+            _stats.sequence_errors++;
+            Release(Slot(*session));
+            return;
+        }
+        std::memcpy(session->buffer + std::size_t(packet - 1) * bytes_per_packet, data + 1, bytes_per_packet);
+        session->next_packet++;
+        if (packet < session->packets)
+        {
+            Touch(*session, timestamp_us);
+            return;
+        }
+        Deliver(*session);
+        // the receiver of a RTS/CTS session still acknowledges, but there is nothing left to wait for
+        Release(Slot(*session));
+    }
+
+    void Open(EProtocol protocol, const Id& id, uint32_t size, uint32_t packets, uint64_t timestamp_us)
+    {
+        std::size_t key = session_key(protocol, id.source, id.destination);
+        if (_slot_of_key[key] != no_slot)
+        {
+            _stats.aborted++;
+            Release(_slot_of_key[key]);
+        }
+        if (size > _max_size || packets == 0 || _free.empty())
+        {
+            _stats.rejected++;
+            return;
+        }
+        uint16_t slot = _free.back();
+        _free.pop_back();
+        _slot_of_key[key] = slot;
+        auto& session = _sessions[slot];
+        session.key = key;
+        session.id = id;
+        session.size = size;
+        session.packets = packets;
+        session.next_packet = 1;
+        session.packet_offset = 0;
+        session.last_us = timestamp_us;
+        _sessions_by_age.Append(slot);
+    }
+    Session* Find(EProtocol protocol, uint8_t source, uint8_t destination)
+    {
+        uint16_t slot = _slot_of_key[session_key(protocol, source, destination)];
+        return slot != no_slot ? &_sessions[slot] : nullptr;
+    }
+    uint16_t Slot(const Session& session) const
+    {
+        return uint16_t(&session - _sessions.data());
+    }
+    void Deliver(Session& session)
+    {
+        Payload payload;
+        payload.id = session.id;
+        payload.data = session.buffer;
+        payload.size = session.size;
+        // the destination address of PDU1 PGs isn't part of the PGN, so the source address completes the id
+        payload.message = _net ? _net->MessageByJ1939Id((session.id.pgn << 8) | session.id.source) : nullptr;
+        // the last packet is padded and the buffer holds the rest of earlier sessions
+        std::size_t decoded_size = std::max<std::size_t>(session.size, payload.message ? payload.message->MessageSize() : 0);
+        std::size_t end = std::min(decoded_size + decode_padding, _buffer_size);
+        std::memset(session.buffer + session.size, 0, end - session.size);
+        _stats.completed++;
+        if (_on_payload)
+        {
+            _on_payload(payload);
+        }
+    }
+    void Touch(Session& session, uint64_t timestamp_us)
+    {
+        session.last_us = timestamp_us;
+        _sessions_by_age.Touch(Slot(session));
+    }
+    void Release(uint16_t slot)
+    {
+        _sessions_by_age.Unlink(slot);
+        _slot_of_key[_sessions[slot].key] = no_slot;
+        _free.push_back(slot);
+    }
+
+    const std::size_t _max_size;
+    const uint64_t _timeout_us;
+    const std::size_t _buffer_size;
+    on_payload_t _on_payload;
+    const INetwork* _net;
+
+    std::vector<Session> _sessions;
+    std::vector<uint8_t> _buffers;
+    std::vector<uint16_t> _free;
+    std::vector<uint16_t> _slot_of_key;
+    SessionList _sessions_by_age;
+    ReassemblerStats _stats;
+};
+
+Reassembler::Reassembler(const ReassemblerOptions& options, on_payload_t on_payload, const INetwork* net)
+    : _impl(std::make_unique<Impl>(options, std::move(on_payload), net))
+{}
+Reassembler::~Reassembler() = default;
+bool Reassembler::OnFrame(uint32_t can_id, const uint8_t* data, std::size_t size, uint64_t timestamp_us)
+{
+    return _impl->OnFrame(can_id, data, size, timestamp_us);
+}
+void Reassembler::Expire(uint64_t timestamp_us)
+{
+    _impl->Expire(timestamp_us);
+}
+std::size_t Reassembler::ActiveSessions() const
+{
+    return _impl->ActiveSessions();
+}
+const ReassemblerStats& Reassembler::Stats() const
+{
+    return _impl->Stats();
+}
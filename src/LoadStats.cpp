@@ -0,0 +1,31 @@
+#include <atomic>
+
+#include "dbcppp/LoadStats.h"
+#include "LoadStatsRecorder.h"
+#include "NetworkImpl.h"
+#include "MemoryCounter.h"
+
+using namespace dbcppp;
+
+namespace
+{
+    // constant initialized, so allocations during the static initialization are counted too
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> allocated_bytes{0};
+}
+
+void LoadStats::CountAllocation(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+AllocationCount dbcppp::allocation_count()
+{
+    return {allocations.load(std::memory_order_relaxed), allocated_bytes.load(std::memory_order_relaxed)};
+}
+std::vector<LoadStats::Entity> dbcppp::footprint(const INetwork& net)
+{
+    MemoryCounter counter;
+    static_cast<const NetworkImpl&>(net).CountMemory(counter);
+    return counter.Footprint();
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <utility>
+
+#include "dbcppp/Network.h"
+#include "dbcppp/LoadStats.h"
+
+namespace dbcppp
+{
+    struct AllocationCount
+    {
+        uint64_t allocations;
+        uint64_t bytes;
+    };
+    // the counters LoadStats::CountAllocation increments
+    AllocationCount allocation_count();
+    std::vector<LoadStats::Entity> footprint(const INetwork& net);
+
+    // Fills in the LoadStats of a load, every call is a no-op if there are no stats to fill in.
+    class LoadStatsRecorder
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        explicit LoadStatsRecorder(LoadStats* stats)
+            : _stats(stats)
+        {
+            if (_stats)
+            {
+                *_stats = LoadStats();
+                Restart();
+            }
+        }
+        bool Enabled() const
+        {
+            return _stats != nullptr;
+        }
+        // ends the current phase, the next one starts right away
+        void Phase(std::string name)
+        {
+            if (_stats)
+            {
+                _stats->phases.push_back(Lap(std::move(name)));
+            }
+        }
+        // Like Phase, but the part of the phase measured by nested is taken out of it
+        // and recorded as a phase of its own, which follows the shortened phase.
+        void Phase(std::string name, LoadStats::Phase&& nested)
+        {
+            if (_stats)
+            {
+                auto phase = Lap(std::move(name));
+                phase.wall_time_ms -= nested.wall_time_ms;
+                phase.allocations -= nested.allocations;
+                phase.allocated_bytes -= nested.allocated_bytes;
+                _stats->phases.push_back(std::move(phase));
+                _stats->phases.push_back(std::move(nested));
+            }
+        }
+        void AstNode(std::string name, uint64_t count)
+        {
+            if (_stats)
+            {
+                _stats->ast_nodes.push_back({std::move(name), count});
+            }
+        }
+        void Finish(const INetwork* net)
+        {
+            if (_stats)
+            {
+                if (net)
+                {
+                    _stats->footprint = footprint(*net);
+                }
+                _stats->allocations_counted = allocation_count().allocations != 0;
+            }
+        }
+
+        // adds the time and allocations of func to phase
+        template <class Func>
+        static void Measure(LoadStats::Phase& phase, Func&& func)
+        {
+            auto allocs = allocation_count();
+            auto start = clock::now();
+            func();
+            phase.wall_time_ms += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+            auto end_allocs = allocation_count();
+            phase.allocations += end_allocs.allocations - allocs.allocations;
+            phase.allocated_bytes += end_allocs.bytes - allocs.bytes;
+        }
+
+    private:
+        void Restart()
+        {
+            _start = clock::now();
+            _allocs = allocation_count();
+        }
+        LoadStats::Phase Lap(std::string name)
+        {
+            LoadStats::Phase phase;
+            phase.name = std::move(name);
+            phase.wall_time_ms = std::chrono::duration<double, std::milli>(clock::now() - _start).count();
+            auto allocs = allocation_count();
+            phase.allocations = allocs.allocations - _allocs.allocations;
+            phase.allocated_bytes = allocs.bytes - _allocs.bytes;
+            Restart();
+            return phase;
+        }
+
+        LoadStats* _stats;
+        clock::time_point _start;
+        AllocationCount _allocs;
+    };
+}
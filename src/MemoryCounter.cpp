@@ -0,0 +1,53 @@
+#include "MemoryCounter.h"
+
+using namespace dbcppp;
+
+MemoryCounter::ECategory MemoryCounter::category(EEntity entity)
+{
+    switch (entity)
+    {
+    case EEntity::Signals:                      return ECategory::SignalHotData;
+    case EEntity::ValueTables:                  return ECategory::ValueDescriptions;
+    case EEntity::ValueEncodingDescriptions:    return ECategory::ValueDescriptions;
+    case EEntity::SignalMultiplexerValues:      return ECategory::MuxMetadata;
+    case EEntity::AttributeDefinitions:         return ECategory::Attributes;
+    case EEntity::Attributes:                   return ECategory::Attributes;
+    default:                                    return ECategory::Other;
+    }
+}
+MemoryUsageBreakdown MemoryCounter::Breakdown() const
+{
+    MemoryUsageBreakdown result;
+    result.signal_hot_data = _category_bytes[std::size_t(ECategory::SignalHotData)];
+    result.names = _category_bytes[std::size_t(ECategory::Names)];
+    result.comments = _category_bytes[std::size_t(ECategory::Comments)];
+    result.attributes = _category_bytes[std::size_t(ECategory::Attributes)];
+    result.value_descriptions = _category_bytes[std::size_t(ECategory::ValueDescriptions)];
+    result.mux_metadata = _category_bytes[std::size_t(ECategory::MuxMetadata)];
+    result.indices = _category_bytes[std::size_t(ECategory::Indices)];
+    result.other = _category_bytes[std::size_t(ECategory::Other)];
+    return result;
+}
+std::vector<LoadStats::Entity> MemoryCounter::Footprint() const
+{
+    static const char* names[std::size_t(EEntity::Count)] =
+    {
+        "network",
+        "nodes",
+        "value tables",
+        "messages",
+        "signals",
+        "signal multiplexer values",
+        "signal groups",
+        "value descriptions",
+        "environment variables",
+        "attribute definitions",
+        "attributes"
+    };
+    std::vector<LoadStats::Entity> result;
+    for (std::size_t i = 0; i < std::size_t(EEntity::Count); i++)
+    {
+        result.push_back({names[i], _counts[i], _entity_bytes[i]});
+    }
+    return result;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "dbcppp/LoadStats.h"
+#include "dbcppp/MemoryUsageBreakdown.h"
+
+namespace dbcppp
+{
+    // Sums up the memory of the objects of a network by category for INetwork::MemoryUsage and by entity type
+    // for LoadStats::footprint. The container which holds objects adds them with Objects, the objects add the
+    // heap memory they own in their CountMemory.
+    class MemoryCounter
+    {
+    public:
+        enum class EEntity
+        {
+            Network,
+            Nodes,
+            ValueTables,
+            Messages,
+            Signals,
+            SignalMultiplexerValues,
+            SignalGroups,
+            ValueEncodingDescriptions,
+            EnvironmentVariables,
+            AttributeDefinitions,
+            Attributes,
+            Count
+        };
+        enum class ECategory
+        {
+            SignalHotData,
+            Names,
+            Comments,
+            Attributes,
+            ValueDescriptions,
+            MuxMetadata,
+            Indices,
+            Other,
+            Count
+        };
+
+        void Add(EEntity entity, ECategory category, uint64_t bytes)
+        {
+            _entity_bytes[std::size_t(entity)] += bytes;
+            _category_bytes[std::size_t(category)] += bytes;
+        }
+        void Add(EEntity entity, ECategory category, const std::string& str)
+        {
+            Add(entity, category, heap_bytes(str));
+        }
+        void Add(EEntity entity, ECategory category, const std::vector<std::string>& strs)
+        {
+            uint64_t bytes = strs.capacity() * sizeof(std::string);
+            for (const auto& str : strs)
+            {
+                bytes += heap_bytes(str);
+            }
+            Add(entity, category, bytes);
+        }
+        // count objects of bytes each which aren't stored in a vector
+        void Objects(EEntity entity, uint64_t count, uint64_t bytes)
+        {
+            _counts[std::size_t(entity)] += count;
+            Add(entity, category(entity), count * bytes);
+        }
+        template <class T>
+        void Objects(EEntity entity, const std::vector<T>& objects)
+        {
+            _counts[std::size_t(entity)] += objects.size();
+            Add(entity, category(entity), objects.capacity() * sizeof(T));
+            for (const auto& object : objects)
+            {
+                object.CountMemory(*this);
+            }
+        }
+
+        MemoryUsageBreakdown Breakdown() const;
+        std::vector<LoadStats::Entity> Footprint() const;
+
+        static uint64_t heap_bytes(const std::string& str)
+        {
+            // strings which fit into the small string buffer don't allocate
+            static const std::size_t sso_capacity = std::string().capacity();
+            return str.capacity() > sso_capacity ? str.capacity() + 1 : 0;
+        }
+
+    private:
+        // the category of the objects themselves
+        static ECategory category(EEntity entity);
+
+        std::array<uint64_t, std::size_t(EEntity::Count)> _counts{};
+        std::array<uint64_t, std::size_t(EEntity::Count)> _entity_bytes{};
+        std::array<uint64_t, std::size_t(ECategory::Count)> _category_bytes{};
+    };
+}
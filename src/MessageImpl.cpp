@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <unordered_set>
 #include "MessageImpl.h"
+#include "MemoryCounter.h"
 #include "Helper.h"
 
 using namespace dbcppp;
@@ -122,6 +123,8 @@ MessageImpl::MessageImpl(const MessageImpl& other)
     _signals = other._signals;
     _attribute_values = other._attribute_values;
     _comment = other._comment;
+    _signal_groups = other._signal_groups;
+    _fingerprint = other._fingerprint;
     _mux_signal = nullptr;
     for (const auto& sig : _signals)
     {
@@ -144,6 +147,9 @@ MessageImpl& MessageImpl::operator=(const MessageImpl& other)
     _signals = other._signals;
     _attribute_values = other._attribute_values;
     _comment = other._comment;
+    _signal_groups = other._signal_groups;
+    _fingerprint = other._fingerprint;
+    _mux_conditions.Reset();
     _mux_signal = nullptr;
     for (const auto& sig : _signals)
     {
@@ -230,11 +236,64 @@ const std::vector<SignalImpl>& MessageImpl::signals() const
 {
     return _signals;
 }
+std::vector<std::string>& MessageImpl::messageTransmitters()
+{
+    _fingerprint.Reset();
+    return _message_transmitters;
+}
+std::vector<SignalImpl>& MessageImpl::signals()
+{
+    _fingerprint.Reset();
+    _mux_conditions.Reset();
+    return _signals;
+}
+std::vector<AttributeImpl>& MessageImpl::attributeValues()
+{
+    _fingerprint.Reset();
+    return _attribute_values;
+}
+std::string& MessageImpl::comment()
+{
+    _fingerprint.Reset();
+    return _comment;
+}
+std::vector<SignalGroupImpl>& MessageImpl::signalGroups()
+{
+    _fingerprint.Reset();
+    return _signal_groups;
+}
+const MuxConditions& MessageImpl::muxConditions() const
+{
+    return _mux_conditions.Get(*this);
+}
+Hash128 MessageImpl::Fingerprint() const
+{
+    return _fingerprint.Get(
+        [this]()
+        {
+            Hasher hasher;
+            hasher.Add(_id);
+            hasher.Add(_name);
+            hasher.Add(_message_size);
+            hasher.Add(_transmitter);
+            hasher.AddUnordered(_message_transmitters);
+            hasher.AddUnordered(_signals);
+            hasher.AddUnordered(_attribute_values);
+            hasher.Add(_comment);
+            hasher.AddUnordered(_signal_groups);
+            return hasher.Finish();
+        });
+}
 bool MessageImpl::operator==(const IMessage& rhs) const
 {
+    if (Fingerprint() != rhs.Fingerprint())
+    {
+        return false;
+    }
     bool equal = true;
     equal &= _id == rhs.Id();
     equal &= _name == rhs.Name();
+    equal &= _message_size == rhs.MessageSize();
     equal &= _transmitter == rhs.Transmitter();
     for (const auto& msg_trans : rhs.MessageTransmitters())
     {
@@ -267,30 +326,34 @@ bool MessageImpl::operator!=(const IMessage& rhs) const
 {
     return !(*this == rhs);
 }
+void MessageImpl::CountMemory(MemoryCounter& counter) const
+{
+    using EEntity = MemoryCounter::EEntity;
+    using ECategory = MemoryCounter::ECategory;
+    counter.Add(EEntity::Messages, ECategory::Names, _name);
+    counter.Add(EEntity::Messages, ECategory::Names, _transmitter);
+    counter.Add(EEntity::Messages, ECategory::Names, _message_transmitters);
+    counter.Add(EEntity::Messages, ECategory::Comments, _comment);
+    counter.Objects(EEntity::Signals, _signals);
+    counter.Objects(EEntity::Attributes, _attribute_values);
+    counter.Objects(EEntity::SignalGroups, _signal_groups);
+}
 
 void MessageImpl::Merge(MessageImpl &&o) {
     // refuse to merge if id not same
     if (_id != o._id) {
         return;
     }
+    _fingerprint.Reset();
+    _mux_conditions.Reset();
     compare_set(_name, o._name);
     compare_set(_message_size, o._message_size);
     compare_set(_transmitter, o._transmitter);
     
     unique_merge(_message_transmitters, o._message_transmitters);
     // merge signal by name
-    for (SignalImpl& item2 : o._signals) {
-        auto it = std::find_if(_signals.begin(), _signals.end(), [&item2](const SignalImpl& item1) {
-            return item1.Name() == item2.Name();
-        });
-        if (it != _signals.end()) {
-            // merge it
-            it->Merge(std::move(item2));
-        } else {
-            // insert new
-            _signals.push_back(std::move(item2));
-        }
-    }
+    merge_by_key(_signals, o._signals, by_name(),
+        [](SignalImpl& item1, SignalImpl&& item2) { item1.Merge(std::move(item2)); });
     // same type attr name is unique in one message
     unique_merge_by_name(_attribute_values, o._attribute_values);
     // name is unique in one message(id same)
@@ -5,9 +5,13 @@
 #include "NodeImpl.h"
 #include "AttributeImpl.h"
 #include "SignalGroupImpl.h"
+#include "Fingerprint.h"
+#include "MuxConditions.h"
 
 namespace dbcppp
 {
+    class MemoryCounter;
+
     class MessageImpl final
         : public IMessage
     {
@@ -47,12 +51,22 @@ namespace dbcppp
         virtual bool Error(EErrorCode code) const override;
         
         const std::vector<SignalImpl>& signals() const;
+        std::vector<std::string>& messageTransmitters();
+        std::vector<SignalImpl>& signals();
+        std::vector<AttributeImpl>& attributeValues();
+        std::string& comment();
+        std::vector<SignalGroupImpl>& signalGroups();
+        const MuxConditions& muxConditions() const;
         
+        virtual Hash128 Fingerprint() const override;
+
         virtual bool operator==(const IMessage& rhs) const override;
         virtual bool operator!=(const IMessage& rhs) const override;
 
         void Merge(MessageImpl &&other);
-        
+
+        void CountMemory(MemoryCounter& counter) const;
+
     private:
 
         void SetError(EErrorCode code);
@@ -66,6 +80,8 @@ namespace dbcppp
         std::vector<AttributeImpl> _attribute_values;
         std::string _comment;
         std::vector<SignalGroupImpl> _signal_groups;
+        FingerprintCache _fingerprint;
+        MuxConditionsCache _mux_conditions;
 
         const ISignal* _mux_signal;
 
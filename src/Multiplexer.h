@@ -0,0 +1,96 @@
+#pragma once
+
+#include <vector>
+
+#include "dbcppp/Message.h"
+
+namespace dbcppp
+{
+    // whether the switches of the message select the signal in the frame, a signal which depends on
+    // a switch which is multiplexed itself is only present if the switch is present too.
+    // Cyclic switch chains are followed at most once around.
+    inline bool is_present(const IMessage& msg, const ISignal& sig, const void* data, std::size_t depth = 0)
+    {
+        if (sig.MultiplexerIndicator() != ISignal::EMultiplexer::MuxValue || depth > msg.Signals_Size())
+        {
+            return true;
+        }
+        if (sig.SignalMultiplexerValues_Size() == 0)
+        {
+            const ISignal* mux = msg.MuxSignal();
+            return !mux || mux->Decode(data) == sig.MultiplexerSwitchValue();
+        }
+        for (const auto& smv : sig.SignalMultiplexerValues())
+        {
+            const ISignal* sw = nullptr;
+            for (const ISignal& other : msg.Signals())
+            {
+                if (other.Name() == smv.SwitchName())
+                {
+                    sw = &other;
+                    break;
+                }
+            }
+            if (!sw)
+            {
+                continue;
+            }
+            uint64_t raw = sw->Decode(data);
+            bool in_range = false;
+            for (const auto& range : smv.ValueRanges())
+            {
+                in_range |= raw >= range.from && raw <= range.to;
+            }
+            if (!in_range || !is_present(msg, *sw, data, depth + 1))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // a signal other signals of the message depend on and the values which select them
+    struct MuxSwitch
+    {
+        const ISignal* signal;
+        // of the signal in the message
+        std::size_t index;
+        std::vector<ISignalMultiplexerValue::Range> values;
+    };
+    // switches of cascaded multiplexers are multiplexed themselves, so every signal
+    // another signal depends on is a switch
+    inline std::vector<MuxSwitch> mux_switches(const IMessage& msg)
+    {
+        std::vector<MuxSwitch> switches;
+        for (std::size_t i = 0; i < msg.Signals_Size(); i++)
+        {
+            const ISignal& sw = msg.Signals_Get(i);
+            MuxSwitch s{&sw, i, {}};
+            for (const ISignal& sig : msg.Signals())
+            {
+                if (sig.SignalMultiplexerValues_Size())
+                {
+                    for (const auto& smv : sig.SignalMultiplexerValues())
+                    {
+                        if (smv.SwitchName() == sw.Name())
+                        {
+                            for (const auto& range : smv.ValueRanges())
+                            {
+                                s.values.push_back(range);
+                            }
+                        }
+                    }
+                }
+                else if (sig.MultiplexerIndicator() == ISignal::EMultiplexer::MuxValue && msg.MuxSignal() == &sw)
+                {
+                    s.values.push_back({sig.MultiplexerSwitchValue(), sig.MultiplexerSwitchValue()});
+                }
+            }
+            if (!s.values.empty())
+            {
+                switches.push_back(std::move(s));
+            }
+        }
+        return switches;
+    }
+}
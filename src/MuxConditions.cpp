@@ -0,0 +1,62 @@
+#include "MuxConditions.h"
+
+using namespace dbcppp;
+
+namespace
+{
+    const ISignal* find_switch(const IMessage& msg, const std::string& name)
+    {
+        for (const ISignal& sig : msg.Signals())
+        {
+            if (sig.Name() == name)
+            {
+                return &sig;
+            }
+        }
+        return nullptr;
+    }
+    void add_conditions(const IMessage& msg, const ISignal& sig, std::vector<MuxConditions::Condition>& conditions
+        , std::vector<ISignalMultiplexerValue::Range>& ranges, std::size_t depth = 0)
+    {
+        if (sig.MultiplexerIndicator() != ISignal::EMultiplexer::MuxValue || depth > msg.Signals_Size())
+        {
+            return;
+        }
+        if (sig.SignalMultiplexerValues_Size() == 0)
+        {
+            if (const ISignal* mux = msg.MuxSignal())
+            {
+                conditions.push_back({mux, uint32_t(ranges.size()), 1});
+                ranges.push_back({sig.MultiplexerSwitchValue(), sig.MultiplexerSwitchValue()});
+            }
+            return;
+        }
+        for (const auto& smv : sig.SignalMultiplexerValues())
+        {
+            const ISignal* sw = find_switch(msg, smv.SwitchName());
+            if (!sw)
+            {
+                continue;
+            }
+            MuxConditions::Condition condition{sw, uint32_t(ranges.size()), 0};
+            for (const auto& range : smv.ValueRanges())
+            {
+                ranges.push_back(range);
+                condition.ranges++;
+            }
+            conditions.push_back(condition);
+            add_conditions(msg, *sw, conditions, ranges, depth + 1);
+        }
+    }
+}
+
+MuxConditions::MuxConditions(const IMessage& msg)
+{
+    _first_condition.reserve(msg.Signals_Size() + 1);
+    for (const ISignal& sig : msg.Signals())
+    {
+        _first_condition.push_back(uint32_t(_conditions.size()));
+        add_conditions(msg, sig, _conditions, _ranges);
+    }
+    _first_condition.push_back(uint32_t(_conditions.size()));
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "dbcppp/Message.h"
+
+namespace dbcppp
+{
+    // The switches and value ranges which select the signals of a message, resolved once so that the
+    // presence of a signal in a frame can be checked without looking up the switches by name.
+    // A signal is present if the raw value of every switch of its conditions lies in one of the
+    // ranges of the condition.
+    class MuxConditions
+    {
+    public:
+        struct Condition
+        {
+            const ISignal* sw;
+            uint32_t first_range;
+            uint32_t ranges;
+        };
+
+        // the same rules as is_present, flattened
+        explicit MuxConditions(const IMessage& msg);
+
+        bool Present(std::size_t signal, const void* data) const
+        {
+            for (uint32_t c = _first_condition[signal]; c < _first_condition[signal + 1]; c++)
+            {
+                const Condition& condition = _conditions[c];
+                uint64_t raw = condition.sw->Decode(data);
+                bool in_range = false;
+                for (uint32_t r = condition.first_range; r < condition.first_range + condition.ranges; r++)
+                {
+                    in_range |= raw >= _ranges[r].from && raw <= _ranges[r].to;
+                }
+                if (!in_range)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+        // per signal the index of its first condition, the last entry ends the conditions of the last signal
+        std::vector<uint32_t> _first_condition;
+        std::vector<Condition> _conditions;
+        std::vector<ISignalMultiplexerValue::Range> _ranges;
+    };
+    // Built on first use and published the same way as the MessageIndex of the network.
+    // The conditions point into the signals of the message, so a copy starts without them.
+    class MuxConditionsCache
+    {
+    public:
+        MuxConditionsCache() = default;
+        MuxConditionsCache(const MuxConditionsCache&) {}
+        MuxConditionsCache& operator=(const MuxConditionsCache&)
+        {
+            Reset();
+            return *this;
+        }
+
+        const MuxConditions& Get(const IMessage& msg) const
+        {
+            auto conditions = std::atomic_load_explicit(&_conditions, std::memory_order_acquire);
+            if (!conditions)
+            {
+                auto built = std::make_shared<const MuxConditions>(msg);
+                if (std::atomic_compare_exchange_strong_explicit(&_conditions, &conditions, built
+                    , std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    conditions = std::move(built);
+                }
+            }
+            return *conditions;
+        }
+        void Reset()
+        {
+            std::atomic_store_explicit(&_conditions, std::shared_ptr<const MuxConditions>(), std::memory_order_release);
+        }
+
+    private:
+        mutable std::shared_ptr<const MuxConditions> _conditions;
+    };
+}
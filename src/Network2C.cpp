@@ -1,180 +1,429 @@
 
-#include "NetworkImpl.h"
+#include <set>
+#include <limits>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "dbcppp/Network.h"
 #include "dbcppp/Network2Functions.h"
+#include "CodeGenerator.h"
 
 using namespace dbcppp;
 using namespace dbcppp::Network2C;
+using namespace dbcppp::CodeGenerator;
 
-static const char* header =
-    "#ifndef DBCPPP_BYTE_ORDER_LITTLE_ENDIAN\n"
-    "#error \"Please pass -DDBCPPP_BYTE_ORDER_LITTLE_ENDIAN=<1|0>\"\n"
-    "#endif\n"
-    "#include <stdint.h>\n"
-    "#define bswap_16(value) ((((value) & 0xff) << 8) | ((value) >> 8))\n"
-    "#define bswap_32(value) \\\n"
-    "    (((uint32_t)bswap_16((uint16_t)((value) & 0xffff)) << 16) | \\\n"
-    "    (uint32_t)bswap_16((uint16_t)((value) >> 16)))\n"
-    "#define bswap_64(value) \\\n"
-    "    (((uint64_t)bswap_32((uint32_t)((value) & 0xffffffff)) \\\n"
-    "    << 32) | \\\n"
-    "    (uint64_t)bswap_32((uint32_t)((value) >> 32)))\n"
-    "uint64_t dbcppp_native_to_big(uint64_t& v)\n"
-    "{\n"
-    "#if DBCPPP_BYTE_ORDER_LITTLE_ENDIAN == 1\n"
-    "    return bswap_64(v);\n"
-    "#else\n"
-    "    return v;\n"
-    "#endif\n"
-    "}\n"
-    "uint64_t dbcppp_native_to_little(uint64_t& v)\n"
-    "{\n"
-    "#if DBCPPP_BYTE_ORDER_LITTLE_ENDIAN == 1\n"
-    "    return v;\n"
-    "#else\n"
-    "    return bswap_64(v);\n"
-    "#endif\n"
-    "}\n";
-        
-DBCPPP_API std::ostream& dbcppp::Network2C::operator<<(std::ostream& os, const INetwork& net)
+namespace
 {
-    os << boost::format(header);
-    for (const auto& msg : net.Messages())
+    bool is_float(const ISignal& sig)
+    {
+        return sig.ExtendedValueType() != ISignal::EExtendedValueType::Integer;
+    }
+    std::string c_type(const ISignal& sig)
     {
-        for (const auto& sig : msg.Signals())
+        switch (sig.ExtendedValueType())
         {
-            const SignalImpl& sigi = static_cast<const SignalImpl&>(sig);
-            os << boost::format(
-                "uint64_t dbcppp_decode_%s(const void* nbytes)\n"
-                "{\n"
-                "    uint64_t data;\n")
-                % (msg.Name() + "_" + std::to_string(msg.Id()) + "_" + sig.Name());
-                            
-            uint64_t nbytes;
-            if (sigi.ByteOrder() == ISignal::EByteOrder::LittleEndian)
-            {
-                nbytes = (sigi.StartBit() % 8 + sigi.BitSize() + 7) / 8;
-            }
-            else
-            {
-                nbytes = (sigi.BitSize() + (7 - sigi.StartBit() % 8) + 7) / 8;
-            }
-            if (sigi._byte_pos + nbytes <= 8 || nbytes <= 8)
+        case ISignal::EExtendedValueType::Float: return "float";
+        case ISignal::EExtendedValueType::Double: return "double";
+        default: break;
+        }
+        uint64_t bits = sig.BitSize() <= 8 ? 8 : sig.BitSize() <= 16 ? 16 : sig.BitSize() <= 32 ? 32 : 64;
+        return (is_signed(sig) ? "int" : "uint") + std::to_string(bits) + "_t";
+    }
+    class MessageGenerator
+    {
+    public:
+        MessageGenerator(std::ostream& os, const IMessage& msg, const std::string& name)
+            : _os(os)
+            , _msg(msg)
+            , _name(name)
+            , _size(frame_size(msg))
+        {
+            // signals which are always present come first, then the multiplexed ones in an order
+            // in which every switch is converted before the signals which depend on it
+            std::vector<std::pair<std::size_t, const ISignal*>> muxed;
+            for (const ISignal& sig : msg.Signals())
             {
-                // Alignment::size_inbetween_first_64_bit; or
-                // Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit;
-                if (sigi._byte_pos + nbytes <= 8)
+                if (sig.MultiplexerIndicator() != ISignal::EMultiplexer::MuxValue)
                 {
-                    os << boost::format("    data = *reinterpret_cast<const uint64_t*>(nbytes);\n");
+                    _groups.push_back({"", {&sig}});
                 }
                 else
                 {
-                    os << boost::format(
-                        "data = *reinterpret_cast<const uint64_t*>(&reinterpret_cast<const uint8_t*>(nbytes)[%1%]);\n")
-                        % sigi._byte_pos;
+                    std::set<const ISignal*> visited;
+                    muxed.push_back({multiplexer_depth(msg, sig, visited), &sig});
                 }
-                if (sig.ByteOrder() == ISignal::EByteOrder::BigEndian)
+            }
+            std::stable_sort(muxed.begin(), muxed.end(),
+                [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+            for (const auto& [depth, sig] : muxed)
+            {
+                std::set<const ISignal*> visited;
+                std::string condition = multiplexer_condition(msg, *sig,
+                    [](const ISignal& sw) { return "msg->" + sw.Name(); }, visited);
+                if (!_groups.empty() && _groups.back().first == condition)
                 {
-                    os << boost::format("    data = dbcppp_native_to_big(data);\n");
+                    _groups.back().second.push_back(sig);
                 }
                 else
                 {
-                    os << boost::format("    data = dbcppp_native_to_little(data);\n");
+                    _groups.push_back({condition, {sig}});
                 }
-                if (sig.ExtendedValueType() == ISignal::EExtendedValueType::Double)
+            }
+        }
+
+        void Struct()
+        {
+            _os << "/* " << _msg.Name() << ", id " << hex(_msg.Id()) << ", " << _msg.MessageSize() << " bytes */\n"
+                << "struct dbcppp_" << _name << "\n"
+                << "{\n";
+            for (const ISignal& sig : _msg.Signals())
+            {
+                _os << "    " << c_type(sig) << " " << sig.Name() << ";\n";
+            }
+            if (_msg.Signals_Size() == 0)
+            {
+                _os << "    char dbcppp_empty;\n";
+            }
+            _os << "};\n";
+        }
+        void Unpack()
+        {
+            _os << "static inline int dbcppp_" << _name << "_unpack(struct dbcppp_" << _name
+                << "* msg, const uint8_t* data, uint8_t len)\n"
+                << "{\n";
+            Prologue();
+            for (const auto& [condition, sigs] : _groups)
+            {
+                std::string indent = BeginCondition(condition);
+                for (const ISignal* sig : sigs)
                 {
-                    os << boost::format("    return data;\n");
+                    UnpackSignal(*sig, indent);
                 }
-                else
+                EndCondition(condition);
+            }
+            _os << "    return 0;\n"
+                << "}\n";
+        }
+        void Pack()
+        {
+            _os << "static inline int dbcppp_" << _name << "_pack(uint8_t* data, uint8_t len, const struct dbcppp_"
+                << _name << "* msg)\n"
+                << "{\n";
+            Prologue();
+            if (_size)
+            {
+                _os << "    memset(data, 0, " << _size << ");\n";
+            }
+            for (const auto& [condition, sigs] : _groups)
+            {
+                std::string indent = BeginCondition(condition);
+                for (const ISignal* sig : sigs)
                 {
-                    os << boost::format("    data >>= %1%ull;\n")
-                        % sigi._fixed_start_bit_0;
-                    if (sig.ExtendedValueType() != ISignal::EExtendedValueType::Float)
-                    {
-                        os << boost::format("    data &= %1%ull;\n") % sigi._mask;
-                        if (sig.ValueType() == ISignal::EValueType::Signed)
-                        {
-                            os << boost::format(
-                                "    if (data & %1%ull)\n"
-                                "    {\n"
-                                "        data |= %1%ull;\n"
-                                "    }\n"
-                                "    return data;\n")
-                                % sigi._mask_signed;
-                        }
-                    }
-                    os << boost::format("    return data;\n");
+                    PackSignal(*sig, indent);
                 }
+                EndCondition(condition);
+            }
+            _os << "    return " << _size << ";\n"
+                << "}\n";
+        }
+        void Conversions()
+        {
+            for (const ISignal& sig : _msg.Signals())
+            {
+                RawToPhys(sig);
+                PhysToRaw(sig);
+            }
+        }
+
+    private:
+        void Prologue()
+        {
+            if (_msg.Signals_Size())
+            {
+                _os << "    uint64_t raw;\n";
+            }
+            if (_size)
+            {
+                _os << "    if (len < " << _size << ")\n"
+                    << "    {\n"
+                    << "        return -1;\n"
+                    << "    }\n";
             }
             else
             {
-                // Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit;
-                os << boost::format(
-                    "    data = *reinterpret_cast<const uint64_t*>(&reinterpret_cast<const uint8_t*>(nbytes)[%1%]);\n")
-                    % sigi._byte_pos;
-                os << boost::format(
-                    "    uint64_t data1 = reinterpret_cast<const uint8_t*>(nbytes)[%1% + 8];\n")
-                    % sigi._byte_pos;
-                if (sig.ByteOrder() == ISignal::EByteOrder::BigEndian)
+                _os << "    (void)data;\n"
+                    << "    (void)len;\n";
+            }
+            if (_msg.Signals_Size() == 0)
+            {
+                _os << "    (void)msg;\n";
+            }
+        }
+        std::string BeginCondition(const std::string& condition)
+        {
+            if (condition.empty())
+            {
+                return "    ";
+            }
+            _os << "    if (" << condition << ")\n"
+                << "    {\n";
+            return "        ";
+        }
+        void EndCondition(const std::string& condition)
+        {
+            if (!condition.empty())
+            {
+                _os << "    }\n";
+            }
+        }
+        void UnpackSignal(const ISignal& sig, const std::string& indent)
+        {
+            if (sig.BitSize() == 0)
+            {
+                _os << indent << "msg->" << sig.Name() << " = 0;\n";
+                return;
+            }
+            _os << indent << "raw = ";
+            bool first = true;
+            for (const auto& seg : segments(sig))
+            {
+                std::string value = "data[" + std::to_string(seg.byte) + "]";
+                if (seg.lsb)
                 {
-                    os << boost::format(
-                        "    data = dbcppp_native_to_big(data);\n"
-                        "    data &= %1%ull;\n"
-                        "    data <<= %2%ull;\n"
-                        "    data1 >>= %3%ull;\n"
-                        "    data |= data1;\n")
-                        % sigi._mask
-                        % sigi._fixed_start_bit_0
-                        % sigi._fixed_start_bit_1;
+                    value = "(" + value + " >> " + std::to_string(seg.lsb) + ")";
                 }
-                else
+                if (seg.lsb + seg.width < 8)
+                {
+                    value = "(" + value + " & " + hex((1ull << seg.width) - 1) + ")";
+                }
+                value = "(uint64_t)" + value;
+                if (seg.shift)
                 {
-                    os << boost::format(
-                        "    data = dbcppp_native_to_little(data);\n"
-                        "    data >>= %1%ull;\n"
-                        "    data1 &= %2%ull;\n"
-                        "    data1 <<= %3%ull;\n"
-                        "    data |= data1;)\n")
-                        % sigi._fixed_start_bit_0
-                        % sigi._mask
-                        % sigi._fixed_start_bit_1;
+                    value = "(" + value + " << " + std::to_string(seg.shift) + ")";
                 }
-                switch (sig.ExtendedValueType())
+                _os << (first ? "" : "\n" + indent + "    | ") << value;
+                first = false;
+            }
+            _os << ";\n";
+            switch (sig.ExtendedValueType())
+            {
+            case ISignal::EExtendedValueType::Float:
+                _os << indent << "{\n"
+                    << indent << "    uint32_t bits = (uint32_t)raw;\n"
+                    << indent << "    memcpy(&msg->" << sig.Name() << ", &bits, sizeof(bits));\n"
+                    << indent << "}\n";
+                break;
+            case ISignal::EExtendedValueType::Double:
+                _os << indent << "memcpy(&msg->" << sig.Name() << ", &raw, sizeof(raw));\n";
+                break;
+            default:
+                if (is_signed(sig) && sig.BitSize() < 64)
                 {
-                case ISignal::EExtendedValueType::Integer:
-                    if (sig.ValueType() == ISignal::EValueType::Signed)
-                    {
-                        os << boost::format(
-                            "    if (data & %1%ull)\n"
-                            "    {\n"
-                            "        data |= %1%ull;\n"
-                            "    }\n"
-                            "    return data;\n")
-                            % sigi._mask_signed;
-                        os << boost::format("    return data;\n");
-                    }
-                    else
-                    {
-                        os << boost::format("    return data;\n");
-                    }
-                    break;
-                case ISignal::EExtendedValueType::Float:
-                    os << boost::format("    return data;\n");
-                    break;
-                case ISignal::EExtendedValueType::Double:
-                    os << boost::format("    return data;\n");
-                    break;
+                    uint64_t sign = 1ull << (sig.BitSize() - 1);
+                    _os << indent << "if (raw & " << hex(sign) << ")\n"
+                        << indent << "{\n"
+                        << indent << "    raw |= " << hex(~((sign << 1) - 1)) << ";\n"
+                        << indent << "}\n";
                 }
+                _os << indent << "msg->" << sig.Name() << " = (" << c_type(sig) << ")raw;\n";
+                break;
             }
-            os << boost::format("}\n");
-            os << boost::format(
-                "double dbcppp_rawToPhys_%1%(uint64_t value)\n"
-                "{\n"
-                "    return value * %2% + %3%;\n"
-                "}\n")
-                % (msg.Name() + "_" + std::to_string(msg.Id()) + "_" + sig.Name())
-                % sig.Factor()
-                % sig.Offset();
+        }
+        void PackSignal(const ISignal& sig, const std::string& indent)
+        {
+            if (sig.BitSize() == 0)
+            {
+                return;
+            }
+            switch (sig.ExtendedValueType())
+            {
+            case ISignal::EExtendedValueType::Float:
+                _os << indent << "{\n"
+                    << indent << "    uint32_t bits;\n"
+                    << indent << "    memcpy(&bits, &msg->" << sig.Name() << ", sizeof(bits));\n"
+                    << indent << "    raw = bits;\n"
+                    << indent << "}\n";
+                break;
+            case ISignal::EExtendedValueType::Double:
+                _os << indent << "memcpy(&raw, &msg->" << sig.Name() << ", sizeof(raw));\n";
+                break;
+            default:
+                _os << indent << "raw = (uint64_t)msg->" << sig.Name() << ";\n";
+                break;
+            }
+            for (const auto& seg : segments(sig))
+            {
+                std::string value = "raw";
+                if (seg.shift)
+                {
+                    value = "(" + value + " >> " + std::to_string(seg.shift) + ")";
+                }
+                value = "(" + value + " & " + hex((1ull << seg.width) - 1) + ")";
+                if (seg.lsb)
+                {
+                    value = "(" + value + " << " + std::to_string(seg.lsb) + ")";
+                }
+                _os << indent << "data[" << seg.byte << "] |= (uint8_t)" << value << ";\n";
+            }
+        }
+        void RawToPhys(const ISignal& sig)
+        {
+            _os << "static inline double dbcppp_" << _name << "_" << sig.Name() << "_raw_to_phys(" << c_type(sig) << " raw)\n"
+                << "{\n"
+                << "    return (double)raw * " << literal(sig.Factor()) << " + " << literal(sig.Offset()) << ";\n"
+                << "}\n";
+        }
+        // The physical value is limited to the signal's minimum and maximum (if the DBC defines them)
+        // and the raw value to the range the signal's bits can hold.
+        void PhysToRaw(const ISignal& sig)
+        {
+            std::string type = c_type(sig);
+            _os << "static inline " << type << " dbcppp_" << _name << "_" << sig.Name() << "_phys_to_raw(double phys)\n"
+                << "{\n";
+            if (sig.Factor() == 0.)
+            {
+                _os << "    (void)phys;\n"
+                    << "    return 0;\n"
+                    << "}\n";
+                return;
+            }
+            if (sig.Minimum() < sig.Maximum())
+            {
+                _os << "    if (phys < " << literal(sig.Minimum()) << ")\n"
+                    << "    {\n"
+                    << "        phys = " << literal(sig.Minimum()) << ";\n"
+                    << "    }\n"
+                    << "    if (phys > " << literal(sig.Maximum()) << ")\n"
+                    << "    {\n"
+                    << "        phys = " << literal(sig.Maximum()) << ";\n"
+                    << "    }\n";
+            }
+            if (is_float(sig))
+            {
+                _os << "    return (" << type << ")((phys - " << literal(sig.Offset()) << ") / " << literal(sig.Factor()) << ");\n"
+                    << "}\n";
+                return;
+            }
+            uint64_t bits = std::clamp<uint64_t>(sig.BitSize(), 1, 64);
+            std::string min, max;
+            double dmin, dmax;
+            if (is_signed(sig))
+            {
+                int64_t limit = bits == 64 ? std::numeric_limits<int64_t>::max() : int64_t((1ull << (bits - 1)) - 1);
+                min = bits == 64 ? "INT64_MIN" : "-" + std::to_string(limit) + " - 1";
+                max = bits == 64 ? "INT64_MAX" : std::to_string(limit);
+                dmin = -double(limit) - 1.;
+                dmax = double(limit);
+            }
+            else
+            {
+                uint64_t limit = bits == 64 ? std::numeric_limits<uint64_t>::max() : (1ull << bits) - 1;
+                min = "0";
+                max = bits == 64 ? "UINT64_MAX" : integer(limit);
+                dmin = 0.;
+                dmax = double(limit);
+            }
+            _os << "    double raw = (phys - " << literal(sig.Offset()) << ") / " << literal(sig.Factor()) << ";\n"
+                << "    if (raw <= " << literal(dmin) << ")\n"
+                << "    {\n"
+                << "        return " << min << ";\n"
+                << "    }\n"
+                << "    if (raw >= " << literal(dmax) << ")\n"
+                << "    {\n"
+                << "        return " << max << ";\n"
+                << "    }\n";
+            if (is_signed(sig))
+            {
+                _os << "    return (" << type << ")(raw < 0.0 ? raw - 0.5 : raw + 0.5);\n";
+            }
+            else
+            {
+                _os << "    return (" << type << ")(raw + 0.5);\n";
+            }
+            _os << "}\n";
+        }
+
+        std::ostream& _os;
+        const IMessage& _msg;
+        std::string _name;
+        uint64_t _size;
+        // signals with the condition under which they are present, "" for always
+        std::vector<std::pair<std::string, std::vector<const ISignal*>>> _groups;
+    };
+}
+
+DBCPPP_API std::ostream& dbcppp::Network2C::operator<<(std::ostream& os, const INetwork& net)
+{
+    auto messages = message_names(net);
+    std::set<uint64_t> ids;
+
+    os << "/* Generated by dbcppp, do not edit. */\n"
+       << "#ifndef DBCPPP_GENERATED_H\n"
+       << "#define DBCPPP_GENERATED_H\n"
+       << "\n"
+       << "#include <stdint.h>\n"
+       << "#include <string.h>\n"
+       << "\n"
+       << "/*\n"
+       << " * For every message:\n"
+       << " *   struct dbcppp_<message> holds the raw values of the signals,\n"
+       << " *   dbcppp_<message>_unpack(msg, data, len) returns 0 or -1 if len is too short,\n"
+       << " *   dbcppp_<message>_pack(data, len, msg) returns the number of bytes written or -1 if len is too short,\n"
+       << " *   dbcppp_<message>_<signal>_raw_to_phys and _phys_to_raw convert single values.\n"
+       << " * Multiplexed signals are only unpacked and packed if the frame contains them.\n"
+       << " */\n";
+    for (auto& [msg, name] : messages)
+    {
+        MessageGenerator gen(os, *msg, name);
+        os << "\n";
+        gen.Struct();
+        gen.Unpack();
+        gen.Pack();
+        gen.Conversions();
+    }
+
+    os << "\n"
+       << "union dbcppp_message\n"
+       << "{\n";
+    for (auto& [msg, name] : messages)
+    {
+        os << "    struct dbcppp_" << name << " " << name << ";\n";
+    }
+    if (messages.empty())
+    {
+        os << "    char dbcppp_empty;\n";
+    }
+    os << "};\n";
+
+    // the first message wins if two messages share an id
+    std::vector<std::pair<const IMessage*, std::string>> dispatched;
+    for (auto& [msg, name] : messages)
+    {
+        if (ids.insert(msg->Id()).second)
+        {
+            dispatched.push_back({msg, name});
         }
     }
+    auto dispatcher =
+        [&](const char* func, const char* params, const char* args)
+        {
+            os << "static inline int dbcppp_" << func << "_message(uint64_t id, " << params << ")\n"
+               << "{\n"
+               << "    switch (id)\n"
+               << "    {\n";
+            for (auto& [msg, name] : dispatched)
+            {
+                os << "    case " << hex(msg->Id()) << ": return dbcppp_" << name << "_" << func << "(" << args
+                   << name << (std::string(func) == "unpack" ? ", data, len);\n" : ");\n");
+            }
+            os << "    default: return -2;\n"
+               << "    }\n"
+               << "}\n";
+        };
+    os << "/* the id is the message id of the DBC, -2 is returned for unknown ids */\n";
+    dispatcher("unpack", "union dbcppp_message* msg, const uint8_t* data, uint8_t len", "&msg->");
+    dispatcher("pack", "uint8_t* data, uint8_t len, const union dbcppp_message* msg", "data, len, &msg->");
+    os << "\n"
+       << "#endif\n";
     return os;
 }
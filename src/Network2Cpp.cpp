@@ -0,0 +1,373 @@
+
+#include <set>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "dbcppp/Network.h"
+#include "dbcppp/Network2Functions.h"
+#include "CodeGenerator.h"
+
+using namespace dbcppp;
+using namespace dbcppp::Network2Cpp;
+using namespace dbcppp::CodeGenerator;
+
+static const char* header = R"(// Generated by dbcppp, do not edit.
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+namespace dbcppp_generated
+{
+    enum class ByteOrder { LittleEndian, BigEndian };
+    enum class ValueType { Unsigned, Signed, Float, Double };
+
+    namespace detail
+    {
+        // the bits of a signal which lie in one byte of the frame
+        struct Segment
+        {
+            std::size_t byte;
+            uint64_t lsb;
+            uint64_t width;
+            uint64_t shift;
+        };
+        constexpr std::size_t segment_count(uint64_t start_bit, uint64_t bit_size, ByteOrder order)
+        {
+            uint64_t first = order == ByteOrder::LittleEndian ? 8 - start_bit % 8 : start_bit % 8 + 1;
+            return bit_size == 0 ? 0 : bit_size <= first ? 1 : 1 + (bit_size - first + 7) / 8;
+        }
+        template <uint64_t StartBit, uint64_t BitSize, ByteOrder Order>
+        constexpr std::array<Segment, segment_count(StartBit, BitSize, Order)> make_segments()
+        {
+            std::array<Segment, segment_count(StartBit, BitSize, Order)> result{};
+            uint64_t remaining = BitSize;
+            std::size_t byte = StartBit / 8;
+            uint64_t bit = StartBit % 8;
+            for (std::size_t i = 0; i < result.size(); i++)
+            {
+                if constexpr (Order == ByteOrder::LittleEndian)
+                {
+                    // the start bit is the least significant bit
+                    uint64_t width = 8 - bit < remaining ? 8 - bit : remaining;
+                    result[i] = Segment{byte, bit, width, BitSize - remaining};
+                    remaining -= width;
+                    bit = 0;
+                }
+                else
+                {
+                    // the start bit is the most significant bit
+                    uint64_t width = bit + 1 < remaining ? bit + 1 : remaining;
+                    remaining -= width;
+                    result[i] = Segment{byte, bit + 1 - width, width, remaining};
+                    bit = 7;
+                }
+                byte++;
+            }
+            return result;
+        }
+        constexpr uint64_t mask(uint64_t width)
+        {
+            return width >= 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+        }
+        template <uint64_t BitSize, ValueType Type>
+        struct RawType
+        {
+            using unsigned_type =
+                std::conditional_t<(BitSize <= 8), uint8_t,
+                std::conditional_t<(BitSize <= 16), uint16_t,
+                std::conditional_t<(BitSize <= 32), uint32_t, uint64_t>>>;
+            using type =
+                std::conditional_t<Type == ValueType::Float, float,
+                std::conditional_t<Type == ValueType::Double, double,
+                std::conditional_t<Type == ValueType::Signed, std::make_signed_t<unsigned_type>, unsigned_type>>>;
+        };
+    }
+
+    // A signal's position in the frame and the conversion of its raw value. Derived provides
+    // factor, offset, minimum and maximum. Since the layout is known at compile time, decode and
+    // encode compile to straight shift and mask code without any dispatching.
+    template <class Derived, uint64_t StartBit, uint64_t BitSize, ByteOrder Order, ValueType Type>
+    struct Signal
+    {
+        using raw_type = typename detail::RawType<BitSize, Type>::type;
+        static constexpr uint64_t start_bit = StartBit;
+        static constexpr uint64_t bit_size = BitSize;
+        static constexpr ByteOrder byte_order = Order;
+        static constexpr ValueType value_type = Type;
+        static constexpr auto segments = detail::make_segments<StartBit, BitSize, Order>();
+
+        static constexpr raw_type decode(const uint8_t* data) noexcept
+        {
+            uint64_t raw = extract(data, std::make_index_sequence<segments.size()>());
+            if constexpr (Type == ValueType::Float)
+            {
+                uint32_t bits = uint32_t(raw);
+                float result = 0.f;
+                std::memcpy(&result, &bits, sizeof(result));
+                return result;
+            }
+            else if constexpr (Type == ValueType::Double)
+            {
+                double result = 0.;
+                std::memcpy(&result, &raw, sizeof(result));
+                return result;
+            }
+            else if constexpr (Type == ValueType::Signed && BitSize > 0 && BitSize < 64)
+            {
+                constexpr uint64_t sign = uint64_t(1) << (BitSize - 1);
+                return raw_type((raw ^ sign) - sign);
+            }
+            else
+            {
+                return raw_type(raw);
+            }
+        }
+        // only the bits of the signal are changed
+        static constexpr void encode(raw_type value, uint8_t* data) noexcept
+        {
+            uint64_t raw = 0;
+            if constexpr (Type == ValueType::Float)
+            {
+                uint32_t bits = 0;
+                std::memcpy(&bits, &value, sizeof(bits));
+                raw = bits;
+            }
+            else if constexpr (Type == ValueType::Double)
+            {
+                std::memcpy(&raw, &value, sizeof(raw));
+            }
+            else
+            {
+                raw = uint64_t(value);
+            }
+            insert(raw, data, std::make_index_sequence<segments.size()>());
+        }
+        static constexpr double raw_to_phys(raw_type raw) noexcept
+        {
+            return double(raw) * Derived::factor + Derived::offset;
+        }
+        // The physical value is limited to the signal's minimum and maximum (if the DBC defines them)
+        // and the raw value to the range the signal's bits can hold.
+        static constexpr raw_type phys_to_raw(double phys) noexcept
+        {
+            if constexpr (Derived::minimum < Derived::maximum)
+            {
+                phys = phys < Derived::minimum ? Derived::minimum : phys > Derived::maximum ? Derived::maximum : phys;
+            }
+            if constexpr (Derived::factor == 0.)
+            {
+                return raw_type(0);
+            }
+            else if constexpr (Type == ValueType::Float || Type == ValueType::Double)
+            {
+                return raw_type((phys - Derived::offset) / Derived::factor);
+            }
+            else
+            {
+                constexpr uint64_t bits = BitSize == 0 ? 1 : BitSize > 64 ? 64 : BitSize;
+                constexpr raw_type raw_min = Type == ValueType::Signed ? raw_type(~(detail::mask(bits) >> 1)) : raw_type(0);
+                constexpr raw_type raw_max = raw_type(Type == ValueType::Signed ? detail::mask(bits) >> 1 : detail::mask(bits));
+                double raw = (phys - Derived::offset) / Derived::factor;
+                if (raw <= double(raw_min))
+                {
+                    return raw_min;
+                }
+                if (raw >= double(raw_max))
+                {
+                    return raw_max;
+                }
+                return raw_type(raw < 0. ? raw - 0.5 : raw + 0.5);
+            }
+        }
+        static constexpr double decode_phys(const uint8_t* data) noexcept
+        {
+            return raw_to_phys(decode(data));
+        }
+        static constexpr void encode_phys(double phys, uint8_t* data) noexcept
+        {
+            encode(phys_to_raw(phys), data);
+        }
+
+    private:
+        template <std::size_t... I>
+        static constexpr uint64_t extract(const uint8_t* data, std::index_sequence<I...>) noexcept
+        {
+            return (uint64_t(0) | ... |
+                (uint64_t((data[segments[I].byte] >> segments[I].lsb) & detail::mask(segments[I].width)) << segments[I].shift));
+        }
+        template <std::size_t... I>
+        static constexpr void insert(uint64_t raw, uint8_t* data, std::index_sequence<I...>) noexcept
+        {
+            ((data[segments[I].byte] = uint8_t((data[segments[I].byte] & ~(detail::mask(segments[I].width) << segments[I].lsb))
+                | (((raw >> segments[I].shift) & detail::mask(segments[I].width)) << segments[I].lsb))), ...);
+        }
+    };
+
+    namespace messages
+    {
+)";
+
+namespace
+{
+    // nested types must not be named like their enclosing type or the message's members
+    std::string signal_type_name(const std::string& message_name, const ISignal& sig)
+    {
+        static const std::set<std::string> reserved = {"message_id", "message_name", "message_size", "signals"};
+        if (sig.Name() == message_name || reserved.count(sig.Name()))
+        {
+            return sig.Name() + "_";
+        }
+        return sig.Name();
+    }
+    const char* value_type(const ISignal& sig)
+    {
+        switch (sig.ExtendedValueType())
+        {
+        case ISignal::EExtendedValueType::Float: return "Float";
+        case ISignal::EExtendedValueType::Double: return "Double";
+        default: break;
+        }
+        return is_signed(sig) ? "Signed" : "Unsigned";
+    }
+    void generate_message(std::ostream& os, const IMessage& msg, const std::string& name)
+    {
+        os << "        // " << msg.Name() << "\n"
+           << "        struct " << name << "\n"
+           << "        {\n"
+           << "            static constexpr uint64_t message_id = " << hex(msg.Id()) << ";\n"
+           << "            static constexpr const char* message_name = \"" << msg.Name() << "\";\n"
+           << "            // number of bytes a frame must have to contain all signals\n"
+           << "            static constexpr std::size_t message_size = " << frame_size(msg) << ";\n";
+        std::string signals;
+        for (const ISignal& sig : msg.Signals())
+        {
+            std::string type = signal_type_name(name, sig);
+            std::set<const ISignal*> visited;
+            std::string condition = multiplexer_condition(msg, sig,
+                [&](const ISignal& sw) { return signal_type_name(name, sw) + "::decode(data)"; }, visited);
+            os << "\n"
+               << "            struct " << type << "\n"
+               << "                : ::dbcppp_generated::Signal<" << type << ", " << sig.StartBit() << ", " << sig.BitSize()
+               << ", ::dbcppp_generated::ByteOrder::"
+               << (sig.ByteOrder() == ISignal::EByteOrder::LittleEndian ? "LittleEndian" : "BigEndian")
+               << ", ::dbcppp_generated::ValueType::" << value_type(sig) << ">\n"
+               << "            {\n"
+               << "                static constexpr double factor = " << literal(sig.Factor()) << ";\n"
+               << "                static constexpr double offset = " << literal(sig.Offset()) << ";\n"
+               << "                static constexpr double minimum = " << literal(sig.Minimum()) << ";\n"
+               << "                static constexpr double maximum = " << literal(sig.Maximum()) << ";\n"
+               << "                // false if the multiplexer switches select other signals\n";
+            if (condition.empty())
+            {
+                os << "                static constexpr bool present(const uint8_t*) noexcept\n"
+                   << "                {\n"
+                   << "                    return true;\n"
+                   << "                }\n";
+            }
+            else
+            {
+                os << "                static constexpr bool present(const uint8_t* data) noexcept\n"
+                   << "                {\n"
+                   << "                    return " << condition << ";\n"
+                   << "                }\n";
+            }
+            os << "            };\n";
+            signals += (signals.empty() ? "" : ", ") + type;
+        }
+        os << "\n"
+           << "            using signals = std::tuple<" << signals << ">;\n"
+           << "        };\n";
+    }
+}
+
+DBCPPP_API std::ostream& dbcppp::Network2Cpp::operator<<(std::ostream& os, const INetwork& net)
+{
+    auto messages = message_names(net);
+    os << header;
+    for (const auto& [msg, name] : messages)
+    {
+        if (msg != messages.front().first)
+        {
+            os << "\n";
+        }
+        generate_message(os, *msg, name);
+    }
+    os << "    }\n";
+
+    // the first message wins if two messages share an id
+    std::set<uint64_t> ids;
+    std::vector<std::pair<const IMessage*, std::string>> dispatched;
+    for (const auto& [msg, name] : messages)
+    {
+        if (ids.insert(msg->Id()).second)
+        {
+            dispatched.push_back({msg, name});
+        }
+    }
+    std::sort(dispatched.begin(), dispatched.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first->Id() < rhs.first->Id(); });
+    os << "\n"
+       << "    // the message ids sorted ascending, message_index searches them binary\n"
+       << "    inline constexpr std::array<uint64_t, " << dispatched.size() << "> message_ids{{";
+    for (const auto& [msg, name] : dispatched)
+    {
+        os << (msg == dispatched.front().first ? "" : ", ") << hex(msg->Id());
+    }
+    os << "}};\n"
+       << "    namespace detail\n"
+       << "    {\n"
+       << "        constexpr bool is_sorted(const decltype(message_ids)& ids)\n"
+       << "        {\n"
+       << "            for (std::size_t i = 1; i < ids.size(); i++)\n"
+       << "            {\n"
+       << "                if (!(ids[i - 1] < ids[i]))\n"
+       << "                {\n"
+       << "                    return false;\n"
+       << "                }\n"
+       << "            }\n"
+       << "            return true;\n"
+       << "        }\n"
+       << "    }\n"
+       << "    static_assert(detail::is_sorted(message_ids), \"message_ids must be sorted and unique\");\n"
+       << "\n"
+       << "    // index of the id in message_ids, message_ids.size() if no message has the id\n"
+       << "    constexpr std::size_t message_index(uint64_t id) noexcept\n"
+       << "    {\n"
+       << "        std::size_t first = 0;\n"
+       << "        std::size_t last = message_ids.size();\n"
+       << "        while (first < last)\n"
+       << "        {\n"
+       << "            std::size_t mid = first + (last - first) / 2;\n"
+       << "            if (message_ids[mid] < id)\n"
+       << "            {\n"
+       << "                first = mid + 1;\n"
+       << "            }\n"
+       << "            else\n"
+       << "            {\n"
+       << "                last = mid;\n"
+       << "            }\n"
+       << "        }\n"
+       << "        return first < message_ids.size() && message_ids[first] == id ? first : message_ids.size();\n"
+       << "    }\n"
+       << "    // Calls visitor with an object of the type of the message with the id, returns false if there is none.\n"
+       << "    template <class Visitor>\n"
+       << "    constexpr bool visit(uint64_t id, Visitor&& visitor)\n"
+       << "    {\n"
+       << "        switch (message_index(id))\n"
+       << "        {\n";
+    for (std::size_t i = 0; i < dispatched.size(); i++)
+    {
+        os << "        case " << i << ": visitor(messages::" << dispatched[i].second << "{}); return true;\n";
+    }
+    os << "        default: return false;\n"
+       << "        }\n"
+       << "    }\n"
+       << "}\n";
+    return os;
+}
@@ -555,14 +555,11 @@ DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const
 }
 DBCPPP_API std::ostream& dbcppp::Network2DBC::operator<<(std::ostream& os, const IValueTable& vt)
 {
-    if (vt.ValueEncodingDescriptions_Size())
+    os << "VAL_TABLE_ " << vt.Name();
+    for (const IValueEncodingDescription& ved : vt.ValueEncodingDescriptions())
     {
-        os << "VAL_TABLE_ " << vt.Name();
-        for (const IValueEncodingDescription& ved : vt.ValueEncodingDescriptions())
-        {
-            os << " " << ved.Value() << " \"" << ved.Description() << "\"";
-        }
-        os << ";\n";
+        os << " " << ved.Value() << " \"" << ved.Description() << "\"";
     }
+    os << ";\n";
     return os;
 }
\ No newline at end of file
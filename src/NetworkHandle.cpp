@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <stdexcept>
+#include "dbcppp/NetworkHandle.h"
+
+using namespace dbcppp;
+
+NetworkSnapshot::NetworkSnapshot(std::unique_ptr<const INetwork>&& network, std::any&& attachment, uint64_t version)
+    : _network(std::move(network))
+    , _attachment(std::move(attachment))
+    , _version(version)
+{
+    _messages_by_id.reserve(_network->Messages_Size());
+    for (const IMessage& msg : _network->Messages())
+    {
+        _messages_by_id.emplace(msg.Id(), &msg);
+    }
+}
+const INetwork& NetworkSnapshot::Network() const
+{
+    return *_network;
+}
+uint64_t NetworkSnapshot::Version() const
+{
+    return _version;
+}
+const IMessage* NetworkSnapshot::MessageById(uint64_t id) const
+{
+    auto iter = _messages_by_id.find(id);
+    return iter != _messages_by_id.end() ? iter->second : nullptr;
+}
+const std::any& NetworkSnapshot::Attachment() const
+{
+    return _attachment;
+}
+
+NetworkHandle::Reader::Reader(NetworkHandle& handle, Slot& slot)
+    : _handle(&handle)
+    , _slot(&slot)
+{}
+NetworkHandle::Reader::Reader(Reader&& other) noexcept
+    : _handle(other._handle)
+    , _slot(other._slot)
+{
+    other._slot = nullptr;
+}
+NetworkHandle::Reader::~Reader()
+{
+    if (_slot)
+    {
+        _slot->used.store(false, std::memory_order_release);
+    }
+}
+
+NetworkHandle::NetworkHandle(std::size_t max_readers)
+    : _slots(std::make_unique<Slot[]>(max_readers))
+    , _max_readers(max_readers)
+{}
+NetworkHandle::~NetworkHandle()
+{
+    delete _current.load();
+    for (const auto& retired : _retired)
+    {
+        delete retired.snapshot;
+    }
+}
+NetworkHandle::Reader NetworkHandle::CreateReader()
+{
+    for (std::size_t i = 0; i < _max_readers; i++)
+    {
+        if (!_slots[i].used.exchange(true, std::memory_order_acquire))
+        {
+            return Reader(*this, _slots[i]);
+        }
+    }
+    throw std::runtime_error("NetworkHandle: all " + std::to_string(_max_readers) + " reader slots are in use");
+}
+uint64_t NetworkHandle::Publish(std::unique_ptr<const INetwork>&& network, std::any attachment)
+{
+    std::lock_guard<std::mutex> lock(_writer_mutex);
+    auto snapshot = std::make_unique<NetworkSnapshot>(std::move(network), std::move(attachment), ++_version);
+    auto old = _current.exchange(snapshot.release());
+    // a reader which still got the old snapshot entered at most this epoch
+    auto epoch = _epoch.fetch_add(1);
+    if (old)
+    {
+        _retired.push_back({old, epoch});
+    }
+    ReclaimLocked();
+    return _version;
+}
+std::size_t NetworkHandle::Reclaim()
+{
+    std::lock_guard<std::mutex> lock(_writer_mutex);
+    return ReclaimLocked();
+}
+std::size_t NetworkHandle::ReclaimLocked()
+{
+    uint64_t min_epoch = Slot::idle;
+    for (std::size_t i = 0; i < _max_readers; i++)
+    {
+        min_epoch = std::min(min_epoch, _slots[i].epoch.load());
+    }
+    auto iter = std::remove_if(_retired.begin(), _retired.end(),
+        [&](const Retired& retired)
+        {
+            if (retired.epoch < min_epoch)
+            {
+                delete retired.snapshot;
+                return true;
+            }
+            return false;
+        });
+    _retired.erase(iter, _retired.end());
+    return _retired.size();
+}
+
+NetworkRegistry::NetworkRegistry(std::size_t max_readers)
+    : _max_readers(max_readers)
+{}
+NetworkHandle& NetworkRegistry::Handle(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& handle = _handles[name];
+    if (!handle)
+    {
+        handle = std::make_unique<NetworkHandle>(_max_readers);
+    }
+    return *handle;
+}
+NetworkHandle* NetworkRegistry::Find(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto iter = _handles.find(name);
+    return iter != _handles.end() ? iter->second.get() : nullptr;
+}
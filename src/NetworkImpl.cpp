@@ -1,9 +1,13 @@
 #include <algorithm>
 #include <fstream>
 #include <iomanip>
+#include <optional>
 #include "dbcppp/Network.h"
 #include "NetworkImpl.h"
+#include "LoadStatsRecorder.h"
+#include "MemoryCounter.h"
 #include "Helper.h"
+#include "Parallel.h"
 
 using namespace dbcppp;
 
@@ -198,85 +202,282 @@ const IMessage* NetworkImpl::ParentMessage(const ISignal* sig) const
     }
     return parent;
 }
+const IMessage* NetworkImpl::MessageById(uint64_t id) const
+{
+    const auto& index = _message_index.Get(
+        [&]
+        {
+            MessageIndex::map_t result;
+            result.reserve(_messages.size());
+            for (const auto& msg : _messages)
+            {
+                result.emplace(msg.Id(), &msg);
+            }
+            return result;
+        });
+    auto iter = index.find(id);
+    return iter != index.end() ? iter->second : nullptr;
+}
+namespace
+{
+    // the PGN index holds every message under its PGN and source address and, if it's the first one with
+    // the PGN, under the PGN alone
+    uint64_t pgn_key(uint32_t pgn)
+    {
+        return uint64_t(1) << 32 | pgn;
+    }
+    uint64_t pgn_source_key(uint32_t pgn, uint8_t source)
+    {
+        return uint64_t(pgn) << 8 | source;
+    }
+}
+const IMessage* NetworkImpl::MessageByJ1939Id(uint32_t can_id, J1939::Id* id) const
+{
+    const auto& index = _pgn_index.Get(
+        [&]
+        {
+            MessageIndex::map_t result;
+            for (const auto& msg : _messages)
+            {
+                if (msg.Id() & 0x80000000)
+                {
+                    J1939::Id msg_id = J1939::ParseId(uint32_t(msg.Id()));
+                    result.emplace(pgn_source_key(msg_id.pgn, msg_id.source), &msg);
+                    result.emplace(pgn_key(msg_id.pgn), &msg);
+                }
+            }
+            return result;
+        });
+    J1939::Id parsed = J1939::ParseId(can_id);
+    if (id)
+    {
+        *id = parsed;
+    }
+    auto iter = index.find(pgn_source_key(parsed.pgn, parsed.source));
+    if (iter == index.end())
+    {
+        iter = index.find(pgn_key(parsed.pgn));
+    }
+    return iter != index.end() ? iter->second : nullptr;
+}
+MemoryUsageBreakdown NetworkImpl::MemoryUsage() const
+{
+    MemoryCounter counter;
+    CountMemory(counter);
+    return counter.Breakdown();
+}
+void NetworkImpl::CountMemory(MemoryCounter& counter) const
+{
+    using EEntity = MemoryCounter::EEntity;
+    using ECategory = MemoryCounter::ECategory;
+    counter.Objects(EEntity::Network, 1, sizeof(NetworkImpl));
+    counter.Add(EEntity::Network, ECategory::Other, _version);
+    counter.Add(EEntity::Network, ECategory::Other, _new_symbols);
+    counter.Add(EEntity::Network, ECategory::Comments, _comment);
+    counter.Objects(EEntity::Nodes, _nodes);
+    counter.Objects(EEntity::ValueTables, _value_tables);
+    // every message has its own allocation which holds the message and the shared_ptr control block
+    counter.Objects(EEntity::Messages, _messages.size(), sizeof(MessageImpl) + 2 * sizeof(long));
+    counter.Add(EEntity::Messages, ECategory::Indices, _messages.capacity() * sizeof(std::shared_ptr<MessageImpl>));
+    for (const auto& msg : _messages)
+    {
+        msg.CountMemory(counter);
+    }
+    counter.Objects(EEntity::EnvironmentVariables, _environment_variables);
+    counter.Objects(EEntity::AttributeDefinitions, _attribute_definitions);
+    counter.Objects(EEntity::Attributes, _attribute_defaults);
+    counter.Objects(EEntity::Attributes, _attribute_values);
+    counter.Add(EEntity::Network, ECategory::Indices, _message_index.HeapBytes());
+    counter.Add(EEntity::Network, ECategory::Indices, _pgn_index.HeapBytes());
+}
+uint64_t MessageIndex::HeapBytes() const
+{
+    auto index = std::atomic_load_explicit(&_index, std::memory_order_acquire);
+    if (!index)
+    {
+        return 0;
+    }
+    // the map and its control block, the buckets and one node (next pointer and entry) per message
+    return sizeof(map_t) + 2 * sizeof(long)
+        + index->bucket_count() * sizeof(void*)
+        + index->size() * (sizeof(void*) + sizeof(map_t::value_type));
+}
 std::string& NetworkImpl::version()
 {
+    _fingerprint.Reset();
     return _version;
 }
 std::vector<std::string>& NetworkImpl::newSymbols()
 {
+    _fingerprint.Reset();
     return _new_symbols;
 }
 BitTimingImpl& NetworkImpl::bitTiming()
 {
+    _fingerprint.Reset();
     return _bit_timing;
 }
 std::vector<NodeImpl>& NetworkImpl::nodes()
 {
+    _fingerprint.Reset();
     return _nodes;
 }
 std::vector<ValueTableImpl>& NetworkImpl::valueTables()
 {
+    _fingerprint.Reset();
     return _value_tables;
 }
-std::vector<MessageImpl>& NetworkImpl::messages()
+cow_vector<MessageImpl>& NetworkImpl::messages()
 {
+    _fingerprint.Reset();
+    _message_index.Reset();
+    _pgn_index.Reset();
     return _messages;
 }
 std::vector<EnvironmentVariableImpl>& NetworkImpl::environmentVariables()
 {
+    _fingerprint.Reset();
     return _environment_variables;
 }
 std::vector<AttributeDefinitionImpl>& NetworkImpl::attributeDefinitions()
 {
+    _fingerprint.Reset();
     return _attribute_definitions;
 }
 std::vector<AttributeImpl>& NetworkImpl::attributeDefaults()
 {
+    _fingerprint.Reset();
     return _attribute_defaults;
 }
 std::vector<AttributeImpl>& NetworkImpl::attributeValues()
 {
+    _fingerprint.Reset();
     return _attribute_values;
 }
 std::string& NetworkImpl::comment()
 {
+    _fingerprint.Reset();
     return _comment;
 }
+namespace
+{
+    // Keeps the indices of the merged network, so merging many networks into it
+    // only indexes each of its elements once.
+    class NetworkMerger
+    {
+    public:
+        NetworkMerger(NetworkImpl& net)
+            : _new_symbols(net.newSymbols())
+            , _nodes(net.nodes())
+            , _value_tables(net.valueTables())
+            , _messages(net.messages())
+            , _environment_variables(net.environmentVariables())
+            , _attribute_definitions(net.attributeDefinitions())
+            , _attribute_defaults(net.attributeDefaults())
+            , _attribute_values(net.attributeValues())
+        {
+            _message_indices.reserve(_messages.size());
+            for (std::size_t i = 0; i < _messages.size(); i++)
+            {
+                // first message wins, like a linear search would find it
+                _message_indices.emplace(_messages[i].Id(), i);
+            }
+        }
+        void Merge(NetworkImpl& o)
+        {
+            _new_symbols.merge(o.newSymbols(), keep_existing<std::string>);
+            _nodes.merge(o.nodes(), replace_existing<NodeImpl>);
+            _value_tables.merge(o.valueTables(), replace_existing<ValueTableImpl>);
+            // merge message by id, messages which are new to the network are shared instead of copied
+            auto& messages = o.messages();
+            for (std::size_t i = 0; i < messages.size(); i++)
+            {
+                auto iter = _message_indices.find(messages[i].Id());
+                if (iter != _message_indices.end())
+                {
+                    _messages.mut(iter->second).Merge(std::move(messages.mut(i)));
+                }
+                else
+                {
+                    _message_indices.emplace(messages[i].Id(), _messages.size());
+                    _messages.push_back(messages.shared(i));
+                }
+            }
+            _environment_variables.merge(o.environmentVariables(), replace_existing<EnvironmentVariableImpl>);
+            _attribute_definitions.merge(o.attributeDefinitions(), replace_existing<AttributeDefinitionImpl>);
+            _attribute_defaults.merge(o.attributeDefaults(), replace_existing<AttributeImpl>);
+            _attribute_values.merge(o.attributeValues(), replace_existing<AttributeImpl>);
+        }
+
+    private:
+        merge_index<std::string, by_value> _new_symbols;
+        merge_index<NodeImpl, by_name> _nodes;
+        merge_index<ValueTableImpl, by_name> _value_tables;
+        cow_vector<MessageImpl>& _messages;
+        std::unordered_map<uint64_t, std::size_t> _message_indices;
+        merge_index<EnvironmentVariableImpl, by_name> _environment_variables;
+        merge_index<AttributeDefinitionImpl, by_name> _attribute_definitions;
+        merge_index<AttributeImpl, by_name> _attribute_defaults;
+        merge_index<AttributeImpl, by_name> _attribute_values;
+    };
+}
 void INetwork::Merge(std::unique_ptr<INetwork>&& other)
 {
     auto& self = static_cast<NetworkImpl&>(*this);
-    auto& o = static_cast<NetworkImpl&>(*other);
-
-    unique_merge(self.newSymbols(), o.newSymbols());
-    unique_merge_by_name(self.nodes(), o.nodes());
-    unique_merge_by_name(self.valueTables(), o.valueTables());
-
-    // merge message by id
-    for (MessageImpl& item2 : o.messages()) {
-        auto it = std::find_if(self.messages().begin(), self.messages().end(), [&item2](const MessageImpl& item1) {
-            return item1.Id() == item2.Id();
-        });
-        if (it != self.messages().end()) {
-            // merge it
-            it->Merge(std::move(item2));
-        } else {
-            // insert new
-            self.messages().push_back(std::move(item2));
+    NetworkMerger(self).Merge(static_cast<NetworkImpl&>(*other));
+    other.reset(nullptr);
+}
+std::unique_ptr<INetwork> INetwork::MergeAll(std::vector<std::unique_ptr<INetwork>>&& networks)
+{
+    std::unique_ptr<INetwork> result;
+    std::optional<NetworkMerger> merger;
+    for (auto& network : networks)
+    {
+        if (!network)
+        {
+            continue;
         }
+        if (!result)
+        {
+            result = std::move(network);
+            merger.emplace(static_cast<NetworkImpl&>(*result));
+            continue;
+        }
+        merger->Merge(static_cast<NetworkImpl&>(*network));
+        network.reset(nullptr);
     }
-
-    unique_merge_by_name(self.environmentVariables(), o.environmentVariables());
-    unique_merge_by_name(self.attributeDefinitions(), o.attributeDefinitions());
-    unique_merge_by_name(self.attributeDefaults(), o.attributeDefaults());
-    unique_merge_by_name(self.attributeValues(), o.attributeValues());
-
-    other.reset(nullptr);
+    networks.clear();
+    return result;
+}
+Hash128 NetworkImpl::Fingerprint() const
+{
+    return _fingerprint.Get(
+        [this]()
+        {
+            Hasher hasher;
+            hasher.Add(_version);
+            hasher.AddUnordered(_new_symbols);
+            hasher.Add(fingerprint(_bit_timing));
+            hasher.AddUnordered(_nodes);
+            hasher.AddUnordered(_value_tables);
+            hasher.AddUnordered(_messages);
+            hasher.AddUnordered(_environment_variables);
+            hasher.AddUnordered(_attribute_definitions);
+            hasher.AddUnordered(_attribute_defaults);
+            hasher.AddUnordered(_attribute_values);
+            hasher.Add(_comment);
+            return hasher.Finish();
+        });
 }
 bool NetworkImpl::operator==(const INetwork& rhs) const
 {
+    if (Fingerprint() != rhs.Fingerprint())
+    {
+        return false;
+    }
     bool equal = true;
     equal &= _version == rhs.Version();
-    for (const auto& new_symbol : _new_symbols)
+    for (const auto& new_symbol : rhs.NewSymbols())
     {
         equal &= std::find(_new_symbols.begin(), _new_symbols.end(), new_symbol) != _new_symbols.end();
     }
@@ -319,19 +520,22 @@ bool NetworkImpl::operator!=(const INetwork& rhs) const
 
 std::unique_ptr<INetwork> INetwork::LoadNetworkFromFile(const std::filesystem::path& filename)
 {
-    auto is = std::ifstream(filename);
-    if (!is.is_open())
+    std::string error_message;
+    auto network = LoadNetworkFromFile(filename, error_message);
+    // the message of a file which can't be opened already ends with a newline, the ones of parse errors don't
+    if (!network && !error_message.empty())
     {
-        std::cout << "Error: Could not open file " << filename << "\n";
+        std::cerr << error_message << (error_message.back() == '\n' ? "" : "\n") << std::flush;
     }
-    else if (filename.extension() == ".dbc")
-    {
-        return LoadDBCFromIs(is);
-    }
-    return nullptr;
+    return network;
 }
 
 std::unique_ptr<INetwork> INetwork::LoadNetworkFromFile(const std::filesystem::path& filename, std::string& error_message)
+{
+    return LoadNetworkFromFile(filename, LoadOptions(), error_message);
+}
+
+std::unique_ptr<INetwork> INetwork::LoadNetworkFromFile(const std::filesystem::path& filename, const LoadOptions& options, std::string& error_message)
 {
     auto is = std::ifstream(filename);
     if (!is.is_open())
@@ -340,7 +544,39 @@ std::unique_ptr<INetwork> INetwork::LoadNetworkFromFile(const std::filesystem::p
     }
     else if (filename.extension() == ".dbc")
     {
-        return LoadDBCFromIs(is, error_message);
+        return LoadDBCFromIs(is, options, error_message);
     }
     return nullptr;
+}
+std::unique_ptr<INetwork> INetwork::LoadNetworksFromFiles(
+      const std::vector<std::filesystem::path>& filenames
+    , const LoadOptions& options
+    , std::vector<std::string>& error_messages)
+{
+    LoadStatsRecorder recorder(options.stats);
+    std::vector<std::unique_ptr<INetwork>> networks(filenames.size());
+    error_messages.assign(filenames.size(), std::string());
+    // the files are distributed over the threads, so each of them is parsed sequentially
+    LoadOptions file_options = options;
+    file_options.threads = 1;
+    file_options.stats = nullptr;
+    parallel_for(filenames.size(), options.threads,
+        [&](std::size_t i)
+        {
+            networks[i] = LoadNetworkFromFile(filenames[i], file_options, error_messages[i]);
+            if (!networks[i] && error_messages[i].empty())
+            {
+                error_messages[i] = "Error: Unsupported file type " + filenames[i].string() + "\n";
+            }
+        });
+    recorder.Phase("load files");
+    if (std::any_of(networks.begin(), networks.end(), [](const auto& network) { return !network; }))
+    {
+        recorder.Finish(nullptr);
+        return nullptr;
+    }
+    auto network = MergeAll(std::move(networks));
+    recorder.Phase("merge");
+    recorder.Finish(network.get());
+    return network;
 }
\ No newline at end of file
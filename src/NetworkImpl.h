@@ -1,5 +1,8 @@
 #pragma once
 
+#include <memory>
+#include <unordered_map>
+
 #include "dbcppp/Network.h"
 #include "BitTimingImpl.h"
 #include "ValueTableImpl.h"
@@ -8,9 +11,54 @@
 #include "SignalTypeImpl.h"
 #include "AttributeDefinitionImpl.h"
 #include "AttributeImpl.h"
+#include "Fingerprint.h"
+#include "CowVector.h"
 
 namespace dbcppp
 {
+    class MemoryCounter;
+
+    // Lazily built id (or PGN) -> message index. Copies start empty since the pointers belong to the messages of the copied network.
+    class MessageIndex
+    {
+    public:
+        using map_t = std::unordered_map<uint64_t, const MessageImpl*>;
+
+        MessageIndex() = default;
+        MessageIndex(const MessageIndex&) {}
+        MessageIndex& operator=(const MessageIndex&)
+        {
+            Reset();
+            return *this;
+        }
+
+        template <class Func>
+        const map_t& Get(Func&& build) const
+        {
+            auto index = std::atomic_load_explicit(&_index, std::memory_order_acquire);
+            if (!index)
+            {
+                // threads which build it concurrently all return the index of the first one which publishes it,
+                // so no index a caller got is ever replaced
+                auto built = std::make_shared<const map_t>(build());
+                if (std::atomic_compare_exchange_strong_explicit(&_index, &index, built
+                    , std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    index = std::move(built);
+                }
+            }
+            return *index;
+        }
+        void Reset()
+        {
+            std::atomic_store_explicit(&_index, std::shared_ptr<const map_t>(), std::memory_order_release);
+        }
+        // 0 if the index isn't built
+        uint64_t HeapBytes() const;
+
+    private:
+        mutable std::shared_ptr<const map_t> _index;
+    };
     class NetworkImpl final
         : public INetwork
     {
@@ -51,7 +99,12 @@ namespace dbcppp
         virtual const std::string& Comment() const override;
         
         virtual const IMessage* ParentMessage(const ISignal* sig) const override;
+        virtual const IMessage* MessageById(uint64_t id) const override;
+        virtual const IMessage* MessageByJ1939Id(uint32_t can_id, J1939::Id* id) const override;
+        virtual MemoryUsageBreakdown MemoryUsage() const override;
         
+        virtual Hash128 Fingerprint() const override;
+
         virtual bool operator==(const INetwork& rhs) const override;
         virtual bool operator!=(const INetwork& rhs) const override;
 
@@ -60,24 +113,30 @@ namespace dbcppp
         BitTimingImpl& bitTiming();
         std::vector<NodeImpl>& nodes();
         std::vector<ValueTableImpl>& valueTables();
-        std::vector<MessageImpl>& messages();
+        // the messages are shared with the clones of the network, see cow_vector::mut
+        cow_vector<MessageImpl>& messages();
         std::vector<EnvironmentVariableImpl>& environmentVariables();
         std::vector<AttributeDefinitionImpl>& attributeDefinitions();
         std::vector<AttributeImpl>& attributeDefaults();
         std::vector<AttributeImpl>& attributeValues();
         std::string& comment();
 
+        void CountMemory(MemoryCounter& counter) const;
+
     private:
         std::string _version;
         std::vector<std::string> _new_symbols;
         BitTimingImpl _bit_timing;
         std::vector<NodeImpl> _nodes;
         std::vector<ValueTableImpl> _value_tables;
-        std::vector<MessageImpl> _messages;
+        cow_vector<MessageImpl> _messages;
         std::vector<EnvironmentVariableImpl> _environment_variables;
         std::vector<AttributeDefinitionImpl> _attribute_definitions;
         std::vector<AttributeImpl> _attribute_defaults;
         std::vector<AttributeImpl> _attribute_values;
         std::string _comment;
+        FingerprintCache _fingerprint;
+        MessageIndex _message_index;
+        MessageIndex _pgn_index;
     };
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include "NodeImpl.h"
+#include "MemoryCounter.h"
 
 using namespace dbcppp;
 
@@ -45,6 +46,14 @@ uint64_t NodeImpl::AttributeValues_Size() const
 {
     return _attribute_values.size();
 }
+std::vector<AttributeImpl>& NodeImpl::attributeValues()
+{
+    return _attribute_values;
+}
+std::string& NodeImpl::comment()
+{
+    return _comment;
+}
 bool NodeImpl::operator==(const INode& rhs) const
 {
     bool equal = true;
@@ -61,4 +70,12 @@ bool NodeImpl::operator==(const INode& rhs) const
 bool NodeImpl::operator!=(const INode& rhs) const
 {
     return !(*this == rhs);
-}
\ No newline at end of file
+}
+void NodeImpl::CountMemory(MemoryCounter& counter) const
+{
+    using EEntity = MemoryCounter::EEntity;
+    using ECategory = MemoryCounter::ECategory;
+    counter.Add(EEntity::Nodes, ECategory::Names, _name);
+    counter.Add(EEntity::Nodes, ECategory::Comments, _comment);
+    counter.Objects(EEntity::Attributes, _attribute_values);
+}
@@ -8,6 +8,8 @@
 
 namespace dbcppp
 {
+    class MemoryCounter;
+
     class NodeImpl final
         : public INode
     {
@@ -24,9 +26,14 @@ namespace dbcppp
         virtual uint64_t AttributeValues_Size() const override;
         virtual const std::string& Comment() const override;
         
+        std::vector<AttributeImpl>& attributeValues();
+        std::string& comment();
+        
         virtual bool operator==(const INode& rhs) const override;
         virtual bool operator!=(const INode& rhs) const override;
 
+        void CountMemory(MemoryCounter& counter) const;
+
     private:
         std::string _name;
         std::string _comment;
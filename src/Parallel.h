@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <algorithm>
+
+namespace dbcppp
+{
+    // 0 selects one thread per hardware thread
+    inline std::size_t resolve_thread_count(std::size_t threads)
+    {
+        if (threads == 0)
+        {
+            threads = std::thread::hardware_concurrency();
+        }
+        return threads != 0 ? threads : 1;
+    }
+    // Calls func(i) for every i in [0, n) on up to threads threads, the calling thread included.
+    // The indices are handed out one by one, so unevenly expensive work items are balanced.
+    // The first exception thrown by func is rethrown once all threads have finished.
+    template <class Func>
+    void parallel_for(std::size_t n, std::size_t threads, Func&& func)
+    {
+        threads = std::min(resolve_thread_count(threads), n);
+        if (threads <= 1)
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                func(i);
+            }
+            return;
+        }
+        std::atomic<std::size_t> next{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr exception;
+        auto worker =
+            [&]()
+            {
+                try
+                {
+                    for (auto i = next++; i < n && !failed; i = next++)
+                    {
+                        func(i);
+                    }
+                }
+                catch (...)
+                {
+                    if (!failed.exchange(true))
+                    {
+                        exception = std::current_exception();
+                    }
+                }
+            };
+        // joins the threads when the workers are done, and also if starting one of them throws,
+        // destroying a joinable thread would terminate
+        struct JoinGuard
+        {
+            ~JoinGuard()
+            {
+                for (auto& thread : pool)
+                {
+                    thread.join();
+                }
+            }
+            std::vector<std::thread> pool;
+        };
+        {
+            JoinGuard guard;
+            guard.pool.reserve(threads - 1);
+            for (std::size_t i = 1; i < threads; i++)
+            {
+                guard.pool.emplace_back(worker);
+            }
+            worker();
+        }
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+}
@@ -0,0 +1,409 @@
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+
+#include "dbcppp/Predicate.h"
+#include "dbcppp/StaticSignal.h"
+
+using namespace dbcppp;
+
+namespace
+{
+    constexpr uint64_t sign_bit = 1ull << 63;
+
+    // keys of [lo, hi], empty if lo > hi
+    struct Interval
+    {
+        uint64_t lo;
+        uint64_t hi;
+
+        bool Empty() const
+        {
+            return lo > hi;
+        }
+    };
+    constexpr Interval empty_interval{1, 0};
+
+    // The keys of [min, max] for which pred holds. pred has to be monotone in the key: false up to some key and
+    // true from there on (rising) or the other way round, so binary searching the boundary is exact.
+    template <class Pred>
+    Interval holds_for(uint64_t min, uint64_t max, bool rising, Pred&& pred)
+    {
+        auto changed = [&](uint64_t key) { return pred(key) == rising; };
+        if (!changed(max))
+        {
+            return rising ? empty_interval : Interval{min, max};
+        }
+        uint64_t lo = min;
+        uint64_t hi = max;
+        while (lo < hi)
+        {
+            uint64_t mid = lo + (hi - lo) / 2;
+            if (changed(mid))
+            {
+                hi = mid;
+            }
+            else
+            {
+                lo = mid + 1;
+            }
+        }
+        if (rising)
+        {
+            return {lo, max};
+        }
+        return lo == min ? empty_interval : Interval{min, lo - 1};
+    }
+
+    class Parser
+    {
+    public:
+        Parser(const IMessage& msg, const std::string& expression)
+            : _msg(msg)
+            , _expression(expression)
+        {}
+
+        bool Parse(std::vector<std::vector<Predicate::Comparison>>& any_of, std::string& error_message)
+        {
+            any_of.emplace_back();
+            while (true)
+            {
+                Predicate::Comparison comparison;
+                if (!ParseComparison(comparison, error_message))
+                {
+                    return false;
+                }
+                any_of.back().push_back(comparison);
+                SkipSpace();
+                if (_pos == _expression.size())
+                {
+                    return true;
+                }
+                if (Consume("||"))
+                {
+                    any_of.emplace_back();
+                }
+                else if (!Consume("&&"))
+                {
+                    return Error("expected && or ||", error_message);
+                }
+            }
+        }
+
+    private:
+        bool ParseComparison(Predicate::Comparison& comparison, std::string& error_message)
+        {
+            SkipSpace();
+            std::size_t begin = _pos;
+            while (_pos < _expression.size() && (std::isalnum(uint8_t(_expression[_pos])) || _expression[_pos] == '_'))
+            {
+                _pos++;
+            }
+            if (begin == _pos)
+            {
+                return Error("expected a signal name", error_message);
+            }
+            std::string name = _expression.substr(begin, _pos - begin);
+            comparison.signal = nullptr;
+            for (const ISignal& sig : _msg.Signals())
+            {
+                if (sig.Name() == name)
+                {
+                    comparison.signal = &sig;
+                    break;
+                }
+            }
+            if (!comparison.signal)
+            {
+                _pos = begin;
+                return Error("unknown signal \"" + name + "\"", error_message);
+            }
+            SkipSpace();
+            // the two character operators first
+            if (Consume("==")) comparison.op = Predicate::EOperator::Equal;
+            else if (Consume("!=")) comparison.op = Predicate::EOperator::NotEqual;
+            else if (Consume("<=")) comparison.op = Predicate::EOperator::LessEqual;
+            else if (Consume(">=")) comparison.op = Predicate::EOperator::GreaterEqual;
+            else if (Consume("<")) comparison.op = Predicate::EOperator::Less;
+            else if (Consume(">")) comparison.op = Predicate::EOperator::Greater;
+            else return Error("expected a comparison operator", error_message);
+            SkipSpace();
+            const char* begin_value = _expression.c_str() + _pos;
+            char* end_value = nullptr;
+            comparison.value = std::strtod(begin_value, &end_value);
+            if (end_value == begin_value)
+            {
+                return Error("expected a number", error_message);
+            }
+            _pos += end_value - begin_value;
+            return true;
+        }
+        void SkipSpace()
+        {
+            while (_pos < _expression.size() && std::isspace(uint8_t(_expression[_pos])))
+            {
+                _pos++;
+            }
+        }
+        bool Consume(const char* token)
+        {
+            std::size_t size = std::strlen(token);
+            if (_expression.compare(_pos, size, token) != 0)
+            {
+                return false;
+            }
+            _pos += size;
+            return true;
+        }
+        bool Error(const std::string& what, std::string& error_message)
+        {
+            error_message = what + " at position " + std::to_string(_pos) + " of \"" + _expression + "\"";
+            return false;
+        }
+
+        const IMessage& _msg;
+        const std::string& _expression;
+        std::size_t _pos = 0;
+    };
+}
+
+Predicate::Predicate(const IMessage& msg)
+    : _message(&msg)
+{}
+std::unique_ptr<Predicate> Predicate::Parse(const IMessage& msg, const std::string& expression, std::string& error_message)
+{
+    std::vector<std::vector<Comparison>> any_of;
+    if (!Parser(msg, expression).Parse(any_of, error_message))
+    {
+        return nullptr;
+    }
+    return Create(msg, any_of, error_message);
+}
+std::unique_ptr<Predicate> Predicate::Create(const IMessage& msg, const std::vector<std::vector<Comparison>>& any_of, std::string& error_message)
+{
+    std::unique_ptr<Predicate> result(new Predicate(msg));
+    for (const auto& all_of : any_of)
+    {
+        Conjunction conjunction{uint32_t(result->_terms.size()), 0, uint32_t(result->_decoded_terms.size()), 0, 0, 0};
+        bool never = false;
+        for (const auto& comparison : all_of)
+        {
+            std::size_t index = 0;
+            while (index < msg.Signals_Size() && &msg.Signals_Get(index) != comparison.signal)
+            {
+                index++;
+            }
+            if (index == msg.Signals_Size())
+            {
+                error_message = "the signal " + (comparison.signal ? "\"" + comparison.signal->Name() + "\" " : "")
+                    + "isn't a signal of the message \"" + msg.Name() + "\"";
+                return nullptr;
+            }
+            const ISignal& sig = *comparison.signal;
+            Term term{&sig, index, EKey::Unsigned, comparison.op == EOperator::NotEqual, 0, 0};
+            // the keys of the raw values order them like their physical values (or the other way round
+            // for negative factors), NaNs of float and double signals lie outside of [min, max]
+            uint64_t min = 0;
+            uint64_t max = 0;
+            switch (sig.ExtendedValueType())
+            {
+            case ISignal::EExtendedValueType::Integer:
+            {
+                uint64_t half = 1ull << (sig.BitSize() - 1);
+                if (sig.ValueType() == ISignal::EValueType::Signed)
+                {
+                    term.key = EKey::Signed;
+                    min = sign_bit - half;
+                    max = sign_bit + (half - 1);
+                }
+                else
+                {
+                    max = half + (half - 1);
+                }
+                break;
+            }
+            case ISignal::EExtendedValueType::Float:
+                term.key = EKey::Float;
+                min = OrderKey(EKey::Float, 0xFF800000);
+                max = OrderKey(EKey::Float, 0x7F800000);
+                break;
+            case ISignal::EExtendedValueType::Double:
+                term.key = EKey::Double;
+                min = OrderKey(EKey::Double, 0xFFF0000000000000);
+                max = OrderKey(EKey::Double, 0x7FF0000000000000);
+                break;
+            }
+            auto phys = [&](uint64_t key) { return sig.RawToPhys(RawOf(term.key, key)); };
+            double value = comparison.value;
+            bool increasing = !(sig.Factor() < 0);
+            auto at_least = [&] { return holds_for(min, max, increasing, [&](uint64_t key) { return phys(key) >= value; }); };
+            auto at_most = [&] { return holds_for(min, max, !increasing, [&](uint64_t key) { return phys(key) <= value; }); };
+            Interval interval = empty_interval;
+            switch (comparison.op)
+            {
+            case EOperator::Equal:
+            case EOperator::NotEqual:
+            {
+                Interval lower = at_least();
+                Interval upper = at_most();
+                interval = {std::max(lower.lo, upper.lo), std::min(lower.hi, upper.hi)};
+                if (lower.Empty() || upper.Empty())
+                {
+                    interval = empty_interval;
+                }
+                break;
+            }
+            case EOperator::Less:
+                interval = holds_for(min, max, !increasing, [&](uint64_t key) { return phys(key) < value; });
+                break;
+            case EOperator::LessEqual:
+                interval = at_most();
+                break;
+            case EOperator::Greater:
+                interval = holds_for(min, max, increasing, [&](uint64_t key) { return phys(key) > value; });
+                break;
+            case EOperator::GreaterEqual:
+                interval = at_least();
+                break;
+            }
+            if (interval.Empty())
+            {
+                // x != value for all x
+                if (term.negate)
+                {
+                    continue;
+                }
+                never = true;
+                break;
+            }
+            // only integer signals have no raw values outside of [min, max]
+            if (interval.lo == min && interval.hi == max && (term.key == EKey::Unsigned || term.key == EKey::Signed))
+            {
+                if (!term.negate)
+                {
+                    continue;
+                }
+                never = true;
+                break;
+            }
+            term.lo = interval.lo;
+            term.width = interval.hi - interval.lo;
+            result->_terms.push_back(term);
+            conjunction.terms++;
+
+            // equality tests of integer signals in the first 64 bits are done on the masked first word
+            bool in_first_word = make_signal_layout(sig.StartBit(), sig.BitSize(), sig.ByteOrder()).alignment
+                == Alignment::size_inbetween_first_64_bit;
+            if (comparison.op == EOperator::Equal && term.width == 0 && in_first_word
+                && (term.key == EKey::Unsigned || term.key == EKey::Signed))
+            {
+                uint8_t mask[8] = {};
+                uint8_t pattern[8] = {};
+                sig.Encode(std::numeric_limits<uint64_t>::max(), mask);
+                sig.Encode(RawOf(term.key, term.lo), pattern);
+                uint64_t word_mask;
+                uint64_t word_pattern;
+                std::memcpy(&word_mask, mask, sizeof(word_mask));
+                std::memcpy(&word_pattern, pattern, sizeof(word_pattern));
+                // overlapping signals which have to have different bits
+                if ((conjunction.pattern ^ word_pattern) & conjunction.mask & word_mask)
+                {
+                    never = true;
+                    break;
+                }
+                conjunction.mask |= word_mask;
+                conjunction.pattern |= word_pattern;
+            }
+            else
+            {
+                result->_decoded_terms.push_back(term);
+                conjunction.decoded_terms++;
+            }
+        }
+        if (never)
+        {
+            result->_terms.resize(conjunction.first_term);
+            result->_decoded_terms.resize(conjunction.first_decoded_term);
+            continue;
+        }
+        result->_conjunctions.push_back(conjunction);
+    }
+    return result;
+}
+const IMessage& Predicate::Message() const
+{
+    return *_message;
+}
+bool Predicate::Evaluate(const void* data) const
+{
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    for (const auto& conjunction : _conjunctions)
+    {
+        if ((word & conjunction.mask) != conjunction.pattern)
+        {
+            continue;
+        }
+        bool holds = true;
+        for (uint32_t i = conjunction.first_decoded_term; holds && i < conjunction.first_decoded_term + conjunction.decoded_terms; i++)
+        {
+            const Term& term = _decoded_terms[i];
+            holds = Holds(term, term.signal->Decode(data));
+        }
+        if (holds)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+bool Predicate::EvaluateRaw(const ISignal::raw_t* raw) const
+{
+    for (const auto& conjunction : _conjunctions)
+    {
+        bool holds = true;
+        for (uint32_t i = conjunction.first_term; holds && i < conjunction.first_term + conjunction.terms; i++)
+        {
+            holds = Holds(_terms[i], raw[_terms[i].index]);
+        }
+        if (holds)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+bool Predicate::Holds(const Term& term, ISignal::raw_t raw)
+{
+    return (OrderKey(term.key, raw) - term.lo <= term.width) != term.negate;
+}
+uint64_t Predicate::OrderKey(EKey key, ISignal::raw_t raw)
+{
+    switch (key)
+    {
+    case EKey::Unsigned: return raw;
+    // the raw values are sign extended
+    case EKey::Signed: return raw ^ sign_bit;
+    // the negative values have to be reversed
+    case EKey::Float:
+    {
+        uint32_t bits = uint32_t(raw);
+        return bits & 0x80000000 ? uint32_t(~bits) : bits | 0x80000000;
+    }
+    case EKey::Double: return raw & sign_bit ? ~raw : raw | sign_bit;
+    }
+    return raw;
+}
+ISignal::raw_t Predicate::RawOf(EKey key, uint64_t order_key)
+{
+    switch (key)
+    {
+    case EKey::Unsigned: return order_key;
+    case EKey::Signed: return order_key ^ sign_bit;
+    case EKey::Float: return order_key & 0x80000000 ? order_key ^ 0x80000000 : uint32_t(~order_key);
+    case EKey::Double: return order_key & sign_bit ? order_key ^ sign_bit : ~order_key;
+    }
+    return order_key;
+}
@@ -0,0 +1,232 @@
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
+
+#include "dbcppp/Projection.h"
+
+using namespace dbcppp;
+
+namespace
+{
+    // a switch which has to have one of the values for a signal to be present
+    struct Condition
+    {
+        const ISignal* sw;
+        uint32_t first_range;
+        uint32_t ranges;
+    };
+    // the conditions of the selected signals of one message, every switch a signal depends on is checked
+    // directly instead of walking the switches by name like is_present does
+    struct Compiled
+    {
+        // per selected signal the index of its first condition, the last entry ends the conditions of the last signal
+        std::vector<uint32_t> first_condition;
+        std::vector<Condition> conditions;
+        std::vector<ISignalMultiplexerValue::Range> ranges;
+    };
+    using selection_t = std::vector<std::vector<bool>>;
+
+    const ISignal* find_switch(const IMessage& msg, const std::string& name)
+    {
+        for (const ISignal& sig : msg.Signals())
+        {
+            if (sig.Name() == name)
+            {
+                return &sig;
+            }
+        }
+        return nullptr;
+    }
+    void add_switch(std::vector<const ISignal*>& switches, const ISignal* sw)
+    {
+        if (std::find(switches.begin(), switches.end(), sw) == switches.end())
+        {
+            switches.push_back(sw);
+        }
+    }
+    // the same rules as is_present, flattened
+    void add_conditions(const IMessage& msg, const ISignal& sig, Compiled& compiled, std::vector<const ISignal*>& switches, std::size_t depth = 0)
+    {
+        if (sig.MultiplexerIndicator() != ISignal::EMultiplexer::MuxValue || depth > msg.Signals_Size())
+        {
+            return;
+        }
+        if (sig.SignalMultiplexerValues_Size() == 0)
+        {
+            if (const ISignal* mux = msg.MuxSignal())
+            {
+                compiled.conditions.push_back({mux, uint32_t(compiled.ranges.size()), 1});
+                compiled.ranges.push_back({sig.MultiplexerSwitchValue(), sig.MultiplexerSwitchValue()});
+                add_switch(switches, mux);
+            }
+            return;
+        }
+        for (const auto& smv : sig.SignalMultiplexerValues())
+        {
+            const ISignal* sw = find_switch(msg, smv.SwitchName());
+            if (!sw)
+            {
+                continue;
+            }
+            Condition condition{sw, uint32_t(compiled.ranges.size()), 0};
+            for (const auto& range : smv.ValueRanges())
+            {
+                compiled.ranges.push_back(range);
+                condition.ranges++;
+            }
+            compiled.conditions.push_back(condition);
+            add_switch(switches, sw);
+            add_conditions(msg, *sw, compiled, switches, depth + 1);
+        }
+    }
+}
+
+class Projection::Impl
+{
+public:
+    Impl(const INetwork& net, const selection_t& selection)
+    {
+        for (std::size_t i = 0; i < selection.size(); i++)
+        {
+            if (std::find(selection[i].begin(), selection[i].end(), true) == selection[i].end())
+            {
+                continue;
+            }
+            const IMessage& msg = net.Messages_Get(i);
+            Projection::Message projected{&msg, {}, {}};
+            Compiled compiled;
+            for (std::size_t j = 0; j < selection[i].size(); j++)
+            {
+                if (selection[i][j])
+                {
+                    const ISignal& sig = msg.Signals_Get(j);
+                    projected.signals.push_back(&sig);
+                    compiled.first_condition.push_back(uint32_t(compiled.conditions.size()));
+                    add_conditions(msg, sig, compiled, projected.switches);
+                }
+            }
+            compiled.first_condition.push_back(uint32_t(compiled.conditions.size()));
+            max_signals = std::max(max_signals, projected.signals.size());
+            // the ids resolve to the messages INetwork::MessageById returns, a message which shares its id
+            // with another one is only reachable through Messages_Get
+            if (net.MessageById(msg.Id()) == &msg)
+            {
+                index_by_id.emplace(msg.Id(), messages.size());
+            }
+            messages.push_back(std::move(projected));
+            compiled_messages.push_back(std::move(compiled));
+        }
+    }
+
+    std::vector<Projection::Message> messages;
+    std::vector<Compiled> compiled_messages;
+    std::unordered_map<uint64_t, std::size_t> index_by_id;
+    std::size_t max_signals = 0;
+};
+
+std::unique_ptr<Projection> Projection::Create(const INetwork& net, const std::vector<const ISignal*>& signals, std::string& error_message)
+{
+    selection_t selection(net.Messages_Size());
+    std::unordered_map<const ISignal*, std::pair<std::size_t, std::size_t>> positions;
+    for (std::size_t i = 0; i < net.Messages_Size(); i++)
+    {
+        const IMessage& msg = net.Messages_Get(i);
+        selection[i].resize(msg.Signals_Size());
+        for (std::size_t j = 0; j < msg.Signals_Size(); j++)
+        {
+            positions.emplace(&msg.Signals_Get(j), std::make_pair(i, j));
+        }
+    }
+    for (const ISignal* sig : signals)
+    {
+        auto iter = positions.find(sig);
+        if (iter == positions.end())
+        {
+            error_message = "signal " + (sig ? "\"" + sig->Name() + "\"" : std::string("nullptr")) + " isn't a signal of the network";
+            return nullptr;
+        }
+        selection[iter->second.first][iter->second.second] = true;
+    }
+    return std::unique_ptr<Projection>(new Projection(std::make_unique<Impl>(net, selection)));
+}
+std::unique_ptr<Projection> Projection::Create(const INetwork& net, const std::vector<std::string>& names, std::string& error_message)
+{
+    selection_t selection(net.Messages_Size());
+    std::unordered_map<std::string, std::vector<std::pair<std::size_t, std::size_t>>> positions;
+    for (std::size_t i = 0; i < net.Messages_Size(); i++)
+    {
+        const IMessage& msg = net.Messages_Get(i);
+        selection[i].resize(msg.Signals_Size());
+        for (std::size_t j = 0; j < msg.Signals_Size(); j++)
+        {
+            const std::string& name = msg.Signals_Get(j).Name();
+            positions[name].emplace_back(i, j);
+            positions[msg.Name() + "." + name].emplace_back(i, j);
+        }
+    }
+    for (const auto& name : names)
+    {
+        auto iter = positions.find(name);
+        if (iter == positions.end())
+        {
+            error_message = "no signal matches \"" + name + "\"";
+            return nullptr;
+        }
+        for (const auto& position : iter->second)
+        {
+            selection[position.first][position.second] = true;
+        }
+    }
+    return std::unique_ptr<Projection>(new Projection(std::make_unique<Impl>(net, selection)));
+}
+Projection::Projection(std::unique_ptr<Impl>&& impl)
+    : _impl(std::move(impl))
+{}
+Projection::~Projection() = default;
+const Projection::Message* Projection::Find(uint64_t id) const
+{
+    auto iter = _impl->index_by_id.find(id);
+    return iter != _impl->index_by_id.end() ? &_impl->messages[iter->second] : nullptr;
+}
+std::size_t Projection::Decode(const Message& msg, const void* data, double* values) const
+{
+    const Compiled& compiled = _impl->compiled_messages[&msg - _impl->messages.data()];
+    for (std::size_t i = 0; i < msg.signals.size(); i++)
+    {
+        bool present = true;
+        for (uint32_t c = compiled.first_condition[i]; present && c < compiled.first_condition[i + 1]; c++)
+        {
+            const Condition& condition = compiled.conditions[c];
+            uint64_t raw = condition.sw->Decode(data);
+            present = false;
+            for (uint32_t r = condition.first_range; r < condition.first_range + condition.ranges; r++)
+            {
+                present |= raw >= compiled.ranges[r].from && raw <= compiled.ranges[r].to;
+            }
+        }
+        const ISignal& sig = *msg.signals[i];
+        values[i] = present ? sig.RawToPhys(sig.Decode(data)) : std::numeric_limits<double>::quiet_NaN();
+    }
+    return msg.signals.size();
+}
+const Projection::Message* Projection::Decode(uint64_t id, const void* data, double* values) const
+{
+    const Message* msg = Find(id);
+    if (msg)
+    {
+        Decode(*msg, data, values);
+    }
+    return msg;
+}
+const Projection::Message& Projection::Messages_Get(std::size_t i) const
+{
+    return _impl->messages[i];
+}
+std::size_t Projection::Messages_Size() const
+{
+    return _impl->messages.size();
+}
+std::size_t Projection::MaxSignalsPerMessage() const
+{
+    return _impl->max_signals;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+#include <cstdint>
+
+namespace dbcppp
+{
+    // The session slots of a reassembler ordered by their last frame, oldest first,
+    // so the sessions which timed out are found without looking at the others.
+    class SessionList
+    {
+    public:
+        static constexpr uint16_t none = std::numeric_limits<uint16_t>::max();
+
+        // slots: at most none
+        explicit SessionList(std::size_t slots)
+            : _links(slots)
+        {}
+
+        // none if the list is empty
+        uint16_t Oldest() const
+        {
+            return _oldest;
+        }
+        void Append(uint16_t slot)
+        {
+            auto& link = _links[slot];
+            link.prev = _newest;
+            link.next = none;
+            (_newest != none ? _links[_newest].next : _oldest) = slot;
+            _newest = slot;
+        }
+        void Unlink(uint16_t slot)
+        {
+            auto& link = _links[slot];
+            (link.prev != none ? _links[link.prev].next : _oldest) = link.next;
+            (link.next != none ? _links[link.next].prev : _newest) = link.prev;
+        }
+        // moves slot to the end
+        void Touch(uint16_t slot)
+        {
+            if (slot != _newest)
+            {
+                Unlink(slot);
+                Append(slot);
+            }
+        }
+
+    private:
+        struct Link
+        {
+            uint16_t prev;
+            uint16_t next;
+        };
+
+        std::vector<Link> _links;
+        uint16_t _oldest = none;
+        uint16_t _newest = none;
+    };
+}
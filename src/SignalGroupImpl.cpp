@@ -1,5 +1,6 @@
 #include <algorithm>
 #include "SignalGroupImpl.h"
+#include "MemoryCounter.h"
 
 using namespace dbcppp;
 
@@ -71,3 +72,10 @@ bool SignalGroupImpl::operator!=(const ISignalGroup& rhs) const
 {
     return !(*this == rhs);
 }
+void SignalGroupImpl::CountMemory(MemoryCounter& counter) const
+{
+    using EEntity = MemoryCounter::EEntity;
+    using ECategory = MemoryCounter::ECategory;
+    counter.Add(EEntity::SignalGroups, ECategory::Names, _name);
+    counter.Add(EEntity::SignalGroups, ECategory::Names, _signal_names);
+}
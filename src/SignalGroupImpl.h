@@ -5,6 +5,8 @@
 
 namespace dbcppp
 {
+    class MemoryCounter;
+
     class SignalGroupImpl
         : public ISignalGroup
     {
@@ -25,6 +27,8 @@ namespace dbcppp
         virtual bool operator==(const ISignalGroup& rhs) const override;
         virtual bool operator!=(const ISignalGroup& rhs) const override;
 
+        void CountMemory(MemoryCounter& counter) const;
+
     private:
         uint64_t _message_id;
         std::string _name;
@@ -1,17 +1,12 @@
 #include <algorithm>
 #include <limits>
+#include "dbcppp/StaticSignal.h"
 #include "Helper.h"
 #include "SignalImpl.h"
+#include "MemoryCounter.h"
 
 using namespace dbcppp;
 
-enum class Alignment
-{
-    size_inbetween_first_64_bit,
-    signal_exceeds_64_bit_size_but_signal_fits_into_64_bit,
-    signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit
-};
-
 template <Alignment aAlignment, ISignal::EByteOrder aByteOrder, ISignal::EValueType aValueType, ISignal::EExtendedValueType aExtendedValueType>
 ISignal::raw_t template_decode(const ISignal* sig, const void* nbytes) noexcept
 {
@@ -418,79 +413,14 @@ SignalImpl::SignalImpl(
     }
 
     // save some additional values to speed up decoding
-    _mask =  (1ull << (_bit_size - 1ull) << 1ull) - 1;
-    _mask_signed = ~((1ull << (_bit_size - 1ull)) - 1);
+    SignalLayout layout = make_signal_layout(_start_bit, _bit_size, _byte_order);
+    _mask = layout.mask;
+    _mask_signed = layout.mask_signed;
+    _fixed_start_bit_0 = layout.fixed_start_bit_0;
+    _fixed_start_bit_1 = layout.fixed_start_bit_1;
+    _byte_pos = layout.byte_pos;
 
-    _byte_pos = _start_bit / 8;
-
-    uint64_t nbytes;
-    if (_byte_order == EByteOrder::LittleEndian)
-    {
-        nbytes = (_start_bit % 8 + _bit_size + 7) / 8;
-    }
-    else
-    {
-        nbytes = (_bit_size + (7 - _start_bit % 8) + 7) / 8;
-    }
-    Alignment alignment = Alignment::size_inbetween_first_64_bit;
-    // check whether the data is in the first 8 bytes
-    // so we can optimize out one memory access
-    if (_byte_pos + nbytes <= 8)
-    {
-        alignment = Alignment::size_inbetween_first_64_bit;
-        if (_byte_order == EByteOrder::LittleEndian)
-        {
-            _fixed_start_bit_0 = _start_bit;
-        }
-        else
-        {
-            _fixed_start_bit_0 = (8 * (7 - (_start_bit / 8))) + (_start_bit % 8) - (_bit_size - 1);
-        }
-    }
-    // check whether we can align the data on 64 bit
-    else if (_byte_pos  % 8 + nbytes <= 8)
-    {
-        alignment = Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit;
-        // align the byte pos on 64 bit
-        _byte_pos -= _byte_pos % 8;
-        _fixed_start_bit_0 = _start_bit - _byte_pos * 8;
-        if (_byte_order == EByteOrder::BigEndian)
-        {
-            _fixed_start_bit_0 = (8 * (7 - (_fixed_start_bit_0 / 8))) + (_fixed_start_bit_0 % 8) - (_bit_size - 1);
-        }
-    }
-    // we aren't able to align the data on 64 bit, so check whether the data fits into on uint64_t
-    else if (nbytes <= 8)
-    {
-        alignment = Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit;
-        _fixed_start_bit_0 = _start_bit - _byte_pos * 8;
-        if (_byte_order == EByteOrder::BigEndian)
-        {
-            _fixed_start_bit_0 = (8 * (7 - (_fixed_start_bit_0 / 8))) + (_fixed_start_bit_0 % 8) - (_bit_size - 1);
-        }
-    }
-    // we aren't able to align the data on 64 bit, and we aren't able to fit the data into one uint64_t
-    // so we have to compose the resulting value
-    else
-    {
-        alignment = Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit;
-        if (_byte_order == EByteOrder::BigEndian)
-        {
-            uint64_t nbits_last_byte = (7 - _start_bit % 8) + _bit_size - 64;
-            _fixed_start_bit_0 = nbits_last_byte;
-            _fixed_start_bit_1 = 8 - nbits_last_byte;
-            _mask = (1ull << (_start_bit % 8 + 57)) - 1;
-        }
-        else
-        {
-            _fixed_start_bit_0 = _start_bit - _byte_pos * 8;
-            _fixed_start_bit_1 = 64 - _start_bit % 8;
-            uint64_t nbits_last_byte = _bit_size + _start_bit % 8 - 64;
-            _mask = (1ull << nbits_last_byte) - 1ull;
-        }
-    }
-
-    _decode = ::make_decode(alignment, _byte_order, _value_type, _extended_value_type);
+    _decode = ::make_decode(layout.alignment, _byte_order, _value_type, _extended_value_type);
     _encode = ::encode;
     switch (_extended_value_type)
     {
@@ -617,8 +547,82 @@ void SignalImpl::SetError(EErrorCode code)
 {
     _error = EErrorCode(uint64_t(_error) | uint64_t(code));
 }
+std::vector<AttributeImpl>& SignalImpl::attributeValues()
+{
+    _fingerprint.Reset();
+    return _attribute_values;
+}
+std::vector<ValueEncodingDescriptionImpl>& SignalImpl::valueEncodingDescriptions()
+{
+    _fingerprint.Reset();
+    return _value_encoding_descriptions;
+}
+std::string& SignalImpl::comment()
+{
+    _fingerprint.Reset();
+    return _comment;
+}
+std::vector<SignalMultiplexerValueImpl>& SignalImpl::signalMultiplexerValues()
+{
+    _fingerprint.Reset();
+    return _signal_multiplexer_values;
+}
+void SignalImpl::setExtendedValueType(EExtendedValueType extended_value_type, uint64_t message_size)
+{
+    *this = SignalImpl(
+          message_size
+        , std::move(_name)
+        , _multiplexer_indicator
+        , _multiplexer_switch_value
+        , _start_bit
+        , _bit_size
+        , _byte_order
+        , _value_type
+        , _factor
+        , _offset
+        , _minimum
+        , _maximum
+        , std::move(_unit)
+        , std::move(_receivers)
+        , std::move(_attribute_values)
+        , std::move(_value_encoding_descriptions)
+        , std::move(_comment)
+        , extended_value_type
+        , std::move(_signal_multiplexer_values));
+}
+Hash128 SignalImpl::Fingerprint() const
+{
+    return _fingerprint.Get(
+        [this]()
+        {
+            Hasher hasher;
+            hasher.Add(_name);
+            hasher.Add(static_cast<uint64_t>(_multiplexer_indicator));
+            hasher.Add(_multiplexer_switch_value);
+            hasher.Add(_start_bit);
+            hasher.Add(_bit_size);
+            hasher.Add(static_cast<uint64_t>(_byte_order));
+            hasher.Add(static_cast<uint64_t>(_value_type));
+            hasher.Add(_factor);
+            hasher.Add(_offset);
+            hasher.Add(_minimum);
+            hasher.Add(_maximum);
+            hasher.Add(_unit);
+            hasher.AddUnordered(_receivers);
+            hasher.AddUnordered(_attribute_values);
+            hasher.AddUnordered(_value_encoding_descriptions);
+            hasher.Add(_comment);
+            hasher.Add(static_cast<uint64_t>(_extended_value_type));
+            hasher.AddUnordered(_signal_multiplexer_values);
+            return hasher.Finish();
+        });
+}
 bool SignalImpl::operator==(const ISignal& rhs) const
 {
+    if (Fingerprint() != rhs.Fingerprint())
+    {
+        return false;
+    }
     bool equal = true;
     equal &= _name == rhs.Name();
     equal &= _multiplexer_indicator == rhs.MultiplexerIndicator();
@@ -664,12 +668,25 @@ bool SignalImpl::operator!=(const ISignal& rhs) const
 {
     return !(*this == rhs);
 }
+void SignalImpl::CountMemory(MemoryCounter& counter) const
+{
+    using EEntity = MemoryCounter::EEntity;
+    using ECategory = MemoryCounter::ECategory;
+    counter.Add(EEntity::Signals, ECategory::Names, _name);
+    counter.Add(EEntity::Signals, ECategory::Other, _unit);
+    counter.Add(EEntity::Signals, ECategory::Names, _receivers);
+    counter.Add(EEntity::Signals, ECategory::Comments, _comment);
+    counter.Objects(EEntity::Attributes, _attribute_values);
+    counter.Objects(EEntity::ValueEncodingDescriptions, _value_encoding_descriptions);
+    counter.Objects(EEntity::SignalMultiplexerValues, _signal_multiplexer_values);
+}
 
 void SignalImpl::Merge(SignalImpl &&o) {
     // refuse to merge if name not same
     if (_name != o._name) {
         return;
     }
+    _fingerprint.Reset();
     compare_set(_multiplexer_indicator, o._multiplexer_indicator);
     compare_set(_multiplexer_switch_value, o._multiplexer_switch_value);
     compare_set(_start_bit, o._start_bit);
@@ -709,4 +726,4 @@ void ISignal::Merge(std::unique_ptr<ISignal>&& other) {
     auto& self = static_cast<SignalImpl&>(*this);
     auto& o = static_cast<SignalImpl&>(*other);
     self.Merge(std::move(o));
-}
\ No newline at end of file
+}
@@ -8,9 +8,12 @@
 #include "AttributeImpl.h"
 #include "SignalMultiplexerValueImpl.h"
 #include "ValueEncodingDescriptionImpl.h"
+#include "Fingerprint.h"
 
 namespace dbcppp
 {
+    class MemoryCounter;
+
     class SignalImpl final
         : public ISignal
     {
@@ -62,11 +65,22 @@ namespace dbcppp
         virtual uint64_t SignalMultiplexerValues_Size() const override;
         virtual bool Error(EErrorCode code) const override;
         
+        std::vector<AttributeImpl>& attributeValues();
+        std::vector<ValueEncodingDescriptionImpl>& valueEncodingDescriptions();
+        std::string& comment();
+        std::vector<SignalMultiplexerValueImpl>& signalMultiplexerValues();
+        // the decode functions depend on the extended value type, so the signal is rebuilt
+        void setExtendedValueType(EExtendedValueType extended_value_type, uint64_t message_size);
+        
+        virtual Hash128 Fingerprint() const override;
+
         virtual bool operator==(const ISignal& rhs) const override;
         virtual bool operator!=(const ISignal& rhs) const override;
 
         void Merge(SignalImpl &&other);
 
+        void CountMemory(MemoryCounter& counter) const;
+
     private:
         void SetError(EErrorCode code);
 
@@ -88,6 +102,7 @@ namespace dbcppp
         std::string _comment;
         EExtendedValueType _extended_value_type;
         std::vector<SignalMultiplexerValueImpl> _signal_multiplexer_values;
+        FingerprintCache _fingerprint;
 
     public:
         // for performance
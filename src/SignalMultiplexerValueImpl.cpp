@@ -1,5 +1,6 @@
 #include <algorithm>
 #include "SignalMultiplexerValueImpl.h"
+#include "MemoryCounter.h"
 
 using namespace dbcppp;
 
@@ -55,3 +56,10 @@ bool SignalMultiplexerValueImpl::operator!=(const ISignalMultiplexerValue& rhs)
 {
     return !(*this == rhs);
 }
+void SignalMultiplexerValueImpl::CountMemory(MemoryCounter& counter) const
+{
+    using EEntity = MemoryCounter::EEntity;
+    using ECategory = MemoryCounter::ECategory;
+    counter.Add(EEntity::SignalMultiplexerValues, ECategory::MuxMetadata, _switch_name);
+    counter.Add(EEntity::SignalMultiplexerValues, ECategory::MuxMetadata, _value_ranges.capacity() * sizeof(Range));
+}
@@ -5,6 +5,8 @@
 
 namespace dbcppp
 {
+    class MemoryCounter;
+
     class SignalMultiplexerValueImpl
         : public ISignalMultiplexerValue
     {
@@ -22,6 +24,8 @@ namespace dbcppp
         virtual bool operator==(const ISignalMultiplexerValue& rhs) const override;
         virtual bool operator!=(const ISignalMultiplexerValue& rhs) const override;
 
+        void CountMemory(MemoryCounter& counter) const;
+
     private:
         std::string _switch_name;
         std::vector<Range> _value_ranges;
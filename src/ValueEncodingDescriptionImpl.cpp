@@ -1,5 +1,6 @@
 
 #include "ValueEncodingDescriptionImpl.h"
+#include "MemoryCounter.h"
 
 using namespace dbcppp;
 
@@ -37,3 +38,7 @@ bool ValueEncodingDescriptionImpl::operator!=(const IValueEncodingDescription& r
 {
     return !(*this == rhs);
 }
+void ValueEncodingDescriptionImpl::CountMemory(MemoryCounter& counter) const
+{
+    counter.Add(MemoryCounter::EEntity::ValueEncodingDescriptions, MemoryCounter::ECategory::ValueDescriptions, _description);
+}
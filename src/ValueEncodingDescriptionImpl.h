@@ -6,6 +6,8 @@
 
 namespace dbcppp
 {
+    class MemoryCounter;
+
     class ValueEncodingDescriptionImpl
         : public IValueEncodingDescription
     {
@@ -19,6 +21,8 @@ namespace dbcppp
         virtual bool operator==(const IValueEncodingDescription& rhs) const override;
         virtual bool operator!=(const IValueEncodingDescription& rhs) const override;
 
+        void CountMemory(MemoryCounter& counter) const;
+
     private:
         int64_t _value;
         std::string _description;
@@ -1,6 +1,7 @@
 #include <algorithm>
 #include "dbcppp/Network.h"
 #include "ValueTableImpl.h"
+#include "MemoryCounter.h"
 
 using namespace dbcppp;
 
@@ -58,6 +59,10 @@ uint64_t ValueTableImpl::ValueEncodingDescriptions_Size() const
 {
     return _value_encoding_descriptions.size();
 }
+std::optional<SignalTypeImpl>& ValueTableImpl::signalType()
+{
+    return _signal_type;
+}
 bool ValueTableImpl::operator==(const IValueTable& rhs) const
 {
     bool equal = true;
@@ -74,4 +79,17 @@ bool ValueTableImpl::operator==(const IValueTable& rhs) const
 bool ValueTableImpl::operator!=(const IValueTable& rhs) const
 {
     return !(*this == rhs);
-}
\ No newline at end of file
+}
+void ValueTableImpl::CountMemory(MemoryCounter& counter) const
+{
+    using EEntity = MemoryCounter::EEntity;
+    using ECategory = MemoryCounter::ECategory;
+    counter.Add(EEntity::ValueTables, ECategory::Names, _name);
+    if (_signal_type)
+    {
+        counter.Add(EEntity::ValueTables, ECategory::ValueDescriptions, _signal_type->Name());
+        counter.Add(EEntity::ValueTables, ECategory::ValueDescriptions, _signal_type->Unit());
+        counter.Add(EEntity::ValueTables, ECategory::ValueDescriptions, _signal_type->ValueTable());
+    }
+    counter.Objects(EEntity::ValueEncodingDescriptions, _value_encoding_descriptions);
+}
@@ -11,6 +11,8 @@
 
 namespace dbcppp
 {
+    class MemoryCounter;
+
     class SignalType;
     class ValueTableImpl final
         : public IValueTable
@@ -28,9 +30,13 @@ namespace dbcppp
         virtual const IValueEncodingDescription& ValueEncodingDescriptions_Get(std::size_t i) const override;
         virtual uint64_t ValueEncodingDescriptions_Size() const override;
         
+        std::optional<SignalTypeImpl>& signalType();
+        
         virtual bool operator==(const IValueTable& rhs) const override;
         virtual bool operator!=(const IValueTable& rhs) const override;
 
+        void CountMemory(MemoryCounter& counter) const;
+
     private:
         std::string _name;
         std::optional<SignalTypeImpl> _signal_type;
@@ -1,7 +1,12 @@
 
+#include <cmath>
+#include <thread>
+#include <vector>
+#include <sstream>
 #include "Catch2.h"
 #include <dbcppp/CApi.h>
 #include <dbcppp/Network.h>
+#include "Multiplexer.h"
 
 using namespace dbcppp;
 
@@ -244,3 +249,339 @@ TEST_CASE("API Test: Message", "[]")
         REQUIRE(dbcppp_MessageSignals_Size(msg) == 3);
     }
 }
+TEST_CASE("API Test: Merge", "[]")
+{
+    // network i defines the messages [i * 100, i * 100 + 200), so each message is defined by up to two networks
+    auto make_network =
+        [](std::size_t i)
+        {
+            std::ostringstream dbc;
+            dbc << "VERSION \"\"\nNS_ :\n\tNS_DESC_\nBS_:\nBU_: Node" << i << " Common\n";
+            for (std::size_t id = i * 100; id < i * 100 + 200; id++)
+            {
+                dbc << "BO_ " << id << " Msg" << id << ": 8 Node" << i << "\n";
+                dbc << " SG_ Sig" << i << " : 0|8@1+ (1,0) [0|0] \"\" Common\n";
+                dbc << " SG_ Common : 8|8@1+ (" << i + 1 << ",0) [0|0] \"\" Common\n";
+            }
+            std::istringstream iss(dbc.str());
+            return INetwork::LoadDBCFromIs(iss);
+        };
+    auto check =
+        [](const INetwork& net)
+        {
+            REQUIRE(net.NewSymbols_Size() == 1);
+            REQUIRE(net.Nodes_Size() == 5);
+            REQUIRE(net.Messages_Size() == 500);
+            for (std::size_t id = 0; id < 500; id++)
+            {
+                const auto& msg = net.Messages_Get(id);
+                REQUIRE(msg.Id() == id);
+                std::size_t last = std::min<std::size_t>(id / 100, 3);
+                std::size_t first = id < 100 ? 0 : id / 100 - 1;
+                REQUIRE(msg.Signals_Size() == (first == last ? 2 : 3));
+                auto common = std::find_if(msg.Signals().begin(), msg.Signals().end(),
+                    [](const ISignal& sig) { return sig.Name() == "Common"; });
+                REQUIRE(common != msg.Signals().end());
+                // the last merged network wins
+                REQUIRE(common->Factor() == double(last + 1));
+            }
+        };
+
+    SECTION("Merge")
+    {
+        auto net = make_network(0);
+        for (std::size_t i = 1; i < 4; i++)
+        {
+            net->Merge(make_network(i));
+        }
+        check(*net);
+    }
+    SECTION("MergeAll")
+    {
+        std::vector<std::unique_ptr<INetwork>> networks;
+        networks.push_back(nullptr);
+        for (std::size_t i = 0; i < 4; i++)
+        {
+            networks.push_back(make_network(i));
+        }
+        auto net = INetwork::MergeAll(std::move(networks));
+        REQUIRE(net);
+        check(*net);
+        REQUIRE(networks.empty());
+    }
+}
+TEST_CASE("API Test: Fingerprint", "[]")
+{
+    constexpr const char* header =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_: A B\n";
+    constexpr const char* msg1 =
+        "BO_ 1 Msg1: 8 A\n"
+        " SG_ Sig1 : 0|8@1+ (1,0) [0|0] \"\" A,B\n"
+        " SG_ Sig2 : 8|8@1+ (1,0) [0|0] \"\" B\n";
+    constexpr const char* msg1_reordered =
+        "BO_ 1 Msg1: 8 A\n"
+        " SG_ Sig2 : 8|8@1+ (1,0) [0|0] \"\" B\n"
+        " SG_ Sig1 : 0|8@1+ (1,0) [0|0] \"\" B,A\n";
+    constexpr const char* msg2 =
+        "BO_ 2 Msg2: 8 B\n"
+        " SG_ Sig1 : 0|16@0- (0.5,-1) [0|0] \"km/h\" A\n";
+    auto load =
+        [](const std::string& dbc)
+        {
+            std::istringstream iss(dbc);
+            auto net = INetwork::LoadDBCFromIs(iss);
+            REQUIRE(net);
+            return net;
+        };
+    auto net = load(std::string(header) + msg1 + msg2);
+
+    SECTION("Independent of the order")
+    {
+        auto reordered = load(std::string(header) + msg2 + msg1_reordered);
+        REQUIRE(net->Fingerprint() == reordered->Fingerprint());
+        REQUIRE(*net == *reordered);
+        REQUIRE(net->Clone()->Fingerprint() == net->Fingerprint());
+    }
+    SECTION("Changes are detected")
+    {
+        auto changed = load(std::string(header) + msg1 + msg2 + "CM_ BO_ 2 \"comment\";\n");
+        REQUIRE(net->Fingerprint() != changed->Fingerprint());
+        REQUIRE(net->Messages_Get(0).Fingerprint() == changed->Messages_Get(0).Fingerprint());
+        REQUIRE(net->Messages_Get(1).Fingerprint() != changed->Messages_Get(1).Fingerprint());
+        REQUIRE(*net != *changed);
+        REQUIRE(*changed != *net);
+        auto fewer = load(std::string(header) + msg1);
+        REQUIRE(*net != *fewer);
+        REQUIRE(*fewer != *net);
+    }
+    SECTION("Merge resets the cached fingerprint")
+    {
+        auto before = net->Fingerprint();
+        net->Merge(load(std::string(header) + "BO_ 3 Msg3: 8 B\n"));
+        REQUIRE(net->Fingerprint() != before);
+        REQUIRE(*net == *load(std::string(header) + msg1 + msg2 + "BO_ 3 Msg3: 8 B\n"));
+    }
+}
+TEST_CASE("API Test: Clone", "[]")
+{
+    auto load =
+        [](const std::string& messages)
+        {
+            std::istringstream iss("VERSION \"\"\nNS_ :\nBS_:\nBU_: A\n" + messages);
+            auto net = INetwork::LoadDBCFromIs(iss);
+            REQUIRE(net);
+            return net;
+        };
+    auto net = load(
+        "BO_ 1 Msg1: 8 A\n"
+        " SG_ Sig1 : 0|8@1+ (1,0) [0|0] \"\" A\n"
+        "BO_ 2 Msg2: 8 A\n"
+        " SG_ Sig2 : 0|8@1+ (1,0) [0|0] \"\" A\n");
+    auto clone = net->Clone();
+    REQUIRE(*clone == *net);
+    REQUIRE(clone->MessageById(2) == &net->Messages_Get(1));
+    // the messages are shared until they are modified
+    REQUIRE(&clone->Messages_Get(0) == &net->Messages_Get(0));
+    REQUIRE(&clone->Messages_Get(1) == &net->Messages_Get(1));
+    REQUIRE(clone->ParentMessage(&net->Messages_Get(0).Signals_Get(0)) == &clone->Messages_Get(0));
+
+    clone->Merge(load(
+        "BO_ 2 Msg2: 8 A\n"
+        " SG_ Sig2 : 0|16@1+ (1,0) [0|0] \"\" A\n"));
+    REQUIRE(*clone != *net);
+    REQUIRE(&clone->Messages_Get(0) == &net->Messages_Get(0));
+    REQUIRE(&clone->Messages_Get(1) != &net->Messages_Get(1));
+    REQUIRE(clone->Messages_Get(1).Signals_Get(0).BitSize() == 16);
+    REQUIRE(clone->MessageById(2) == &clone->Messages_Get(1));
+    REQUIRE(net->MessageById(2) == &net->Messages_Get(1));
+    REQUIRE(net->Messages_Get(1).Signals_Get(0).BitSize() == 8);
+}
+TEST_CASE("API Test: Concurrent lookups", "[]")
+{
+    std::string dbc = "VERSION \"\"\nNS_ :\nBS_:\nBU_: A\n";
+    for (std::size_t i = 1; i <= 100; i++)
+    {
+        dbc += "BO_ " + std::to_string(i) + " Msg" + std::to_string(i) + ": 8 A\n";
+    }
+    for (std::size_t round = 0; round < 20; round++)
+    {
+        std::istringstream iss(dbc);
+        auto net = INetwork::LoadDBCFromIs(iss);
+        REQUIRE(net);
+        // all threads build the index on their first lookup
+        std::vector<std::size_t> found(8);
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < found.size(); t++)
+        {
+            threads.emplace_back(
+                [&, t]
+                {
+                    for (uint64_t id = 1; id <= 100; id++)
+                    {
+                        const IMessage* msg = net->MessageById(id);
+                        found[t] += msg && msg->Id() == id;
+                    }
+                });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        for (std::size_t n : found)
+        {
+            REQUIRE(n == 100);
+        }
+    }
+}
+TEST_CASE("API Test: Batch decode", "[]")
+{
+    constexpr const char* test_dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_: A\n"
+        "BO_ 1 Msg1: 2 A\n"
+        " SG_ Sig1 : 0|8@1+ (0.5,-10) [0|0] \"\" A\n"
+        " SG_ Sig2 : 8|8@1- (1,0) [0|0] \"\" A\n"
+        "BO_ 2 Msg2: 8 A\n"
+        " SG_ Mux M : 0|8@1+ (1,0) [0|0] \"\" A\n"
+        " SG_ Sig3 m1 : 8|16@1+ (1,0) [0|0] \"\" A\n"
+        " SG_ Sig4 m2 : 8|16@1+ (2,0) [0|0] \"\" A\n";
+    auto net = dbcppp_NetworkLoadDBCFromMemory(test_dbc);
+    REQUIRE(net);
+    auto msg1 = dbcppp_NetworkMessageById(net, 1);
+    auto msg2 = dbcppp_NetworkMessageById(net, 2);
+    REQUIRE(msg1 == dbcppp_NetworkMessages_Get(net, 0));
+    REQUIRE(msg2 == dbcppp_NetworkMessages_Get(net, 1));
+    REQUIRE(dbcppp_NetworkMessageById(net, 3) == nullptr);
+    REQUIRE(dbcppp_NetworkMaxSignalsPerMessage(net) == 3);
+
+    SECTION("Whole message")
+    {
+        const uint8_t frame[] = {40, 0xfe};
+        double values[2];
+        REQUIRE(dbcppp_MessageDecodeAll(msg1, frame, sizeof(frame), values) == 2);
+        REQUIRE(values[0] == 10.);
+        REQUIRE(values[1] == -2.);
+        REQUIRE(dbcppp_MessageDecodeAll(msg1, frame, 1, values) == 0);
+
+        const uint8_t muxed[] = {2, 0x10, 0x00, 0, 0, 0, 0, 0};
+        double mux_values[3];
+        REQUIRE(dbcppp_MessageDecodeAll(msg2, muxed, sizeof(muxed), mux_values) == 3);
+        REQUIRE(mux_values[0] == 2.);
+        REQUIRE(std::isnan(mux_values[1]));
+        REQUIRE(mux_values[2] == 32.);
+    }
+    SECTION("Frame arrays")
+    {
+        const uint32_t ids[] = {2, 7, 1, 2};
+        const uint8_t payloads[] =
+            { 1, 0x34, 0x12, 0, 0, 0, 0, 0
+            , 0, 0, 0, 0, 0, 0, 0, 0
+            , 20, 3, 0, 0, 0, 0, 0, 0
+            , 2, 1, 0, 0, 0, 0, 0, 0 };
+        double values[4 * 3];
+        const dbcppp_Message* messages[4];
+        REQUIRE(dbcppp_NetworkDecodeFrames(net, ids, payloads, 8, 4, values, 3, messages) == 3);
+        REQUIRE(messages[0] == msg2);
+        REQUIRE(messages[1] == nullptr);
+        REQUIRE(messages[2] == msg1);
+        REQUIRE(messages[3] == msg2);
+        REQUIRE(values[1] == 0x1234);
+        REQUIRE(std::isnan(values[2]));
+        REQUIRE(values[6] == 0.);
+        REQUIRE(values[7] == 3.);
+        REQUIRE(values[11] == 2.);
+        // frames shorter than the message are skipped
+        REQUIRE(dbcppp_NetworkDecodeFrames(net, ids, payloads, 2, 1, values, 3, nullptr) == 0);
+    }
+    dbcppp_NetworkFree(net);
+}
+TEST_CASE("API Test: Cyclic switches", "[]")
+{
+    // A and B select each other, which must not recurse endlessly
+    constexpr const char* test_dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_: A\n"
+        "BO_ 1 Msg1: 8 A\n"
+        " SG_ A m1M : 0|8@1+ (1,0) [0|0] \"\" A\n"
+        " SG_ B m1M : 8|8@1+ (1,0) [0|0] \"\" A\n"
+        " SG_ C m2 : 16|8@1+ (1,0) [0|0] \"\" A\n"
+        "SG_MUL_VAL_ 1 A B 1-1;\n"
+        "SG_MUL_VAL_ 1 B A 1-1;\n"
+        "SG_MUL_VAL_ 1 C A 2-2;\n";
+    auto net = dbcppp_NetworkLoadDBCFromMemory(test_dbc);
+    REQUIRE(net);
+    auto msg = dbcppp_NetworkMessageById(net, 1);
+    REQUIRE(msg);
+    const uint8_t frame[] = {1, 1, 3, 0, 0, 0, 0, 0};
+    double values[3];
+    REQUIRE(dbcppp_MessageDecodeAll(msg, frame, sizeof(frame), values) == 3);
+    REQUIRE(values[0] == 1.);
+    REQUIRE(values[1] == 1.);
+    REQUIRE(std::isnan(values[2]));
+    const uint8_t other[] = {2, 1, 3, 0, 0, 0, 0, 0};
+    REQUIRE(dbcppp_MessageDecodeAll(msg, other, sizeof(other), values) == 3);
+    REQUIRE(std::isnan(values[1]));
+    dbcppp_NetworkFree(net);
+}
+TEST_CASE("API Test: DecodeAll cascaded switches", "[]")
+{
+    // B is selected by A and selects C, the precompiled conditions of DecodeAll must agree with is_present
+    constexpr const char* test_dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_: A\n"
+        "BO_ 1 Msg1: 8 A\n"
+        " SG_ A M : 0|8@1+ (1,0) [0|0] \"\" A\n"
+        " SG_ A_1 m1 : 8|8@1+ (1,0) [0|0] \"\" A\n"
+        " SG_ B m2M : 16|8@1+ (1,0) [0|0] \"\" A\n"
+        " SG_ B_0 m0 : 24|8@1+ (1,0) [0|0] \"\" A\n"
+        " SG_ B_1 m1 : 24|8@1+ (1,0) [0|0] \"\" A\n"
+        " SG_ C m2M : 32|8@1+ (1,0) [0|0] \"\" A\n"
+        " SG_ C_1 m1 : 40|8@1+ (1,0) [0|0] \"\" A\n"
+        " SG_ Plain : 48|8@1+ (1,0) [0|0] \"\" A\n"
+        "SG_MUL_VAL_ 1 A_1 A 1-1;\n"
+        "SG_MUL_VAL_ 1 B A 2-3;\n"
+        "SG_MUL_VAL_ 1 B_0 B 0-0;\n"
+        "SG_MUL_VAL_ 1 B_1 B 1-1;\n"
+        "SG_MUL_VAL_ 1 C B 2-2;\n"
+        "SG_MUL_VAL_ 1 C_1 C 1-1;\n";
+    std::istringstream is(test_dbc);
+    auto net = INetwork::LoadDBCFromIs(is);
+    REQUIRE(net);
+    const IMessage* msg = net->MessageById(1);
+    REQUIRE(msg);
+    REQUIRE(msg->Signals_Size() == 8);
+    for (uint8_t a = 0; a < 4; a++)
+    {
+        for (uint8_t b = 0; b < 4; b++)
+        {
+            for (uint8_t c = 0; c < 3; c++)
+            {
+                const uint8_t frame[] = {a, 5, b, 6, c, 7, 8, 0};
+                double values[8];
+                REQUIRE(dbcppp_MessageDecodeAll(reinterpret_cast<const dbcppp_Message*>(msg), frame, sizeof(frame), values) == 8);
+                for (std::size_t i = 0; i < msg->Signals_Size(); i++)
+                {
+                    REQUIRE(!std::isnan(values[i]) == is_present(*msg, msg->Signals_Get(i), frame));
+                }
+            }
+        }
+    }
+    const uint8_t frame[] = {3, 5, 2, 6, 1, 7, 8, 0};
+    double values[8];
+    REQUIRE(dbcppp_MessageDecodeAll(reinterpret_cast<const dbcppp_Message*>(msg), frame, sizeof(frame), values) == 8);
+    REQUIRE(std::isnan(values[1]));
+    REQUIRE(std::isnan(values[3]));
+    REQUIRE(std::isnan(values[4]));
+    REQUIRE(values[5] == 1.);
+    REQUIRE(values[6] == 7.);
+    REQUIRE(values[7] == 8.);
+}
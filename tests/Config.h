@@ -0,0 +1,5 @@
+#define TEST_DBC "/root/repo/tests/Test.dbc"
+constexpr const char* TEST_FILES_PATH = "/root/repo/tests/test_files";
+#define TEST_DBC_WITH_SINGLE_COMMENTS "/root/repo/tests/Test_single_comments.dbc"
+#define C_COMPILER "/usr/bin/cc"
+#define CXX_COMPILER "/usr/bin/c++"
@@ -1,10 +1,13 @@
 
 #include <fstream>
+#include <algorithm>
+#include <sstream>
 #include <iomanip>
 #include <filesystem>
 
 #include "dbcppp/Network.h"
 #include "dbcppp/Network2Functions.h"
+#include "DBCAST2Network.h"
 
 #include "Config.h"
 
@@ -48,3 +51,282 @@ TEST_CASE("DBCParserTest", "[]")
         i++;
     }
 }
+TEST_CASE("DBCStreamingParserTest", "[]")
+{
+    SECTION("Same network as from the AST")
+    {
+        for (const auto& dbc_file : std::filesystem::directory_iterator(std::filesystem::path(TEST_FILES_PATH) / "dbc"))
+        {
+            if (dbc_file.path().extension() != ".dbc")
+            {
+                continue;
+            }
+            std::ifstream dbc(dbc_file.path());
+            std::string str((std::istreambuf_iterator<char>(dbc)), std::istreambuf_iterator<char>());
+            std::string error_message;
+            auto gnet = dbcppp::DBCX3::ParseFromMemory(str.c_str(), str.c_str() + str.size(), error_message);
+            REQUIRE(gnet);
+            auto spec = dbcppp::DBCAST2Network(*gnet);
+            dbcppp::NetworkBuilder builder;
+            REQUIRE(dbcppp::DBCX3::ParseFromMemory(str.c_str(), str.c_str() + str.size(), builder, error_message));
+            auto test = builder.Finish();
+            REQUIRE(*spec == *test);
+            REQUIRE(*test == *spec);
+        }
+    }
+    SECTION("Skip unwanted statements")
+    {
+        class MessageCounter
+            : public dbcppp::DBCX3::ParserHandler
+        {
+        public:
+            virtual bool Wants(EStatement statement) const override
+            {
+                return statement == EStatement::Message;
+            }
+            virtual void OnMessage(dbcppp::DBCX3::AST::G_Message&&) override
+            {
+                messages++;
+            }
+            virtual void OnSignal(dbcppp::DBCX3::AST::G_Signal&&) override
+            {
+                signals++;
+            }
+            virtual void OnComment(dbcppp::DBCX3::AST::G_Comment&&) override
+            {
+                comments++;
+            }
+            std::size_t messages = 0;
+            std::size_t signals = 0;
+            std::size_t comments = 0;
+        };
+        const std::string dbc =
+            "VERSION \"\"\n"
+            "BS_:\n"
+            "BU_: A\n"
+            "BO_ 1 Msg: 8 A\n"
+            " SG_ Sig0 : 0|8@1+ (1,0) [0|0] \"\" A\n"
+            " SG_ Sig1 : 8|8@1+ (1,0) [0|0] \"\" A\n"
+            "CM_ SG_ 1 Sig0 \"a comment; with \\\"quotes\\\"\";\n"
+            "BA_DEF_ BO_ \"GenMsgCycleTime\" INT 0 65535;\n"
+            "BA_DEF_ BO_ // a comment; which doesn't end the statement\n"
+            "    \"GenMsgDelay\" /* nor ; does this */ INT 0 65535;\n"
+            "BO_ 2 Msg2: 8 A\n";
+        MessageCounter counter;
+        std::string error_message;
+        REQUIRE(dbcppp::DBCX3::ParseFromMemory(dbc.c_str(), dbc.c_str() + dbc.size(), counter, error_message));
+        REQUIRE(counter.messages == 2);
+        REQUIRE(counter.signals == 2);
+        REQUIRE(counter.comments == 0);
+    }
+}
+TEST_CASE("DBCLoadOptionsTest", "[]")
+{
+    for (const auto& dbc_file : std::filesystem::directory_iterator(std::filesystem::path(TEST_FILES_PATH) / "dbc"))
+    {
+        if (dbc_file.path().extension() != ".dbc")
+        {
+            continue;
+        }
+        std::string error_message;
+        auto full = dbcppp::INetwork::LoadNetworkFromFile(dbc_file.path(), dbcppp::LoadOptions(), error_message);
+        auto decode_only = dbcppp::INetwork::LoadNetworkFromFile(dbc_file.path(), dbcppp::LoadOptions::DecodeOnly(), error_message);
+        REQUIRE(full);
+        REQUIRE(decode_only);
+        REQUIRE(decode_only->Comment().empty());
+        REQUIRE(decode_only->AttributeDefinitions_Size() == 0);
+        REQUIRE(decode_only->AttributeValues_Size() == 0);
+        REQUIRE(decode_only->EnvironmentVariables_Size() == 0);
+        REQUIRE(decode_only->Messages_Size() == full->Messages_Size());
+        for (std::size_t i = 0; i < full->Messages_Size(); i++)
+        {
+            const auto& msg = full->Messages_Get(i);
+            const auto& msg_do = decode_only->Messages_Get(i);
+            REQUIRE(msg_do.Id() == msg.Id());
+            REQUIRE(msg_do.Comment().empty());
+            REQUIRE(msg_do.AttributeValues_Size() == 0);
+            REQUIRE(msg_do.Signals_Size() == msg.Signals_Size());
+            for (std::size_t j = 0; j < msg.Signals_Size(); j++)
+            {
+                const auto& sig = msg.Signals_Get(j);
+                const auto& sig_do = msg_do.Signals_Get(j);
+                REQUIRE(sig_do.Name() == sig.Name());
+                REQUIRE(sig_do.StartBit() == sig.StartBit());
+                REQUIRE(sig_do.BitSize() == sig.BitSize());
+                REQUIRE(sig_do.ExtendedValueType() == sig.ExtendedValueType());
+                REQUIRE(sig_do.SignalMultiplexerValues_Size() == sig.SignalMultiplexerValues_Size());
+                REQUIRE(sig_do.ValueEncodingDescriptions_Size() == sig.ValueEncodingDescriptions_Size());
+                REQUIRE(sig_do.Comment().empty());
+            }
+        }
+    }
+}
+TEST_CASE("DBCParserBenchmark", "[.][benchmark]")
+{
+    std::vector<std::string> corpus;
+    for (const auto& dbc_file : std::filesystem::directory_iterator(std::filesystem::path(TEST_FILES_PATH) / "dbc"))
+    {
+        if (dbc_file.path().extension() == ".dbc")
+        {
+            std::ifstream dbc(dbc_file.path());
+            corpus.emplace_back((std::istreambuf_iterator<char>(dbc)), std::istreambuf_iterator<char>());
+        }
+    }
+    BENCHMARK("Annotated parse of the test_files corpus")
+    {
+        std::size_t n = 0;
+        std::string error_message;
+        for (const auto& dbc : corpus)
+        {
+            n += dbcppp::DBCX3::ParseFromMemoryAnnotated(dbc.c_str(), dbc.c_str() + dbc.size(), error_message).has_value();
+        }
+        return n;
+    };
+    BENCHMARK("Fast parse of the test_files corpus")
+    {
+        std::size_t n = 0;
+        std::string error_message;
+        for (const auto& dbc : corpus)
+        {
+            n += dbcppp::DBCX3::ParseFromMemory(dbc.c_str(), dbc.c_str() + dbc.size(), error_message).has_value();
+        }
+        return n;
+    };
+}
+TEST_CASE("DBCParallelParserTest", "[]")
+{
+    SECTION("Same network as the sequential parse")
+    {
+        for (const auto& dbc_file : std::filesystem::directory_iterator(std::filesystem::path(TEST_FILES_PATH) / "dbc"))
+        {
+            if (dbc_file.path().extension() != ".dbc")
+            {
+                continue;
+            }
+            std::ifstream dbc(dbc_file.path());
+            std::string str((std::istreambuf_iterator<char>(dbc)), std::istreambuf_iterator<char>());
+            std::string error_message;
+            auto gnet = dbcppp::DBCX3::ParseFromMemory(str.c_str(), str.c_str() + str.size(), error_message);
+            REQUIRE(gnet);
+            auto spec = dbcppp::DBCAST2Network(*gnet);
+            // chunk size 1 splits at every statement
+            auto gnet_parallel = dbcppp::DBCX3::ParseFromMemoryParallel(str.c_str(), str.c_str() + str.size(), 4, 1, dbcppp::DBCX3::ParserHandler(), error_message);
+            REQUIRE(gnet_parallel);
+            REQUIRE(gnet_parallel->messages.size() == gnet->messages.size());
+            auto test = dbcppp::DBCAST2Network(*gnet_parallel);
+            REQUIRE(*spec == *test);
+            REQUIRE(*test == *spec);
+        }
+    }
+    SECTION("Statement continued on a line starting with a keyword")
+    {
+        std::string dbc =
+            "VERSION \"\"\n"
+            "NS_ :\n"
+            "BS_:\n"
+            "BU_: A\n"
+            "BO_ 1 Msg: 8 A\n"
+            " SG_ Sig : 0|8@1+ (1,0) [0|0] \"\" A\n"
+            "CM_\n"
+            "BO_ 1 \"comment\";\n";
+        std::string error_message;
+        auto gnet = dbcppp::DBCX3::ParseFromMemoryParallel(dbc.c_str(), dbc.c_str() + dbc.size(), 4, 1, dbcppp::DBCX3::ParserHandler(), error_message);
+        REQUIRE(gnet);
+        REQUIRE(gnet->messages.size() == 1);
+        REQUIRE(gnet->comments.size() == 1);
+    }
+    SECTION("Error message")
+    {
+        std::string dbc =
+            "VERSION \"\"\n"
+            "NS_ :\n"
+            "BS_:\n"
+            "BU_: A\n"
+            "BO_ 1 Msg: 8 A\n"
+            "BO_ 2 Msg2 8 A\n";
+        std::string error_message;
+        auto gnet = dbcppp::DBCX3::ParseFromMemoryParallel(dbc.c_str(), dbc.c_str() + dbc.size(), 4, 1, dbcppp::DBCX3::ParserHandler(), error_message);
+        REQUIRE(!gnet);
+        REQUIRE(!error_message.empty());
+    }
+}
+TEST_CASE("DBCParallelConversionTest", "[]")
+{
+    std::ostringstream dbc;
+    dbc << "VERSION \"\"\nNS_ :\nBS_:\nBU_: A B\n";
+    for (std::size_t i = 0; i < 1000; i++)
+    {
+        dbc << "BO_ " << i << " Msg" << i << ": 8 A\n";
+        dbc << " SG_ Mux M : 0|8@1+ (1,0) [0|0] \"\" B\n";
+        dbc << " SG_ Sig" << i << " m1 : 8|16@1- (0.5," << i << ") [0|100] \"km/h\" B\n";
+    }
+    dbc << "BO_TX_BU_ 7 : A,B;\n";
+    for (std::size_t i = 0; i < 1000; i += 3)
+    {
+        dbc << "CM_ BO_ " << i << " \"Message " << i << "\";\n";
+    }
+    dbc << "BA_DEF_ BO_ \"GenMsgCycleTime\" INT 0 1000;\n";
+    for (std::size_t i = 0; i < 1000; i += 3)
+    {
+        dbc << "BA_ \"GenMsgCycleTime\" BO_ " << i << " " << i << ";\n";
+    }
+    for (std::size_t i = 0; i < 1000; i += 3)
+    {
+        dbc << "VAL_ " << i << " Sig" << i << " 0 \"Zero\" 1 \"One\";\n";
+    }
+    dbc << "SIG_GROUP_ 7 Group 1 : Sig7 Mux;\n";
+    auto str = dbc.str();
+    std::string error_message;
+    auto gnet = dbcppp::DBCX3::ParseFromMemory(str.c_str(), str.c_str() + str.size(), error_message);
+    INFO(error_message);
+    REQUIRE(gnet);
+    auto spec = dbcppp::DBCAST2Network(*gnet, 1);
+    auto test = dbcppp::DBCAST2Network(*gnet, 4);
+    REQUIRE(test->Messages_Size() == 1000);
+    REQUIRE(*spec == *test);
+    REQUIRE(*test == *spec);
+    for (std::size_t i = 0; i < test->Messages_Size(); i++)
+    {
+        REQUIRE(test->Messages_Get(i).Id() == i);
+    }
+}
+TEST_CASE("DBCLoadNetworksFromFilesTest", "[]")
+{
+    std::vector<std::filesystem::path> filenames;
+    for (const auto& dbc_file : std::filesystem::directory_iterator(std::filesystem::path(TEST_FILES_PATH) / "dbc"))
+    {
+        if (dbc_file.path().extension() == ".dbc")
+        {
+            filenames.push_back(dbc_file.path());
+        }
+    }
+    std::sort(filenames.begin(), filenames.end());
+    dbcppp::LoadOptions options;
+    options.threads = 4;
+    SECTION("Same as merging the files sequentially")
+    {
+        std::string error_message;
+        auto spec = dbcppp::INetwork::LoadNetworkFromFile(filenames[0], error_message);
+        for (std::size_t i = 1; i < filenames.size(); i++)
+        {
+            spec->Merge(dbcppp::INetwork::LoadNetworkFromFile(filenames[i], error_message));
+        }
+        std::vector<std::string> error_messages;
+        auto test = dbcppp::INetwork::LoadNetworksFromFiles(filenames, options, error_messages);
+        REQUIRE(test);
+        REQUIRE(error_messages.size() == filenames.size());
+        REQUIRE(*spec == *test);
+        REQUIRE(*test == *spec);
+    }
+    SECTION("Errors are reported per file")
+    {
+        filenames.insert(filenames.begin() + 1, std::filesystem::path(TEST_FILES_PATH) / "dbc" / "does_not_exist.dbc");
+        std::vector<std::string> error_messages;
+        auto test = dbcppp::INetwork::LoadNetworksFromFiles(filenames, options, error_messages);
+        REQUIRE(!test);
+        REQUIRE(error_messages.size() == filenames.size());
+        REQUIRE(error_messages[0].empty());
+        REQUIRE(!error_messages[1].empty());
+        REQUIRE(error_messages[2].empty());
+    }
+}
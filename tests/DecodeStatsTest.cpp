@@ -0,0 +1,199 @@
+
+#include <array>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <sstream>
+
+#include "dbcppp/CApi.h"
+#include "dbcppp/Network.h"
+#include "dbcppp/DecodeStats.h"
+
+#include "Catch2.h"
+
+using namespace dbcppp;
+
+namespace
+{
+    constexpr const char* test_dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_:\n"
+        "BO_ 1 Msg1: 8 Vector__XXX\n"
+        " SG_ S : 0|8@1+ (1,0) [0|100] \"\" Vector__XXX\n"
+        " SG_ M M : 8|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        " SG_ A m0 : 16|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        " SG_ B m1 : 16|8@1+ (1,0) [0|10] \"\" Vector__XXX\n"
+        "BO_ 2 Msg2: 8 Vector__XXX\n"
+        " SG_ C : 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n";
+
+    // S, M, A/B, padding for the decoder
+    using Frame = std::array<uint8_t, 16>;
+    const Frame valid{50, 0, 0};
+    // S and B out of range
+    const Frame out_of_range{200, 1, 20};
+    // no signals are defined for M = 5
+    const Frame unmatched{0, 5, 0};
+}
+
+#ifndef DBCPPP_DISABLE_DECODE_STATS
+TEST_CASE("DecodeStatsTest", "[]")
+{
+    std::istringstream iss(test_dbc);
+    auto net = INetwork::LoadDBCFromIs(iss);
+    REQUIRE(net);
+
+    SECTION("RecordFrame")
+    {
+        DecodeStats stats(*net);
+        stats.RecordFrame(1, valid.data());
+        stats.RecordFrame(1, out_of_range.data());
+        stats.RecordFrame(1, unmatched.data());
+        stats.RecordFrame(2, valid.data());
+        stats.RecordFrame(3, valid.data());
+        auto snapshot = stats.Snapshot();
+        REQUIRE(snapshot.messages.size() == 2);
+        REQUIRE(snapshot.messages[0].frames == 3);
+        REQUIRE(snapshot.messages[0].signals_out_of_range == 2);
+        REQUIRE(snapshot.messages[0].unmatched_mux == 1);
+        REQUIRE(snapshot.messages[1].frames == 1);
+        REQUIRE(snapshot.messages[1].signals_out_of_range == 0);
+        REQUIRE(snapshot.total.frames == 4);
+        REQUIRE(snapshot.unknown_ids == 1);
+    }
+    SECTION("Disabled")
+    {
+        DecodeStats stats(*net, false);
+        stats.RecordFrame(1, valid.data());
+        stats.RecordUnknownId(3);
+        REQUIRE(stats.Snapshot().total.frames == 0);
+        REQUIRE(stats.Snapshot().unknown_ids == 0);
+        stats.Enable(true);
+        stats.RecordFrame(1, valid.data());
+        REQUIRE(stats.Snapshot().total.frames == 1);
+    }
+    SECTION("Threads")
+    {
+        DecodeStats stats(*net);
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < 4; i++)
+        {
+            threads.emplace_back(
+                [&]
+                {
+                    for (std::size_t j = 0; j < 1000; j++)
+                    {
+                        stats.RecordFrame(1, out_of_range.data());
+                    }
+                });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        auto snapshot = stats.Snapshot();
+        REQUIRE(snapshot.messages[0].frames == 4000);
+        REQUIRE(snapshot.messages[0].signals_out_of_range == 8000);
+    }
+    SECTION("Cascaded switches")
+    {
+        // B is only a switch of the frame if A selects it
+        constexpr const char* cascaded_dbc =
+            "VERSION \"\"\n"
+            "NS_ :\n"
+            "BS_:\n"
+            "BU_:\n"
+            "BO_ 1 Msg1: 8 Vector__XXX\n"
+            " SG_ A M : 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+            " SG_ B m2M : 8|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+            " SG_ C m1 : 16|8@1+ (1,0) [0|10] \"\" Vector__XXX\n"
+            "SG_MUL_VAL_ 1 B A 2-2;\n"
+            "SG_MUL_VAL_ 1 C B 1-1;\n";
+        std::istringstream cascaded_iss(cascaded_dbc);
+        auto cascaded = INetwork::LoadDBCFromIs(cascaded_iss);
+        REQUIRE(cascaded);
+        DecodeStats stats(*cascaded);
+        // C out of range, but not present if A doesn't select B
+        const Frame b_absent{3, 1, 20};
+        const Frame b_unmatched{2, 5, 20};
+        const Frame c_out_of_range{2, 1, 20};
+        stats.RecordFrame(1, b_absent.data());
+        stats.RecordFrame(1, b_unmatched.data());
+        stats.RecordFrame(1, c_out_of_range.data());
+        auto snapshot = stats.Snapshot();
+        REQUIRE(snapshot.messages[0].frames == 3);
+        REQUIRE(snapshot.messages[0].unmatched_mux == 2);
+        REQUIRE(snapshot.messages[0].signals_out_of_range == 1);
+    }
+    SECTION("Alternating stats")
+    {
+        // more stats than a thread caches the blocks of
+        std::vector<std::unique_ptr<DecodeStats>> all;
+        for (std::size_t i = 0; i < 6; i++)
+        {
+            all.push_back(std::make_unique<DecodeStats>(*net));
+        }
+        for (std::size_t j = 0; j < 10; j++)
+        {
+            for (std::size_t i = 0; i < all.size(); i++)
+            {
+                for (std::size_t k = 0; k <= i; k++)
+                {
+                    all[i]->RecordFrame(1, valid.data());
+                }
+            }
+        }
+        for (std::size_t i = 0; i < all.size(); i++)
+        {
+            REQUIRE(all[i]->Snapshot().messages[0].frames == 10 * (i + 1));
+        }
+    }
+    SECTION("C API")
+    {
+        auto cnet = dbcppp_NetworkLoadDBCFromMemory(test_dbc);
+        REQUIRE(cnet);
+        auto stats = dbcppp_DecodeStatsCreate(cnet);
+
+        // 8 byte frames, decoded through zero padded copies
+        std::array<uint32_t, 4> ids{1, 1, 2, 7};
+        std::array<uint8_t, 4 * 8> payloads{};
+        std::copy(out_of_range.begin(), out_of_range.begin() + 8, payloads.begin());
+        std::copy(unmatched.begin(), unmatched.begin() + 8, payloads.begin() + 8);
+        std::array<double, 4 * 4> values{};
+        REQUIRE(dbcppp_DecodeStatsDecodeFrames(stats, ids.data(), payloads.data(), 8, 4, values.data(), 4, nullptr) == 3);
+        REQUIRE(values[0] == 200);
+        REQUIRE(values[3] == 20);
+        dbcppp_DecodeStatsRecordFrames(stats, ids.data(), payloads.data(), 8, 4);
+
+        std::array<dbcppp_MessageDecodeStats, 2> messages{};
+        dbcppp_MessageDecodeStats total{};
+        REQUIRE(dbcppp_DecodeStatsSnapshot(stats, messages.data(), messages.size(), &total) == 2);
+        REQUIRE(messages[0].frames == 4);
+        REQUIRE(messages[0].signals_out_of_range == 4);
+        REQUIRE(messages[0].unmatched_mux == 2);
+        REQUIRE(messages[1].frames == 2);
+        REQUIRE(total.frames == 6);
+
+        dbcppp_DecodeStatsEnable(stats, 0);
+        dbcppp_DecodeStatsRecordFrames(stats, ids.data(), payloads.data(), 8, 4);
+        REQUIRE(dbcppp_DecodeStatsSnapshot(stats, nullptr, 0, &total) == 2);
+        REQUIRE(total.frames == 6);
+
+        dbcppp_DecodeStatsFree(stats);
+        dbcppp_NetworkFree(cnet);
+    }
+}
+#else
+TEST_CASE("DecodeStatsTest: Compiled out", "[]")
+{
+    std::istringstream iss(test_dbc);
+    auto net = INetwork::LoadDBCFromIs(iss);
+    REQUIRE(net);
+    DecodeStats stats(*net);
+    stats.RecordFrame(1, valid.data());
+    stats.RecordUnknownId(3);
+    REQUIRE(stats.Snapshot().total.frames == 0);
+    REQUIRE(stats.Snapshot().unknown_ids == 0);
+}
+#endif
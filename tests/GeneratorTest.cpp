@@ -0,0 +1,170 @@
+
+#include <array>
+#include <sstream>
+
+#include "dbcppp/Network.h"
+#include "dbcppp/Generator.h"
+
+#include "Catch2.h"
+
+using namespace dbcppp;
+
+namespace
+{
+    std::unique_ptr<INetwork> load(const Generator::DBCOptions& options)
+    {
+        std::istringstream iss(Generator::GenerateDBC(options));
+        std::string error;
+        auto net = INetwork::LoadDBCFromIs(iss, error);
+        INFO(error);
+        REQUIRE(net);
+        return net;
+    }
+    void check_layout(const INetwork& net, const Generator::DBCOptions& options)
+    {
+        REQUIRE(net.Messages_Size() == options.messages);
+        for (const IMessage& msg : net.Messages())
+        {
+            REQUIRE(msg.MessageSize() == (options.can_fd ? 64 : 8));
+            REQUIRE(msg.Signals_Size() == std::min<uint64_t>(options.signals_per_message, msg.MessageSize() * 8));
+            REQUIRE(!msg.Error(IMessage::EErrorCode::MuxValeWithoutMuxSignal));
+            // the signals must not overlap
+            std::array<uint8_t, 64 + 16> used{};
+            for (const ISignal& sig : msg.Signals())
+            {
+                REQUIRE(!sig.Error(ISignal::EErrorCode::SignalExceedsMessageSize));
+                std::array<uint8_t, 64 + 16> bits{};
+                sig.Encode(~uint64_t(0), bits.data());
+                for (std::size_t i = 0; i < bits.size(); i++)
+                {
+                    REQUIRE((used[i] & bits[i]) == 0);
+                    used[i] |= bits[i];
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("GeneratorTest", "[]")
+{
+    SECTION("The output only depends on the options")
+    {
+        Generator::DBCOptions options;
+        options.mux_depth = 2;
+        options.float_signals = true;
+        REQUIRE(Generator::GenerateDBC(options) == Generator::GenerateDBC(options));
+        auto other = options;
+        other.seed = 1;
+        REQUIRE(Generator::GenerateDBC(options) != Generator::GenerateDBC(other));
+    }
+    SECTION("Plain networks")
+    {
+        Generator::DBCOptions options;
+        options.messages = 50;
+        options.signals_per_message = 12;
+        auto net = load(options);
+        check_layout(*net, options);
+        REQUIRE(net->AttributeDefinitions_Size() > 0);
+        REQUIRE(net->Messages_Get(0).AttributeValues_Size() > 0);
+        REQUIRE(!net->Messages_Get(0).Comment().empty());
+        REQUIRE(!net->Messages_Get(0).Signals_Get(0).Comment().empty());
+
+        options.attributes = false;
+        options.comments = false;
+        net = load(options);
+        check_layout(*net, options);
+        REQUIRE(net->AttributeDefinitions_Size() == 0);
+        REQUIRE(net->Messages_Get(0).Comment().empty());
+    }
+    SECTION("Multiplexed networks")
+    {
+        Generator::DBCOptions options;
+        options.messages = 20;
+        options.signals_per_message = 10;
+        options.mux_depth = 1;
+        auto net = load(options);
+        check_layout(*net, options);
+        for (const IMessage& msg : net->Messages())
+        {
+            REQUIRE(msg.MuxSignal());
+            for (const ISignal& sig : msg.Signals())
+            {
+                REQUIRE(sig.SignalMultiplexerValues_Size() == 0);
+            }
+        }
+
+        options.extended_mux = true;
+        net = load(options);
+        check_layout(*net, options);
+        REQUIRE(net->Messages_Get(0).Signals_Get(2).SignalMultiplexerValues_Size() == 1);
+
+        options.mux_depth = 3;
+        options.can_fd = true;
+        options.float_signals = true;
+        options.double_signals = true;
+        net = load(options);
+        check_layout(*net, options);
+        const IMessage& msg = net->Messages_Get(0);
+        REQUIRE(msg.Signals_Get(0).MultiplexerIndicator() == ISignal::EMultiplexer::MuxSwitch);
+        REQUIRE(msg.Signals_Get(1).SignalMultiplexerValues_Get(0).SwitchName() == msg.Signals_Get(0).Name());
+        REQUIRE(msg.Signals_Get(2).SignalMultiplexerValues_Get(0).SwitchName() == msg.Signals_Get(1).Name());
+        REQUIRE(msg.Signals_Get(5).ExtendedValueType() == ISignal::EExtendedValueType::Float);
+        REQUIRE(msg.Signals_Get(6).ExtendedValueType() == ISignal::EExtendedValueType::Double);
+    }
+    SECTION("More messages than standard ids")
+    {
+        Generator::DBCOptions options;
+        options.messages = 3000;
+        options.signals_per_message = 2;
+        options.attributes = false;
+        options.comments = false;
+        auto net = load(options);
+        REQUIRE(net->Messages_Size() == 3000);
+        REQUIRE(net->Messages_Get(2999).Id() & 0x80000000);
+    }
+    SECTION("Frames")
+    {
+        Generator::DBCOptions options;
+        options.messages = 10;
+        options.mux_depth = 2;
+        options.mux_values = 3;
+        auto net = load(options);
+
+        Generator::FrameOptions frame_options;
+        frame_options.count = 500;
+        std::vector<Generator::Frame> frames;
+        Generator::GenerateFrames(*net, frame_options, [&](const Generator::Frame& frame) { frames.push_back(frame); });
+        REQUIRE(frames.size() == 500);
+        for (const auto& frame : frames)
+        {
+            const IMessage* msg = net->MessageById(frame.id);
+            REQUIRE(msg);
+            REQUIRE(frame.size == msg->MessageSize());
+            // the switches select one of the values defined for them
+            std::array<uint8_t, 64 + 16> data{};
+            std::copy(frame.data.begin(), frame.data.end(), data.begin());
+            REQUIRE(msg->Signals_Get(0).Decode(data.data()) < 3);
+            REQUIRE(msg->Signals_Get(1).Decode(data.data()) < 3);
+        }
+
+        std::ostringstream candump;
+        Generator::WriteFrames(candump, *net, frame_options);
+        std::istringstream lines(candump.str());
+        std::string line;
+        std::size_t i = 0;
+        for (; std::getline(lines, line); i++)
+        {
+            std::ostringstream expected;
+            expected << "  can0  " << std::hex << std::uppercase << frames[i].id << "   [8] ";
+            REQUIRE(line.rfind(expected.str(), 0) == 0);
+            REQUIRE(line.size() == expected.str().size() + 8 * 3);
+        }
+        REQUIRE(i == frames.size());
+
+        frame_options.format = Generator::EFrameFormat::Binary;
+        std::ostringstream binary;
+        Generator::WriteFrames(binary, *net, frame_options);
+        REQUIRE(binary.str().size() == 72 * frames.size());
+        REQUIRE(uint8_t(binary.str()[72 + 4]) == 8);
+    }
+}
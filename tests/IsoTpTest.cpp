@@ -0,0 +1,250 @@
+
+#include <vector>
+#include <sstream>
+
+#include "dbcppp/IsoTp.h"
+#include "dbcppp/Network.h"
+
+#include "Catch2.h"
+
+using namespace dbcppp;
+using namespace dbcppp::IsoTp;
+
+namespace
+{
+    constexpr const char* test_dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_:\n"
+        "BO_ 2024 Response: 32 Vector__XXX\n"
+        " SG_ Sid : 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        " SG_ Last : 248|8@1+ (1,0) [0|0] \"\" Vector__XXX\n";
+
+    std::vector<uint8_t> pdu_of(std::size_t size, uint8_t seed)
+    {
+        std::vector<uint8_t> pdu(size);
+        for (std::size_t i = 0; i < size; i++)
+        {
+            pdu[i] = uint8_t(seed + i * 3);
+        }
+        return pdu;
+    }
+
+    struct Bus
+    {
+        Bus(const ReassemblerOptions& options, const INetwork* net = nullptr)
+            : reassembler(options, [this](const Pdu& pdu) { OnPdu(pdu); }, net)
+        {}
+        void OnPdu(const Pdu& pdu)
+        {
+            pdus.push_back(pdu);
+            data.emplace_back(pdu.data, pdu.data + pdu.size);
+            if (pdu.message)
+            {
+                for (const ISignal& sig : pdu.message->Signals())
+                {
+                    raw_values.push_back(sig.Decode(pdu.data));
+                }
+            }
+        }
+        bool Send(uint32_t id, std::vector<uint8_t> frame, std::size_t frame_size = 8)
+        {
+            frame.resize(std::max(frame.size(), frame_size), 0xCC);
+            return reassembler.OnFrame(id, frame.data(), frame.size(), now_us += 1000);
+        }
+        void FlowControl(uint32_t id, uint8_t flow_status = 0)
+        {
+            REQUIRE(Send(id, {uint8_t(0x30 | flow_status), 0, 0}));
+        }
+        // sends pdu as first frame and consecutive frames, with one flow control frame after the first frame
+        void Segmented(const Channel& channel, const std::vector<uint8_t>& pdu, std::size_t frame_size = 8)
+        {
+            std::vector<uint8_t> first;
+            if (pdu.size() > 4095)
+            {
+                first = {0x10, 0x00, uint8_t(pdu.size() >> 24), uint8_t(pdu.size() >> 16), uint8_t(pdu.size() >> 8), uint8_t(pdu.size())};
+            }
+            else
+            {
+                first = {uint8_t(0x10 | (pdu.size() >> 8)), uint8_t(pdu.size())};
+            }
+            std::size_t offset = frame_size - first.size();
+            first.insert(first.end(), pdu.begin(), pdu.begin() + offset);
+            REQUIRE(Send(channel.id, first, frame_size));
+            FlowControl(channel.flow_control_id);
+            for (uint8_t sn = 1; offset < pdu.size(); sn++)
+            {
+                std::size_t length = std::min(pdu.size() - offset, frame_size - 1);
+                std::vector<uint8_t> consecutive{uint8_t(0x20 | (sn & 0xF))};
+                consecutive.insert(consecutive.end(), pdu.begin() + offset, pdu.begin() + offset + length);
+                REQUIRE(Send(channel.id, consecutive, frame_size));
+                offset += length;
+            }
+        }
+
+        Reassembler reassembler;
+        uint64_t now_us = 0;
+        std::vector<Pdu> pdus;
+        std::vector<std::vector<uint8_t>> data;
+        std::vector<uint64_t> raw_values;
+    };
+}
+
+TEST_CASE("IsoTpTest", "[]")
+{
+    // tester 0x7E0 and ECU 0x7E8 in both directions
+    ReassemblerOptions options;
+    options.channels = {{0x7E8, 0x7E0}, {0x7E0, 0x7E8}};
+    Bus bus(options);
+    const Channel& response = options.channels[0];
+    SECTION("Unknown id")
+    {
+        REQUIRE(!bus.Send(0x123, {0x02, 0x10, 0x01}));
+    }
+    SECTION("Single frame")
+    {
+        REQUIRE(bus.Send(0x7E0, {0x02, 0x10, 0x03}));
+        // CAN FD with the length in the second byte
+        auto pdu = pdu_of(40, 1);
+        std::vector<uint8_t> frame{0x00, 40};
+        frame.insert(frame.end(), pdu.begin(), pdu.end());
+        REQUIRE(bus.Send(0x7E8, frame, 48));
+        REQUIRE(bus.pdus.size() == 2);
+        REQUIRE(bus.pdus[0].channel->id == 0x7E0);
+        REQUIRE(bus.data[0] == std::vector<uint8_t>{0x10, 0x03});
+        REQUIRE(bus.pdus[1].channel->id == 0x7E8);
+        REQUIRE(bus.data[1] == pdu);
+        REQUIRE(bus.reassembler.Stats().completed == 2);
+    }
+    SECTION("Segmented")
+    {
+        // the sequence number wraps around
+        auto pdu = pdu_of(200, 5);
+        bus.Segmented(response, pdu);
+        REQUIRE(bus.pdus.size() == 1);
+        REQUIRE(bus.data[0] == pdu);
+        REQUIRE(bus.reassembler.ActiveSessions() == 0);
+    }
+    SECTION("CAN FD")
+    {
+        auto pdu = pdu_of(1000, 9);
+        bus.Segmented(response, pdu, 64);
+        REQUIRE(bus.pdus.size() == 1);
+        REQUIRE(bus.data[0] == pdu);
+    }
+    SECTION("Sequence error")
+    {
+        REQUIRE(bus.Send(0x7E8, {0x10, 20, 1, 2, 3, 4, 5, 6}));
+        REQUIRE(bus.reassembler.ActiveSessions() == 1);
+        REQUIRE(bus.Send(0x7E8, {0x22, 7, 8, 9, 10, 11, 12, 13}));
+        REQUIRE(bus.reassembler.ActiveSessions() == 0);
+        REQUIRE(bus.reassembler.Stats().sequence_errors == 1);
+        // without a PDU in progress consecutive frames are ignored
+        REQUIRE(bus.Send(0x7E8, {0x21, 7, 8, 9, 10, 11, 12, 13}));
+        REQUIRE(bus.pdus.empty());
+    }
+    SECTION("Abort")
+    {
+        REQUIRE(bus.Send(0x7E8, {0x10, 20, 1, 2, 3, 4, 5, 6}));
+        REQUIRE(bus.Send(0x7E8, {0x10, 30, 1, 2, 3, 4, 5, 6}));
+        REQUIRE(bus.reassembler.ActiveSessions() == 1);
+        bus.FlowControl(0x7E0, 2);
+        REQUIRE(bus.reassembler.ActiveSessions() == 0);
+        REQUIRE(bus.reassembler.Stats().aborted == 2);
+    }
+    SECTION("Timeout")
+    {
+        REQUIRE(bus.Send(0x7E8, {0x10, 20, 1, 2, 3, 4, 5, 6}));
+        bus.now_us += 900000;
+        // wait
+        bus.FlowControl(0x7E0, 1);
+        bus.now_us += 900000;
+        REQUIRE(bus.Send(0x7E8, {0x21, 7, 8, 9, 10, 11, 12, 13}));
+        REQUIRE(bus.reassembler.ActiveSessions() == 1);
+        bus.reassembler.Expire(bus.now_us + 1000001);
+        REQUIRE(bus.reassembler.ActiveSessions() == 0);
+        REQUIRE(bus.reassembler.Stats().timed_out == 1);
+    }
+    SECTION("Rejected")
+    {
+        // too large for the pool
+        REQUIRE(bus.Send(0x7E8, {0x10, 0x00, 0x00, 0x00, 0x20, 0x00, 1, 2}));
+        // fits into one frame
+        REQUIRE(bus.Send(0x7E8, {0x10, 6, 1, 2, 3, 4, 5, 6}));
+        // no length
+        REQUIRE(bus.Send(0x7E8, {0x00, 1, 2}));
+        REQUIRE(bus.reassembler.ActiveSessions() == 0);
+        REQUIRE(bus.reassembler.Stats().rejected == 3);
+    }
+}
+TEST_CASE("IsoTpTest: Buffers", "[]")
+{
+    std::vector<uint8_t> buffer(6000 + 8);
+    ReassemblerOptions options;
+    options.channels = {{0x700, 0x708}, {0x701, 0x709}, {0x702, 0x70A, buffer.data(), buffer.size()}};
+    options.pooled_buffers = 1;
+    Bus bus(options);
+    REQUIRE(bus.Send(0x700, {0x10, 20, 1, 2, 3, 4, 5, 6}));
+    // the pool is exhausted
+    REQUIRE(bus.Send(0x701, {0x10, 20, 1, 2, 3, 4, 5, 6}));
+    REQUIRE(bus.reassembler.Stats().rejected == 1);
+    // larger than the pool allows, into the buffer of the channel
+    auto pdu = pdu_of(6000, 0);
+    bus.Segmented(options.channels[2], pdu);
+    REQUIRE(bus.pdus.size() == 1);
+    REQUIRE(bus.pdus[0].data == buffer.data());
+    REQUIRE(bus.data[0] == pdu);
+    REQUIRE(bus.reassembler.ActiveSessions() == 1);
+}
+TEST_CASE("IsoTpTest: Parallel sessions", "[]")
+{
+    ReassemblerOptions options;
+    for (uint32_t i = 0; i < 500; i++)
+    {
+        options.channels.push_back({0x80000000 | (0x18DAF100 + i), 0x80000000 | (0x18DA00F1 + i * 0x100)});
+    }
+    options.pooled_buffers = 500;
+    Bus bus(options);
+    std::vector<std::vector<uint8_t>> pdus;
+    for (uint32_t i = 0; i < 500; i++)
+    {
+        pdus.push_back(pdu_of(50 + i % 50, uint8_t(i)));
+        REQUIRE(bus.Send(options.channels[i].id, {0x10, uint8_t(pdus[i].size()), pdus[i][0], pdus[i][1], pdus[i][2], pdus[i][3], pdus[i][4], pdus[i][5]}));
+    }
+    REQUIRE(bus.reassembler.ActiveSessions() == 500);
+    for (uint8_t sn = 1; sn <= 14; sn++)
+    {
+        for (uint32_t i = 0; i < 500; i++)
+        {
+            std::size_t offset = 6 + (sn - 1) * 7u;
+            if (offset < pdus[i].size())
+            {
+                std::vector<uint8_t> frame{uint8_t(0x20 | (sn & 0xF))};
+                frame.insert(frame.end(), pdus[i].begin() + offset, pdus[i].begin() + std::min(offset + 7, pdus[i].size()));
+                REQUIRE(bus.Send(options.channels[i].id, frame));
+            }
+        }
+    }
+    REQUIRE(bus.reassembler.ActiveSessions() == 0);
+    REQUIRE(bus.pdus.size() == 500);
+    for (std::size_t k = 0; k < bus.pdus.size(); k++)
+    {
+        REQUIRE(bus.data[k] == pdus[bus.pdus[k].channel->id - (0x80000000 | 0x18DAF100)]);
+    }
+}
+TEST_CASE("IsoTpTest: Decode", "[]")
+{
+    std::istringstream iss(test_dbc);
+    auto net = INetwork::LoadDBCFromIs(iss);
+    REQUIRE(net);
+    ReassemblerOptions options;
+    options.channels = {{2024, 2016}};
+    Bus bus(options, net.get());
+    // a longer PDU leaves garbage in the pooled buffer
+    bus.Segmented(options.channels[0], std::vector<uint8_t>(40, 0xAA));
+    bus.Segmented(options.channels[0], pdu_of(20, 0x62));
+    REQUIRE(bus.pdus.size() == 2);
+    REQUIRE(bus.pdus[1].message == &net->Messages_Get(0));
+    REQUIRE(bus.raw_values == std::vector<uint64_t>{0xAA, 0xAA, 0x62, 0});
+}
@@ -0,0 +1,361 @@
+
+#include <vector>
+#include <sstream>
+
+#include "dbcppp/CApi.h"
+#include "dbcppp/J1939.h"
+#include "dbcppp/Network.h"
+
+#include "Catch2.h"
+
+using namespace dbcppp;
+using namespace dbcppp::J1939;
+
+namespace
+{
+    constexpr const char* test_dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_:\n"
+        "BO_ 2566834942 DM1: 20 Vector__XXX\n"
+        " SG_ Lamps : 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        " SG_ Last : 144|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        "BO_ 2565800190 PropA: 8 Vector__XXX\n"
+        "BO_ 2565804286 PropA_10: 8 Vector__XXX\n"
+        "BO_ 0 Standard: 8 Vector__XXX\n";
+
+    uint32_t can_id(uint8_t priority, uint32_t pgn, uint8_t source, uint8_t destination = GlobalAddress)
+    {
+        uint32_t ps = ((pgn >> 8) & 0xFF) < 240 ? destination : 0;
+        return (uint32_t(priority) << 26) | ((pgn | ps) << 8) | source;
+    }
+    std::vector<uint8_t> payload_of(std::size_t size, uint8_t seed)
+    {
+        std::vector<uint8_t> payload(size);
+        for (std::size_t i = 0; i < size; i++)
+        {
+            payload[i] = uint8_t(seed + i);
+        }
+        return payload;
+    }
+
+    struct Bus
+    {
+        Bus(const ReassemblerOptions& options = ReassemblerOptions(), const INetwork* net = nullptr)
+            : reassembler(options, [this](const Payload& payload) { OnPayload(payload); }, net)
+        {}
+        void OnPayload(const Payload& payload)
+        {
+            payloads.push_back(payload);
+            data.emplace_back(payload.data, payload.data + payload.size);
+            if (payload.message)
+            {
+                for (const ISignal& sig : payload.message->Signals())
+                {
+                    raw_values.push_back(sig.Decode(payload.data));
+                }
+            }
+        }
+        bool Send(uint32_t id, std::vector<uint8_t> frame)
+        {
+            frame.resize(8, 0xFF);
+            return reassembler.OnFrame(id, frame.data(), frame.size(), now_us += 1000);
+        }
+        void Cm(uint8_t source, uint8_t destination, std::vector<uint8_t> frame)
+        {
+            REQUIRE(Send(can_id(7, PGN_TP_CM, source, destination), std::move(frame)));
+        }
+        void Dt(uint8_t source, uint8_t destination, const std::vector<uint8_t>& payload, uint8_t seq)
+        {
+            std::vector<uint8_t> frame{seq};
+            for (std::size_t i = (seq - 1) * 7u; i < payload.size() && frame.size() < 8; i++)
+            {
+                frame.push_back(payload[i]);
+            }
+            REQUIRE(Send(can_id(7, PGN_TP_DT, source, destination), std::move(frame)));
+        }
+        void Bam(uint8_t source, uint32_t pgn, const std::vector<uint8_t>& payload)
+        {
+            uint8_t packets = uint8_t((payload.size() + 6) / 7);
+            Cm(source, GlobalAddress, {32, uint8_t(payload.size()), uint8_t(payload.size() >> 8), packets, 0xFF
+                , uint8_t(pgn), uint8_t(pgn >> 8), uint8_t(pgn >> 16)});
+            for (uint8_t seq = 1; seq <= packets; seq++)
+            {
+                Dt(source, GlobalAddress, payload, seq);
+            }
+        }
+
+        Reassembler reassembler;
+        uint64_t now_us = 0;
+        std::vector<Payload> payloads;
+        std::vector<std::vector<uint8_t>> data;
+        std::vector<uint64_t> raw_values;
+    };
+}
+
+TEST_CASE("J1939Test: ParseId", "[]")
+{
+    // PDU1, TP.CM from 0x00 to 0xF9
+    constexpr Id tp_cm = ParseId(0x1CECF900);
+    static_assert(tp_cm.priority == 7 && tp_cm.pgn == PGN_TP_CM && tp_cm.source == 0x00 && tp_cm.destination == 0xF9);
+    // PDU2, DM1 from 0xFE, the extended id flag of the DBC is ignored
+    constexpr Id dm1 = ParseId(2566834942);
+    static_assert(dm1.priority == 6 && dm1.pgn == 0xFECA && dm1.source == 0xFE && dm1.destination == GlobalAddress);
+    // data page
+    REQUIRE(ParseId(0x0DFE0001).pgn == 0x1FE00);
+}
+TEST_CASE("J1939Test: MessageByJ1939Id", "[]")
+{
+    std::istringstream iss(test_dbc);
+    auto net = INetwork::LoadDBCFromIs(iss);
+    REQUIRE(net);
+    const IMessage& dm1 = net->Messages_Get(0);
+    const IMessage& prop_a = net->Messages_Get(1);
+    Id id;
+    // another priority and source address
+    REQUIRE(net->MessageByJ1939Id(can_id(3, 0xFECA, 0x21), &id) == &dm1);
+    REQUIRE(id.priority == 3);
+    REQUIRE(id.pgn == 0xFECA);
+    REQUIRE(id.source == 0x21);
+    REQUIRE(id.destination == GlobalAddress);
+    // PDU1: the first message of the PGN, whatever destination address it has in the DBC
+    REQUIRE(net->MessageByJ1939Id(can_id(6, 0xEF00, 0x21, 0x10), &id) == &prop_a);
+    REQUIRE(id.destination == 0x10);
+    REQUIRE(net->MessageByJ1939Id(can_id(6, 0xEF00, 0x21, 0x42)) == &prop_a);
+    // standard ids aren't PGs
+    REQUIRE(net->MessageByJ1939Id(0) == nullptr);
+    REQUIRE(net->MessageByJ1939Id(can_id(6, 0xFECB, 0x21)) == nullptr);
+
+    dbcppp_J1939Id c_id;
+    auto c_net = reinterpret_cast<const dbcppp_Network*>(net.get());
+    REQUIRE(dbcppp_NetworkMessageByJ1939Id(c_net, can_id(6, 0xEF00, 0x21, 0x10), &c_id) == reinterpret_cast<const dbcppp_Message*>(&prop_a));
+    REQUIRE(c_id.pgn == 0xEF00);
+    REQUIRE(c_id.source == 0x21);
+    REQUIRE(c_id.destination == 0x10);
+    REQUIRE(dbcppp_NetworkMessageByJ1939Id(c_net, can_id(6, 0xFECA, 0x21), nullptr) == reinterpret_cast<const dbcppp_Message*>(&dm1));
+}
+TEST_CASE("J1939Test: MessageByJ1939Id source address", "[]")
+{
+    // PGN 0xFF00 sent by 0x10 and 0x20 with different layouts
+    constexpr const char* sources_dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_:\n"
+        "BO_ 2566848528 Prop_10: 8 Vector__XXX\n"
+        " SG_ A : 0|16@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        "BO_ 2566848544 Prop_20: 8 Vector__XXX\n"
+        " SG_ B : 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        " SG_ C : 8|8@1+ (1,0) [0|0] \"\" Vector__XXX\n";
+    std::istringstream iss(sources_dbc);
+    auto net = INetwork::LoadDBCFromIs(iss);
+    REQUIRE(net);
+    const IMessage& prop_10 = net->Messages_Get(0);
+    const IMessage& prop_20 = net->Messages_Get(1);
+    REQUIRE(net->MessageByJ1939Id(can_id(6, 0xFF00, 0x10)) == &prop_10);
+    REQUIRE(net->MessageByJ1939Id(can_id(3, 0xFF00, 0x20)) == &prop_20);
+    const uint8_t frame[8] = {1, 2};
+    REQUIRE(net->MessageByJ1939Id(can_id(3, 0xFF00, 0x20))->Signals_Get(1).Decode(frame) == 2);
+    // no message for the source address, the first one of the PGN
+    REQUIRE(net->MessageByJ1939Id(can_id(6, 0xFF00, 0x30)) == &prop_10);
+    REQUIRE(net->MessageByJ1939Id(can_id(6, 0xFF01, 0x10)) == nullptr);
+}
+TEST_CASE("J1939Test: Transport protocol", "[]")
+{
+    Bus bus;
+    SECTION("Not a transport protocol frame")
+    {
+        REQUIRE(!bus.Send(can_id(6, 0xFECA, 0x10), {}));
+        REQUIRE(!bus.Send(0x123, {}));
+    }
+    SECTION("BAM")
+    {
+        auto payload = payload_of(20, 1);
+        bus.Bam(0x10, 0xFECA, payload);
+        REQUIRE(bus.payloads.size() == 1);
+        REQUIRE(bus.payloads[0].id.pgn == 0xFECA);
+        REQUIRE(bus.payloads[0].id.source == 0x10);
+        REQUIRE(bus.payloads[0].id.destination == GlobalAddress);
+        REQUIRE(bus.payloads[0].id.priority == 7);
+        REQUIRE(bus.payloads[0].message == nullptr);
+        REQUIRE(bus.data[0] == payload);
+        REQUIRE(bus.reassembler.ActiveSessions() == 0);
+        REQUIRE(bus.reassembler.Stats().completed == 1);
+    }
+    SECTION("RTS/CTS")
+    {
+        auto payload = payload_of(30, 7);
+        // RTS for 5 packets, at most 2 per CTS
+        bus.Cm(0x20, 0x30, {16, 30, 0, 5, 2, 0x00, 0xEF, 0x00});
+        bus.Cm(0x30, 0x20, {17, 2, 1, 0xFF, 0xFF, 0x00, 0xEF, 0x00});
+        bus.Dt(0x20, 0x30, payload, 1);
+        bus.Dt(0x20, 0x30, payload, 2);
+        // hold the connection open, then request a retransmission of packet 2
+        bus.Cm(0x30, 0x20, {17, 0, 0xFF, 0xFF, 0xFF, 0x00, 0xEF, 0x00});
+        bus.Cm(0x30, 0x20, {17, 2, 2, 0xFF, 0xFF, 0x00, 0xEF, 0x00});
+        bus.Dt(0x20, 0x30, payload, 2);
+        bus.Dt(0x20, 0x30, payload, 3);
+        bus.Cm(0x30, 0x20, {17, 2, 4, 0xFF, 0xFF, 0x00, 0xEF, 0x00});
+        bus.Dt(0x20, 0x30, payload, 4);
+        REQUIRE(bus.payloads.empty());
+        bus.Dt(0x20, 0x30, payload, 5);
+        REQUIRE(bus.payloads.size() == 1);
+        REQUIRE(bus.payloads[0].id.pgn == 0xEF00);
+        REQUIRE(bus.payloads[0].id.source == 0x20);
+        REQUIRE(bus.payloads[0].id.destination == 0x30);
+        REQUIRE(bus.data[0] == payload);
+        bus.Cm(0x30, 0x20, {19, 30, 0, 5, 0xFF, 0x00, 0xEF, 0x00});
+        REQUIRE(bus.reassembler.Stats().completed == 1);
+        REQUIRE(bus.reassembler.Stats().sequence_errors == 0);
+    }
+    SECTION("Sequence error")
+    {
+        auto payload = payload_of(20, 0);
+        bus.Cm(0x10, GlobalAddress, {32, 20, 0, 3, 0xFF, 0xCA, 0xFE, 0x00});
+        bus.Dt(0x10, GlobalAddress, payload, 1);
+        bus.Dt(0x10, GlobalAddress, payload, 3);
+        bus.Dt(0x10, GlobalAddress, payload, 2);
+        REQUIRE(bus.payloads.empty());
+        REQUIRE(bus.reassembler.ActiveSessions() == 0);
+        REQUIRE(bus.reassembler.Stats().sequence_errors == 1);
+    }
+    SECTION("Abort")
+    {
+        bus.Cm(0x20, 0x30, {16, 30, 0, 5, 2, 0x00, 0xEF, 0x00});
+        REQUIRE(bus.reassembler.ActiveSessions() == 1);
+        // by the receiver
+        bus.Cm(0x30, 0x20, {255, 1, 0xFF, 0xFF, 0xFF, 0x00, 0xEF, 0x00});
+        REQUIRE(bus.reassembler.ActiveSessions() == 0);
+        // a new RTS replaces the session of the same pair
+        bus.Cm(0x20, 0x30, {16, 30, 0, 5, 2, 0x00, 0xEF, 0x00});
+        bus.Cm(0x20, 0x30, {16, 9, 0, 2, 2, 0x00, 0xEF, 0x00});
+        REQUIRE(bus.reassembler.ActiveSessions() == 1);
+        REQUIRE(bus.reassembler.Stats().aborted == 2);
+    }
+    SECTION("Timeout")
+    {
+        auto payload = payload_of(20, 0);
+        bus.Cm(0x10, GlobalAddress, {32, 20, 0, 3, 0xFF, 0xCA, 0xFE, 0x00});
+        bus.Dt(0x10, GlobalAddress, payload, 1);
+        bus.reassembler.Expire(bus.now_us + 1250000);
+        REQUIRE(bus.reassembler.ActiveSessions() == 1);
+        bus.now_us += 1250001;
+        bus.Dt(0x10, GlobalAddress, payload, 2);
+        REQUIRE(bus.reassembler.ActiveSessions() == 0);
+        REQUIRE(bus.reassembler.Stats().timed_out == 1);
+        REQUIRE(bus.payloads.empty());
+    }
+    SECTION("Rejected")
+    {
+        // inconsistent number of packets
+        bus.Cm(0x10, GlobalAddress, {32, 20, 0, 4, 0xFF, 0xCA, 0xFE, 0x00});
+        // larger than TP allows
+        bus.Cm(0x11, GlobalAddress, {32, 0xFA, 0x06, 255, 0xFF, 0xCA, 0xFE, 0x00});
+        REQUIRE(bus.reassembler.ActiveSessions() == 0);
+        REQUIRE(bus.reassembler.Stats().rejected == 2);
+    }
+}
+TEST_CASE("J1939Test: Session limits", "[]")
+{
+    ReassemblerOptions options;
+    options.max_sessions = 2;
+    options.max_size = 64;
+    Bus bus(options);
+    bus.Cm(0x10, GlobalAddress, {32, 20, 0, 3, 0xFF, 0xCA, 0xFE, 0x00});
+    bus.Cm(0x11, GlobalAddress, {32, 20, 0, 3, 0xFF, 0xCA, 0xFE, 0x00});
+    bus.Cm(0x12, GlobalAddress, {32, 20, 0, 3, 0xFF, 0xCA, 0xFE, 0x00});
+    bus.Cm(0x13, GlobalAddress, {32, 65, 0, 10, 0xFF, 0xCA, 0xFE, 0x00});
+    REQUIRE(bus.reassembler.ActiveSessions() == 2);
+    REQUIRE(bus.reassembler.Stats().rejected == 2);
+}
+TEST_CASE("J1939Test: Interleaved sessions", "[]")
+{
+    // every pair of 45 sources and destinations has a RTS/CTS session open at the same time
+    ReassemblerOptions options;
+    options.max_sessions = 45 * 45;
+    // the frames are 1 ms apart
+    options.timeout_us = 60000000;
+    Bus bus(options);
+    std::vector<std::vector<uint8_t>> payloads;
+    for (uint8_t source = 0; source < 45; source++)
+    {
+        for (uint8_t destination = 0; destination < 45; destination++)
+        {
+            payloads.push_back(payload_of(100 + source, destination));
+            uint8_t size = uint8_t(payloads.back().size());
+            bus.Cm(source, 100 + destination, {16, size, 0, uint8_t((size + 6) / 7), 0xFF, 0x00, 0xEF, 0x00});
+        }
+    }
+    REQUIRE(bus.reassembler.ActiveSessions() == 45 * 45);
+    for (uint8_t seq = 1; seq <= 21; seq++)
+    {
+        std::size_t i = 0;
+        for (uint8_t source = 0; source < 45; source++)
+        {
+            for (uint8_t destination = 0; destination < 45; destination++, i++)
+            {
+                if ((seq - 1) * 7u < payloads[i].size())
+                {
+                    bus.Dt(source, 100 + destination, payloads[i], seq);
+                }
+            }
+        }
+    }
+    REQUIRE(bus.reassembler.ActiveSessions() == 0);
+    REQUIRE(bus.payloads.size() == 45 * 45);
+    REQUIRE(bus.reassembler.Stats().completed == 45 * 45);
+    for (std::size_t i = 0; i < bus.payloads.size(); i++)
+    {
+        const auto& id = bus.payloads[i].id;
+        REQUIRE(bus.data[i] == payloads[id.source * 45 + id.destination - 100]);
+    }
+}
+TEST_CASE("J1939Test: Extended transport protocol", "[]")
+{
+    ReassemblerOptions options;
+    options.max_size = 4096;
+    Bus bus(options);
+    auto payload = payload_of(4000, 3);
+    uint32_t packets = (4000 + 6) / 7;
+    auto etp_cm = [&](uint8_t source, uint8_t destination, std::vector<uint8_t> frame)
+        {
+            REQUIRE(bus.Send(can_id(7, PGN_ETP_CM, source, destination), std::move(frame)));
+        };
+    etp_cm(0x20, 0x30, {20, 0xA0, 0x0F, 0x00, 0x00, 0x00, 0xEF, 0x00});
+    for (uint32_t next = 1; next <= packets; next += 255)
+    {
+        uint8_t count = uint8_t(std::min<uint32_t>(255, packets - next + 1));
+        etp_cm(0x30, 0x20, {21, count, uint8_t(next), uint8_t(next >> 8), uint8_t(next >> 16), 0x00, 0xEF, 0x00});
+        uint32_t offset = next - 1;
+        etp_cm(0x20, 0x30, {22, count, uint8_t(offset), uint8_t(offset >> 8), uint8_t(offset >> 16), 0x00, 0xEF, 0x00});
+        for (uint32_t seq = 1; seq <= count; seq++)
+        {
+            std::vector<uint8_t> frame{uint8_t(seq)};
+            for (std::size_t i = (offset + seq - 1) * 7; i < payload.size() && frame.size() < 8; i++)
+            {
+                frame.push_back(payload[i]);
+            }
+            REQUIRE(bus.Send(can_id(7, PGN_ETP_DT, 0x20, 0x30), std::move(frame)));
+        }
+    }
+    REQUIRE(bus.payloads.size() == 1);
+    REQUIRE(bus.payloads[0].id.pgn == 0xEF00);
+    REQUIRE(bus.data[0] == payload);
+    REQUIRE(bus.reassembler.Stats().sequence_errors == 0);
+}
+TEST_CASE("J1939Test: Decode", "[]")
+{
+    std::istringstream iss(test_dbc);
+    auto net = INetwork::LoadDBCFromIs(iss);
+    REQUIRE(net);
+    Bus bus(ReassemblerOptions(), net.get());
+    // a longer payload leaves garbage in the buffer of the session slot
+    bus.Bam(0x00, 0xFECA, std::vector<uint8_t>(40, 0xAA));
+    auto payload = payload_of(17, 1);
+    bus.Bam(0x00, 0xFECA, payload);
+    REQUIRE(bus.payloads.size() == 2);
+    REQUIRE(bus.payloads[1].message == &net->Messages_Get(0));
+    // the signal behind the transported bytes is decoded from the zeroed padding
+    REQUIRE(bus.raw_values == std::vector<uint64_t>{0xAA, 0xAA, 1, 0});
+}
@@ -0,0 +1,88 @@
+
+#include <sstream>
+#include <algorithm>
+
+#include "dbcppp/Network.h"
+#include "dbcppp/Generator.h"
+
+#include "Catch2.h"
+
+using namespace dbcppp;
+
+namespace
+{
+    std::vector<std::string> phase_names(const LoadStats& stats)
+    {
+        std::vector<std::string> names;
+        for (const auto& phase : stats.phases)
+        {
+            REQUIRE(phase.wall_time_ms >= 0);
+            names.push_back(phase.name);
+        }
+        return names;
+    }
+    uint64_t count_of(const std::vector<LoadStats::NodeCount>& nodes, const std::string& name)
+    {
+        auto iter = std::find_if(nodes.begin(), nodes.end(), [&](const auto& node) { return node.name == name; });
+        REQUIRE(iter != nodes.end());
+        return iter->count;
+    }
+    const LoadStats::Entity& entity(const LoadStats& stats, const std::string& name)
+    {
+        auto iter = std::find_if(stats.footprint.begin(), stats.footprint.end(), [&](const auto& entity) { return entity.name == name; });
+        REQUIRE(iter != stats.footprint.end());
+        return *iter;
+    }
+}
+
+TEST_CASE("LoadStatsTest", "[]")
+{
+    Generator::DBCOptions dbc_options;
+    dbc_options.messages = 300;
+    dbc_options.signals_per_message = 6;
+    const std::string dbc = Generator::GenerateDBC(dbc_options);
+
+    LoadStats stats;
+    LoadOptions options;
+    options.stats = &stats;
+    std::string error;
+    SECTION("Sequential")
+    {
+        std::istringstream iss(dbc);
+        auto net = INetwork::LoadDBCFromIs(iss, options, error);
+        REQUIRE(net);
+        REQUIRE(phase_names(stats) == std::vector<std::string>{"read", "parse", "create objects", "build network"});
+    }
+    SECTION("Parallel")
+    {
+        REQUIRE(dbc.size() > 256 * 1024);
+        options.threads = 2;
+        std::istringstream iss(dbc);
+        auto net = INetwork::LoadDBCFromIs(iss, options, error);
+        REQUIRE(net);
+        REQUIRE(phase_names(stats) == std::vector<std::string>{"read", "parse", "build cache", "create objects", "build network"});
+    }
+    REQUIRE(count_of(stats.ast_nodes, "messages") == 300);
+    REQUIRE(count_of(stats.ast_nodes, "signals") == 300 * 6);
+    REQUIRE(count_of(stats.ast_nodes, "comments") > 0);
+    REQUIRE(entity(stats, "messages").count == 300);
+    REQUIRE(entity(stats, "signals").count == 300 * 6);
+    REQUIRE(entity(stats, "signals").bytes > 300 * 6 * 64);
+    REQUIRE(entity(stats, "network").count == 1);
+}
+TEST_CASE("LoadStatsTest: Skipped statements", "[]")
+{
+    Generator::DBCOptions dbc_options;
+    dbc_options.messages = 10;
+    std::istringstream iss(Generator::GenerateDBC(dbc_options));
+    LoadStats stats;
+    LoadOptions options = LoadOptions::DecodeOnly();
+    options.stats = &stats;
+    std::string error;
+    auto net = INetwork::LoadDBCFromIs(iss, options, error);
+    REQUIRE(net);
+    REQUIRE(count_of(stats.ast_nodes, "messages") == 10);
+    REQUIRE(count_of(stats.ast_nodes, "comments") == 0);
+    REQUIRE(count_of(stats.ast_nodes, "attribute values") == 0);
+    REQUIRE(entity(stats, "attributes").count == 0);
+}
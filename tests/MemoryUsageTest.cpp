@@ -0,0 +1,76 @@
+
+#include <sstream>
+
+#include "dbcppp/Network.h"
+#include "dbcppp/Generator.h"
+
+#include "Catch2.h"
+
+using namespace dbcppp;
+
+namespace
+{
+    std::unique_ptr<INetwork> load(const Generator::DBCOptions& dbc_options, const LoadOptions& options = LoadOptions(), LoadStats* stats = nullptr)
+    {
+        std::istringstream iss(Generator::GenerateDBC(dbc_options));
+        LoadOptions load_options = options;
+        load_options.stats = stats;
+        std::string error;
+        auto net = INetwork::LoadDBCFromIs(iss, load_options, error);
+        REQUIRE(net);
+        return net;
+    }
+}
+
+TEST_CASE("MemoryUsageTest", "[]")
+{
+    Generator::DBCOptions dbc_options;
+    dbc_options.messages = 50;
+    dbc_options.signals_per_message = 8;
+    SECTION("Categories")
+    {
+        LoadStats stats;
+        auto net = load(dbc_options, LoadOptions(), &stats);
+        auto usage = net->MemoryUsage();
+        REQUIRE(usage.signal_hot_data > 50 * 8 * 64);
+        REQUIRE(usage.names > 0);
+        REQUIRE(usage.comments > 0);
+        REQUIRE(usage.attributes > 0);
+        REQUIRE(usage.value_descriptions > 0);
+        REQUIRE(usage.mux_metadata == 0);
+        REQUIRE(usage.indices > 0);
+        REQUIRE(usage.other > 0);
+
+        // the footprint of the load stats is the same walk by entity type
+        uint64_t footprint = 0;
+        for (const auto& entity : stats.footprint)
+        {
+            footprint += entity.bytes;
+        }
+        REQUIRE(footprint == usage.Total());
+
+        net->MessageById(net->Messages_Get(0).Id());
+        REQUIRE(net->MemoryUsage().indices > usage.indices);
+        REQUIRE(net->MemoryUsage().Total() - usage.Total() == net->MemoryUsage().indices - usage.indices);
+    }
+    SECTION("Signals")
+    {
+        auto usage = load(dbc_options)->MemoryUsage();
+        dbc_options.signals_per_message = 16;
+        REQUIRE(load(dbc_options)->MemoryUsage().signal_hot_data > usage.signal_hot_data);
+    }
+    SECTION("Multiplexing")
+    {
+        dbc_options.mux_depth = 2;
+        REQUIRE(load(dbc_options)->MemoryUsage().mux_metadata > 0);
+    }
+    SECTION("DecodeOnly")
+    {
+        auto usage = load(dbc_options)->MemoryUsage();
+        auto decode_only = load(dbc_options, LoadOptions::DecodeOnly())->MemoryUsage();
+        REQUIRE(decode_only.comments == 0);
+        REQUIRE(decode_only.attributes == 0);
+        REQUIRE(decode_only.signal_hot_data == usage.signal_hot_data);
+        REQUIRE(decode_only.Total() < usage.Total());
+    }
+}
@@ -0,0 +1,291 @@
+
+#include <map>
+#include <set>
+#include <array>
+#include <cmath>
+#include <random>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <filesystem>
+
+#include "dbcppp/Network.h"
+#include "dbcppp/Network2Functions.h"
+
+#include "Config.h"
+#include "Multiplexer.h"
+
+#include "Catch2.h"
+
+namespace
+{
+    bool same_phys(double lhs, double rhs)
+    {
+        if (std::isnan(lhs) || std::isnan(rhs))
+        {
+            return std::isnan(lhs) && std::isnan(rhs);
+        }
+        return std::abs(lhs - rhs) <= 1e-9 * std::max(1., std::abs(lhs));
+    }
+    bool extended_mux(const dbcppp::IMessage& msg)
+    {
+        for (const dbcppp::ISignal& sig : msg.Signals())
+        {
+            if (sig.SignalMultiplexerValues_Size())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+// Compiles the generated C code of every test DBC together with a small program which unpacks and packs
+// a random frame for every message, and compares the results with the library's decoding. Messages with
+// extended multiplexing get several frames, so that their switches select different signals.
+TEST_CASE("Network2CTest", "[]")
+{
+    using namespace dbcppp;
+    auto dir = std::filesystem::temp_directory_path() / "dbcppp_network2c_test";
+    std::filesystem::create_directories(dir);
+    std::default_random_engine rng(42);
+    std::uniform_int_distribution<int> byte_dist(0, 255);
+    for (const auto& dbc_file : std::filesystem::directory_iterator(std::filesystem::path(TEST_FILES_PATH) / "dbc"))
+    {
+        if (dbc_file.path().extension() != ".dbc")
+        {
+            continue;
+        }
+        std::cout << "Testing C generator with file: " << dbc_file.path() << std::endl;
+        std::ifstream is(dbc_file.path());
+        auto net = INetwork::LoadDBCFromIs(is);
+        REQUIRE(net);
+        {
+            std::ofstream header(dir / "generated.h");
+            using namespace dbcppp::Network2C;
+            header << *net;
+        }
+
+        std::map<std::string, std::size_t> name_count;
+        for (const IMessage& msg : net->Messages())
+        {
+            name_count[msg.Name()]++;
+        }
+        std::set<uint64_t> ids;
+        std::vector<std::pair<const IMessage*, std::array<uint8_t, 256>>> frames;
+        std::ofstream harness(dir / "harness.c");
+        harness << "#include <stdio.h>\n"
+                << "#include \"generated.h\"\n"
+                << "int main(void)\n"
+                << "{\n"
+                << "    union dbcppp_message msg;\n"
+                << "    uint8_t packed[255];\n"
+                << "    int i, n;\n"
+                << "    (void)msg; (void)packed; (void)i; (void)n;\n";
+        for (const IMessage& msg : net->Messages())
+        {
+            if (!ids.insert(msg.Id()).second)
+            {
+                continue;
+            }
+            std::string name = name_count[msg.Name()] > 1 ? msg.Name() + "_" + std::to_string(msg.Id()) : msg.Name();
+            std::size_t count = extended_mux(msg) ? 32 : 1;
+            for (std::size_t j = 0; j < count; j++)
+            {
+                std::array<uint8_t, 256> frame;
+                for (auto& b : frame)
+                {
+                    b = uint8_t(byte_dist(rng));
+                }
+                frames.push_back({&msg, frame});
+                harness << "    {\n"
+                        << "        static const uint8_t frame[] = {";
+                for (auto b : frame)
+                {
+                    harness << int(b) << ",";
+                }
+                harness << "};\n"
+                        << "        memset(&msg, 0, sizeof(msg));\n"
+                        << "        if (dbcppp_unpack_message(" << msg.Id() << "ull, &msg, frame, 255) != 0) return 1;\n";
+                for (const ISignal& sig : msg.Signals())
+                {
+                    harness << "        printf(\"%.17g\\n\", dbcppp_" << name << "_" << sig.Name()
+                            << "_raw_to_phys(msg." << name << "." << sig.Name() << "));\n";
+                }
+                harness << "        n = dbcppp_pack_message(" << msg.Id() << "ull, packed, 255, &msg);\n"
+                        << "        if (n < 0) return 1;\n"
+                        << "        printf(\"%d\", n);\n"
+                        << "        for (i = 0; i < n; i++) printf(\" %d\", packed[i]);\n"
+                        << "        printf(\"\\n\");\n"
+                        << "    }\n";
+            }
+        }
+        harness << "    return 0;\n"
+                << "}\n";
+        harness.close();
+
+        auto exe = dir / "harness";
+        auto output = dir / "output.txt";
+        std::string compile = std::string(C_COMPILER) + " -std=c99 -pedantic -Wall -Werror -o \"" + exe.string()
+            + "\" \"" + (dir / "harness.c").string() + "\"";
+        REQUIRE(std::system(compile.c_str()) == 0);
+        REQUIRE(std::system(("\"" + exe.string() + "\" > \"" + output.string() + "\"").c_str()) == 0);
+
+        std::ifstream result(output);
+        for (const auto& [msg, frame] : frames)
+        {
+            for (const ISignal& sig : msg->Signals())
+            {
+                std::string line;
+                REQUIRE(std::getline(result, line));
+                double phys = std::strtod(line.c_str(), nullptr);
+                INFO(msg->Name() << "." << sig.Name());
+                // signals which aren't present keep the zeros of the struct
+                REQUIRE(same_phys(phys, sig.RawToPhys(is_present(*msg, sig, frame.data()) ? sig.Decode(frame.data()) : 0)));
+            }
+            std::string line;
+            REQUIRE(std::getline(result, line));
+            std::istringstream ss(line);
+            int n, b;
+            ss >> n;
+            std::array<uint8_t, 256> packed{};
+            for (int i = 0; i < n && ss >> b; i++)
+            {
+                packed[i] = uint8_t(b);
+            }
+            for (const ISignal& sig : msg->Signals())
+            {
+                if (is_present(*msg, sig, frame.data()))
+                {
+                    INFO(msg->Name() << "." << sig.Name());
+                    REQUIRE(sig.Decode(packed.data()) == sig.Decode(frame.data()));
+                }
+            }
+        }
+    }
+    std::filesystem::remove_all(dir);
+}
+// Same as above for the C++ generator, additionally checks the id dispatching and that decoding is constexpr.
+TEST_CASE("Network2CppTest", "[]")
+{
+    using namespace dbcppp;
+    auto dir = std::filesystem::temp_directory_path() / "dbcppp_network2cpp_test";
+    std::filesystem::create_directories(dir);
+    std::default_random_engine rng(42);
+    std::uniform_int_distribution<int> byte_dist(0, 255);
+    for (const auto& dbc_file : std::filesystem::directory_iterator(std::filesystem::path(TEST_FILES_PATH) / "dbc"))
+    {
+        if (dbc_file.path().extension() != ".dbc")
+        {
+            continue;
+        }
+        std::cout << "Testing C++ generator with file: " << dbc_file.path() << std::endl;
+        std::ifstream is(dbc_file.path());
+        auto net = INetwork::LoadDBCFromIs(is);
+        REQUIRE(net);
+        {
+            std::ofstream header(dir / "generated.h");
+            using namespace dbcppp::Network2Cpp;
+            header << *net;
+        }
+
+        std::map<std::string, std::size_t> name_count;
+        for (const IMessage& msg : net->Messages())
+        {
+            name_count[msg.Name()]++;
+        }
+        std::set<uint64_t> ids;
+        std::vector<std::pair<const IMessage*, std::array<uint8_t, 256>>> frames;
+        std::ofstream harness(dir / "harness.cpp");
+        harness << "#include <cstdio>\n"
+                << "#include \"generated.h\"\n"
+                << "using namespace dbcppp_generated::messages;\n"
+                << "static constexpr uint8_t zeros[256] = {};\n"
+                << "int main()\n"
+                << "{\n"
+                << "    uint8_t packed[256];\n"
+                << "    (void)packed;\n";
+        for (const IMessage& msg : net->Messages())
+        {
+            if (!ids.insert(msg.Id()).second)
+            {
+                continue;
+            }
+            std::string name = name_count[msg.Name()] > 1 ? msg.Name() + "_" + std::to_string(msg.Id()) : msg.Name();
+            std::array<uint8_t, 256> frame;
+            for (auto& b : frame)
+            {
+                b = uint8_t(byte_dist(rng));
+            }
+            frames.push_back({&msg, frame});
+            harness << "    {\n"
+                    << "        static const uint8_t frame[] = {";
+            for (auto b : frame)
+            {
+                harness << int(b) << ",";
+            }
+            harness << "};\n"
+                    << "        uint64_t id = 0;\n"
+                    << "        (void)frame;\n"
+                    << "        dbcppp_generated::visit(" << msg.Id() << "ull, [&](auto m) { id = decltype(m)::message_id; });\n"
+                    << "        if (id != " << msg.Id() << "ull) return 1;\n"
+                    << "        std::memset(packed, 0, sizeof(packed));\n";
+            for (const ISignal& sig : msg.Signals())
+            {
+                std::string type = name + "::" + (sig.Name() == name ? sig.Name() + "_" : sig.Name());
+                if (sig.ExtendedValueType() == ISignal::EExtendedValueType::Integer)
+                {
+                    harness << "        static_assert(" << type << "::decode(zeros) == 0);\n";
+                }
+                harness << "        std::printf(\"%.17g\\n\", " << type << "::decode_phys(frame));\n"
+                        << "        if (" << type << "::present(frame)) " << type << "::encode(" << type << "::decode(frame), packed);\n";
+            }
+            harness << "        std::printf(\"%zu\", " << name << "::message_size);\n"
+                    << "        for (std::size_t i = 0; i < " << name << "::message_size; i++) std::printf(\" %d\", packed[i]);\n"
+                    << "        std::printf(\"\\n\");\n"
+                    << "    }\n";
+        }
+        harness << "    return dbcppp_generated::visit(" << (ids.empty() ? 0 : *ids.rbegin() + 1) << "ull, [](auto) {}) ? 1 : 0;\n"
+                << "}\n";
+        harness.close();
+
+        auto exe = dir / "harness";
+        auto output = dir / "output.txt";
+        std::string compile = std::string(CXX_COMPILER) + " -std=c++17 -Wall -Werror -o \"" + exe.string()
+            + "\" \"" + (dir / "harness.cpp").string() + "\"";
+        REQUIRE(std::system(compile.c_str()) == 0);
+        REQUIRE(std::system(("\"" + exe.string() + "\" > \"" + output.string() + "\"").c_str()) == 0);
+
+        std::ifstream result(output);
+        for (const auto& [msg, frame] : frames)
+        {
+            for (const ISignal& sig : msg->Signals())
+            {
+                std::string line;
+                REQUIRE(std::getline(result, line));
+                INFO(msg->Name() << "." << sig.Name());
+                REQUIRE(same_phys(std::strtod(line.c_str(), nullptr), sig.RawToPhys(sig.Decode(frame.data()))));
+            }
+            std::string line;
+            REQUIRE(std::getline(result, line));
+            std::istringstream ss(line);
+            std::string size;
+            ss >> size;
+            std::array<uint8_t, 256> packed{};
+            int b;
+            for (std::size_t i = 0; ss >> b; i++)
+            {
+                packed[i] = uint8_t(b);
+            }
+            for (const ISignal& sig : msg->Signals())
+            {
+                if (is_present(*msg, sig, frame.data()))
+                {
+                    INFO(msg->Name() << "." << sig.Name());
+                    REQUIRE(sig.Decode(packed.data()) == sig.Decode(frame.data()));
+                }
+            }
+        }
+    }
+    std::filesystem::remove_all(dir);
+}
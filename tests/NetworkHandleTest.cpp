@@ -0,0 +1,103 @@
+
+#include <thread>
+#include <sstream>
+
+#include "dbcppp/NetworkHandle.h"
+
+#include "Catch2.h"
+
+using namespace dbcppp;
+
+static std::unique_ptr<const INetwork> makeNetwork(uint64_t message_id)
+{
+    std::ostringstream dbc;
+    dbc << "VERSION \"\"\nNS_ :\nBS_:\nBU_: A\n";
+    dbc << "BO_ " << message_id << " Msg: 8 A\n";
+    dbc << " SG_ Sig : 0|8@1+ (1,0) [0|0] \"\" A\n";
+    std::istringstream iss(dbc.str());
+    return INetwork::LoadDBCFromIs(iss);
+}
+
+TEST_CASE("NetworkHandle", "[]")
+{
+    SECTION("Old versions live as long as a reader uses them")
+    {
+        NetworkHandle handle(2);
+        auto reader = handle.CreateReader();
+        REQUIRE(!reader.Lock());
+        REQUIRE(handle.Publish(makeNetwork(1), std::string("plan 1")) == 1);
+        {
+            auto snapshot = reader.Lock();
+            REQUIRE(snapshot);
+            REQUIRE(snapshot->Version() == 1);
+            REQUIRE(snapshot->MessageById(1));
+            REQUIRE(!snapshot->MessageById(2));
+            REQUIRE(std::any_cast<std::string>(snapshot->Attachment()) == "plan 1");
+
+            REQUIRE(handle.Publish(makeNetwork(2)) == 2);
+            // still usable while the guard exists
+            REQUIRE(handle.Reclaim() == 1);
+            REQUIRE(snapshot->MessageById(1)->Id() == 1);
+        }
+        REQUIRE(handle.Reclaim() == 0);
+        auto snapshot = reader.Lock();
+        REQUIRE(snapshot->Version() == 2);
+        REQUIRE(snapshot->MessageById(2));
+    }
+    SECTION("Reader slots")
+    {
+        NetworkHandle handle(1);
+        {
+            auto reader = handle.CreateReader();
+            REQUIRE_THROWS(handle.CreateReader());
+        }
+        REQUIRE_NOTHROW(handle.CreateReader());
+    }
+    SECTION("Concurrent readers")
+    {
+        NetworkHandle handle;
+        handle.Publish(makeNetwork(0));
+        std::atomic<bool> stop{false};
+        std::atomic<bool> failed{false};
+        std::vector<std::thread> readers;
+        for (std::size_t i = 0; i < 2; i++)
+        {
+            readers.emplace_back(
+                [&]()
+                {
+                    auto reader = handle.CreateReader();
+                    uint64_t last_version = 0;
+                    while (!stop)
+                    {
+                        auto snapshot = reader.Lock();
+                        // every version contains exactly the message with id version - 1
+                        const auto& net = snapshot->Network();
+                        failed = failed || snapshot->Version() < last_version
+                            || net.Messages_Size() != 1 || net.Messages_Get(0).Id() != snapshot->Version() - 1;
+                        last_version = snapshot->Version();
+                    }
+                });
+        }
+        for (uint64_t i = 1; i < 200; i++)
+        {
+            handle.Publish(makeNetwork(i));
+            std::this_thread::yield();
+        }
+        stop = true;
+        for (auto& reader : readers)
+        {
+            reader.join();
+        }
+        REQUIRE(!failed);
+        REQUIRE(handle.Reclaim() == 0);
+    }
+}
+TEST_CASE("NetworkRegistry", "[]")
+{
+    NetworkRegistry registry;
+    REQUIRE(!registry.Find("can0"));
+    auto& can0 = registry.Handle("can0");
+    REQUIRE(registry.Find("can0") == &can0);
+    REQUIRE(&registry.Handle("can0") == &can0);
+    REQUIRE(&registry.Handle("can1") != &can0);
+}
@@ -0,0 +1,168 @@
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <cstring>
+
+#include "dbcppp/Network.h"
+#include "dbcppp/Predicate.h"
+
+#include "Catch2.h"
+
+using namespace dbcppp;
+
+namespace
+{
+    constexpr const char* test_dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_:\n"
+        "BO_ 1 Msg: 32 Vector__XXX\n"
+        " SG_ VehicleSpeed : 0|16@1+ (0.01,0) [0|655.35] \"km/h\" Vector__XXX\n"
+        " SG_ Gear : 16|4@1- (1,0) [-8|7] \"\" Vector__XXX\n"
+        " SG_ Temperature : 23|10@0- (-0.5,40) [0|0] \"C\" Vector__XXX\n"
+        " SG_ Flag : 36|1@1+ (1,0) [0|1] \"\" Vector__XXX\n"
+        " SG_ Torque : 64|32@1- (1,0) [0|0] \"Nm\" Vector__XXX\n"
+        " SG_ Pressure : 96|32@1- (2,-1) [0|0] \"bar\" Vector__XXX\n"
+        " SG_ Energy : 128|64@1- (1,0) [0|0] \"J\" Vector__XXX\n"
+        "SIG_VALTYPE_ 1 Torque : 1;\n"
+        "SIG_VALTYPE_ 1 Pressure : 1;\n"
+        "SIG_VALTYPE_ 1 Energy : 2;\n";
+
+    using Frame = std::array<uint8_t, 32 + 8>;
+
+    bool compare(double phys, Predicate::EOperator op, double value)
+    {
+        switch (op)
+        {
+        case Predicate::EOperator::Equal: return phys == value;
+        case Predicate::EOperator::NotEqual: return phys != value;
+        case Predicate::EOperator::Less: return phys < value;
+        case Predicate::EOperator::LessEqual: return phys <= value;
+        case Predicate::EOperator::Greater: return phys > value;
+        case Predicate::EOperator::GreaterEqual: return phys >= value;
+        }
+        return false;
+    }
+    std::vector<ISignal::raw_t> decode(const IMessage& msg, const Frame& frame)
+    {
+        std::vector<ISignal::raw_t> raw;
+        for (const ISignal& sig : msg.Signals())
+        {
+            raw.push_back(sig.Decode(frame.data()));
+        }
+        return raw;
+    }
+}
+
+TEST_CASE("PredicateTest", "[]")
+{
+    std::istringstream iss(test_dbc);
+    auto net = INetwork::LoadDBCFromIs(iss);
+    REQUIRE(net);
+    const IMessage& msg = net->Messages_Get(0);
+    const ISignal& speed = msg.Signals_Get(0);
+    const ISignal& gear = msg.Signals_Get(1);
+    std::string error;
+    SECTION("Parse")
+    {
+        auto predicate = Predicate::Parse(msg, "VehicleSpeed > 100 && Gear == 3 || Flag == 1", error);
+        REQUIRE(predicate);
+        REQUIRE(&predicate->Message() == &msg);
+        Frame frame{};
+        speed.Encode(speed.PhysToRaw(100.01), frame.data());
+        gear.Encode(3, frame.data());
+        REQUIRE(predicate->Evaluate(frame.data()));
+        REQUIRE(predicate->EvaluateRaw(decode(msg, frame).data()));
+        speed.Encode(speed.PhysToRaw(100), frame.data());
+        REQUIRE(!predicate->Evaluate(frame.data()));
+        REQUIRE(!predicate->EvaluateRaw(decode(msg, frame).data()));
+        frame[4] |= 0x10;
+        REQUIRE(predicate->Evaluate(frame.data()));
+        REQUIRE(predicate->EvaluateRaw(decode(msg, frame).data()));
+    }
+    SECTION("Parse errors")
+    {
+        REQUIRE(!Predicate::Parse(msg, "", error));
+        REQUIRE(!Predicate::Parse(msg, "Speed > 1", error));
+        REQUIRE(error.find("unknown signal \"Speed\"") == 0);
+        REQUIRE(!Predicate::Parse(msg, "Gear = 1", error));
+        REQUIRE(!Predicate::Parse(msg, "Gear == x", error));
+        REQUIRE(!Predicate::Parse(msg, "Gear == 1 & Flag == 1", error));
+        REQUIRE(error.find("position 10") != std::string::npos);
+    }
+    SECTION("Constant")
+    {
+        Frame frame{};
+        // a 4 bit signed signal lies in [-8, 7]
+        REQUIRE(!Predicate::Parse(msg, "Gear > 7", error)->Evaluate(frame.data()));
+        REQUIRE(Predicate::Parse(msg, "Gear >= -8", error)->Evaluate(frame.data()));
+        REQUIRE(Predicate::Parse(msg, "Gear != 2.5", error)->Evaluate(frame.data()));
+        REQUIRE(!Predicate::Parse(msg, "Gear == 2.5 || Gear < -8", error)->Evaluate(frame.data()));
+        // contradicting equality tests
+        REQUIRE(!Predicate::Parse(msg, "Gear == 1 && Gear == 2", error)->Evaluate(frame.data()));
+    }
+    SECTION("Foreign signal")
+    {
+        std::istringstream other_iss(test_dbc);
+        auto other = INetwork::LoadDBCFromIs(other_iss);
+        REQUIRE(!Predicate::Create(msg, {{{&other->Messages_Get(0).Signals_Get(0), Predicate::EOperator::Equal, 1}}}, error));
+    }
+}
+TEST_CASE("PredicateTest: Same result as comparing the physical values", "[]")
+{
+    std::istringstream iss(test_dbc);
+    auto net = INetwork::LoadDBCFromIs(iss);
+    REQUIRE(net);
+    const IMessage& msg = net->Messages_Get(0);
+
+    std::mt19937_64 rng(42);
+    std::vector<Frame> frames(300);
+    for (auto& frame : frames)
+    {
+        for (std::size_t i = 0; i < 32; i += 8)
+        {
+            uint64_t word = rng();
+            std::memcpy(&frame[i], &word, 8);
+        }
+    }
+    // the special floats
+    float special_floats[] = {0.f, -0.f, INFINITY, -INFINITY, NAN, 1.5f, -1.5f};
+    for (std::size_t i = 0; i < std::size(special_floats); i++)
+    {
+        std::memcpy(&frames[i][8], &special_floats[i], 4);
+        std::memcpy(&frames[i][12], &special_floats[i], 4);
+        double d = special_floats[i];
+        std::memcpy(&frames[i][16], &d, 8);
+    }
+    const Predicate::EOperator operators[] = {Predicate::EOperator::Equal, Predicate::EOperator::NotEqual, Predicate::EOperator::Less
+        , Predicate::EOperator::LessEqual, Predicate::EOperator::Greater, Predicate::EOperator::GreaterEqual};
+    for (const ISignal& sig : msg.Signals())
+    {
+        std::vector<double> values{0, -0., 1, -1, 0.5, -0.5, 1e300, -1e300, INFINITY, -INFINITY, NAN};
+        // the physical values of some of the frames, so the equality tests hold sometimes
+        for (std::size_t i = 0; i < 20; i++)
+        {
+            values.push_back(sig.RawToPhys(sig.Decode(frames[i * 7].data())));
+        }
+        for (double value : values)
+        {
+            for (auto op : operators)
+            {
+                std::string error;
+                auto predicate = Predicate::Create(msg, {{{&sig, op, value}}}, error);
+                REQUIRE(predicate);
+                for (const auto& frame : frames)
+                {
+                    ISignal::raw_t raw = sig.Decode(frame.data());
+                    bool expected = compare(sig.RawToPhys(raw), op, value);
+                    INFO(sig.Name() << " " << int(op) << " " << value << " raw " << raw);
+                    REQUIRE(predicate->Evaluate(frame.data()) == expected);
+                    REQUIRE(predicate->EvaluateRaw(decode(msg, frame).data()) == expected);
+                }
+            }
+        }
+    }
+}
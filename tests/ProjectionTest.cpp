@@ -0,0 +1,162 @@
+
+#include <array>
+#include <cmath>
+#include <sstream>
+
+#include "dbcppp/CApi.h"
+#include "dbcppp/Network.h"
+#include "dbcppp/Generator.h"
+#include "dbcppp/Projection.h"
+
+#include "Catch2.h"
+
+using namespace dbcppp;
+
+namespace
+{
+    constexpr const char* test_dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_:\n"
+        "BO_ 1 Msg1: 8 Vector__XXX\n"
+        " SG_ S : 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        " SG_ M M : 8|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        " SG_ A m0 : 16|8@1+ (2,0) [0|0] \"\" Vector__XXX\n"
+        " SG_ B m1 : 16|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        "BO_ 2 Msg2: 8 Vector__XXX\n"
+        " SG_ S : 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        "BO_ 3 Msg3: 8 Vector__XXX\n"
+        " SG_ C : 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n";
+
+    std::unique_ptr<INetwork> load(std::istream& is)
+    {
+        auto net = INetwork::LoadDBCFromIs(is);
+        REQUIRE(net);
+        return net;
+    }
+    bool same(double lhs, double rhs)
+    {
+        return lhs == rhs || (std::isnan(lhs) && std::isnan(rhs));
+    }
+}
+
+TEST_CASE("ProjectionTest", "[]")
+{
+    std::istringstream iss(test_dbc);
+    auto net = load(iss);
+    std::string error;
+    SECTION("Names")
+    {
+        auto projection = Projection::Create(*net, std::vector<std::string>{"Msg1.A", "S"}, error);
+        REQUIRE(projection);
+        REQUIRE(projection->Messages_Size() == 2);
+        REQUIRE(projection->MaxSignalsPerMessage() == 2);
+        REQUIRE(!projection->Find(3));
+
+        const auto* msg = projection->Find(1);
+        REQUIRE(msg);
+        REQUIRE(msg->message == &net->Messages_Get(0));
+        // in the order of the message
+        REQUIRE(msg->signals == std::vector<const ISignal*>{&net->Messages_Get(0).Signals_Get(0), &net->Messages_Get(0).Signals_Get(2)});
+        REQUIRE(msg->switches == std::vector<const ISignal*>{&net->Messages_Get(0).Signals_Get(1)});
+
+        std::array<double, 2> values;
+        std::array<uint8_t, 16> frame{7, 0, 21};
+        REQUIRE(projection->Decode(1, frame.data(), values.data()) == msg);
+        REQUIRE(values[0] == 7);
+        REQUIRE(values[1] == 42);
+        frame[1] = 1;
+        REQUIRE(projection->Decode(*msg, frame.data(), values.data()) == 2);
+        REQUIRE(std::isnan(values[1]));
+        REQUIRE(!projection->Decode(3, frame.data(), values.data()));
+
+        REQUIRE(projection->Find(2)->signals.size() == 1);
+        REQUIRE(projection->Find(2)->switches.empty());
+    }
+    SECTION("Handles")
+    {
+        auto projection = Projection::Create(*net, std::vector<const ISignal*>{&net->Messages_Get(2).Signals_Get(0)}, error);
+        REQUIRE(projection);
+        REQUIRE(projection->Messages_Size() == 1);
+        REQUIRE(projection->Find(3));
+        REQUIRE(!projection->Find(1));
+    }
+    SECTION("Errors")
+    {
+        REQUIRE(!Projection::Create(*net, std::vector<std::string>{"S", "Msg2.A"}, error));
+        REQUIRE(error.find("Msg2.A") != std::string::npos);
+        std::istringstream other_iss(test_dbc);
+        auto other = load(other_iss);
+        REQUIRE(!Projection::Create(*net, std::vector<const ISignal*>{&other->Messages_Get(0).Signals_Get(0)}, error));
+    }
+    SECTION("Duplicate ids")
+    {
+        std::istringstream dup_iss(std::string(test_dbc) +
+            "BO_ 3 Msg4: 8 Vector__XXX\n"
+            " SG_ D : 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n");
+        auto dup = load(dup_iss);
+        REQUIRE(dup->Messages_Size() == 4);
+        const IMessage* owner = dup->MessageById(3);
+        REQUIRE(owner);
+        const IMessage& shadowed = &dup->Messages_Get(2) == owner ? dup->Messages_Get(3) : dup->Messages_Get(2);
+        // only the signal of the message MessageById doesn't return is selected
+        auto projection = Projection::Create(*dup, std::vector<const ISignal*>{&shadowed.Signals_Get(0)}, error);
+        REQUIRE(projection);
+        REQUIRE(projection->Messages_Size() == 1);
+        REQUIRE(!projection->Find(3));
+        projection = Projection::Create(*dup, std::vector<std::string>{"C", "D"}, error);
+        REQUIRE(projection);
+        REQUIRE(projection->Messages_Size() == 2);
+        REQUIRE(projection->Find(3)->message == owner);
+    }
+}
+TEST_CASE("ProjectionTest: Same values as decoding all signals", "[]")
+{
+    for (std::size_t mux_depth : {0, 1, 3})
+    {
+        Generator::DBCOptions options;
+        options.messages = 20;
+        options.signals_per_message = 12;
+        options.mux_depth = mux_depth;
+        options.mux_values = 3;
+        std::istringstream iss(Generator::GenerateDBC(options));
+        auto net = load(iss);
+
+        // every third signal, mostly not the switches
+        std::vector<const ISignal*> selected;
+        for (const IMessage& msg : net->Messages())
+        {
+            for (std::size_t i = 2; i < msg.Signals_Size(); i += 3)
+            {
+                selected.push_back(&msg.Signals_Get(i));
+            }
+        }
+        std::string error;
+        auto projection = Projection::Create(*net, selected, error);
+        REQUIRE(projection);
+        REQUIRE(projection->Messages_Size() == 20);
+
+        Generator::FrameOptions frame_options;
+        frame_options.count = 500;
+        Generator::GenerateFrames(*net, frame_options,
+            [&](const Generator::Frame& frame)
+            {
+                std::array<uint8_t, 64 + 8> data{};
+                std::copy(frame.data.begin(), frame.data.end(), data.begin());
+                const IMessage* msg = net->MessageById(frame.id);
+                std::vector<double> all(msg->Signals_Size());
+                dbcppp_MessageDecodeAll(reinterpret_cast<const dbcppp_Message*>(msg), data.data(), data.size(), all.data());
+
+                std::vector<double> values(projection->MaxSignalsPerMessage());
+                const auto* projected = projection->Decode(frame.id, data.data(), values.data());
+                REQUIRE(projected);
+                for (std::size_t i = 0; i < projected->signals.size(); i++)
+                {
+                    std::size_t index = 2 + 3 * i;
+                    REQUIRE(projected->signals[i] == &msg->Signals_Get(index));
+                    REQUIRE(same(values[i], all[index]));
+                }
+            });
+    }
+}
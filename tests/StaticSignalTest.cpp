@@ -0,0 +1,170 @@
+
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+#include <cstring>
+
+#include "dbcppp/Network.h"
+#include "dbcppp/StaticSignal.h"
+
+#include "Catch2.h"
+
+using namespace dbcppp;
+
+namespace
+{
+    constexpr auto le = ISignal::EByteOrder::LittleEndian;
+    constexpr auto be = ISignal::EByteOrder::BigEndian;
+    constexpr auto sig = ISignal::EValueType::Signed;
+    constexpr auto usig = ISignal::EValueType::Unsigned;
+    constexpr auto i = ISignal::EExtendedValueType::Integer;
+    constexpr auto f = ISignal::EExtendedValueType::Float;
+    constexpr auto d = ISignal::EExtendedValueType::Double;
+
+    constexpr uint8_t bytes[16] = {0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc, 0xde, 0xf0, 0x0f, 0xed, 0xcb, 0xa9, 0x87, 0x65, 0x43, 0x21};
+    static_assert(static_signal<0, 8, le>::decode(bytes) == 0x12);
+    static_assert(static_signal<8, 16, le>::decode(bytes) == 0x5634);
+    static_assert(static_signal<7, 16, be>::decode(bytes) == 0x1234);
+    static_assert(static_signal<36, 4, le, sig>::decode(bytes) == uint64_t(-7));
+    static_assert(static_signal<0, 8, le, usig, i, std::ratio<1, 2>, std::ratio<-10>>::raw_to_phys(0x12) == -1.);
+
+    // phys_to_raw clamps to the raw values of the signal, NaN maps to 0
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    static_assert(static_signal<0, 8, le, sig>::phys_to_raw(-129.) == uint64_t(-128));
+    static_assert(static_signal<0, 8, le, sig>::phys_to_raw(-128.) == uint64_t(-128));
+    static_assert(static_signal<0, 8, le, sig>::phys_to_raw(127.9) == 127);
+    static_assert(static_signal<0, 8, le, sig>::phys_to_raw(1e30) == 127);
+    static_assert(static_signal<0, 8, le, sig>::phys_to_raw(nan) == 0);
+    static_assert(static_signal<0, 64, le, sig>::phys_to_raw(-1e30) == uint64_t(std::numeric_limits<int64_t>::min()));
+    static_assert(static_signal<0, 64, le, sig>::phys_to_raw(1e30) == uint64_t(std::numeric_limits<int64_t>::max()));
+    static_assert(static_signal<0, 12, le, sig, i, std::ratio<1, 10>, std::ratio<-40>>::phys_to_raw(-1000.) == uint64_t(-2048));
+    static_assert(static_signal<0, 8, le>::phys_to_raw(-1.) == 0);
+    static_assert(static_signal<0, 8, le>::phys_to_raw(256.) == 255);
+    static_assert(static_signal<0, 8, le>::phys_to_raw(nan) == 0);
+    static_assert(static_signal<0, 64, le>::phys_to_raw(1e30) == std::numeric_limits<uint64_t>::max());
+
+    template <class StaticSignal>
+    std::unique_ptr<ISignal> make_signal()
+    {
+        return ISignal::Create(
+              64
+            , "Signal"
+            , ISignal::EMultiplexer::NoMux
+            , 0
+            , StaticSignal::start_bit
+            , StaticSignal::bit_size
+            , StaticSignal::byte_order
+            , StaticSignal::value_type
+            , StaticSignal::factor
+            , StaticSignal::offset
+            , 0
+            , 0
+            , ""
+            , {}
+            , {}
+            , {}
+            , ""
+            , StaticSignal::extended_value_type
+            , {});
+    }
+    bool same_phys(double lhs, double rhs)
+    {
+        return lhs == rhs || (std::isnan(lhs) && std::isnan(rhs));
+    }
+    template <class StaticSignal>
+    void check(std::default_random_engine& rng)
+    {
+        auto signal = make_signal<StaticSignal>();
+        REQUIRE(StaticSignal::matches(*signal));
+        std::uniform_int_distribution<uint64_t> dist;
+        for (std::size_t n = 0; n < 1000; n++)
+        {
+            std::array<uint8_t, 80> frame;
+            for (auto& b : frame)
+            {
+                b = uint8_t(dist(rng));
+            }
+            auto raw = signal->Decode(frame.data());
+            REQUIRE(StaticSignal::decode(frame.data()) == raw);
+            REQUIRE(same_phys(StaticSignal::raw_to_phys(raw), signal->RawToPhys(raw)));
+
+            auto expected = frame;
+            auto encoded = frame;
+            raw = dist(rng);
+            signal->Encode(raw, expected.data());
+            StaticSignal::encode(raw, encoded.data());
+            REQUIRE(encoded == expected);
+        }
+        if constexpr (StaticSignal::extended_value_type == ISignal::EExtendedValueType::Integer)
+        {
+            constexpr uint64_t max = (1ull << (StaticSignal::bit_size - 1) << 1) - 1;
+            if constexpr (StaticSignal::value_type == ISignal::EValueType::Signed)
+            {
+                REQUIRE(StaticSignal::phys_to_raw(12.) == signal->PhysToRaw(12.));
+                REQUIRE(StaticSignal::phys_to_raw(-12.) == signal->PhysToRaw(-12.));
+                // clamped to [-(max + 1) / 2, max / 2]
+                REQUIRE(StaticSignal::phys_to_raw(1e30) == max / 2);
+                REQUIRE(StaticSignal::phys_to_raw(-1e30) == ~(max / 2));
+                REQUIRE(StaticSignal::phys_to_raw(NAN) == 0);
+            }
+            else
+            {
+                // clamped to [0, max]
+                double raw = (-12. - StaticSignal::offset) / StaticSignal::factor;
+                REQUIRE(StaticSignal::phys_to_raw(-12.) == (raw > 0. ? uint64_t(raw) : 0));
+                REQUIRE(StaticSignal::phys_to_raw(12.) == std::min<uint64_t>(uint64_t((12. - StaticSignal::offset) / StaticSignal::factor), max));
+                REQUIRE(StaticSignal::phys_to_raw(1e30) == max);
+                REQUIRE(StaticSignal::phys_to_raw(NAN) == 0);
+            }
+        }
+        if constexpr (StaticSignal::extended_value_type == ISignal::EExtendedValueType::Float)
+        {
+            // values outside of the range of float saturate to infinity
+            REQUIRE(StaticSignal::phys_to_raw(1e300) == 0x7F800000);
+            REQUIRE(StaticSignal::phys_to_raw(-1e300) == 0xFF800000);
+            REQUIRE(std::isnan(StaticSignal::raw_to_phys(StaticSignal::phys_to_raw(NAN))));
+            REQUIRE(StaticSignal::phys_to_raw(1.5) == uint32_t(signal->PhysToRaw(1.5)));
+        }
+    }
+}
+
+TEST_CASE("StaticSignalTest", "[]")
+{
+    std::default_random_engine rng(1);
+    SECTION("Signals within the first 64 bit")
+    {
+        check<static_signal<0, 8, le>>(rng);
+        check<static_signal<3, 12, le, sig, i, std::ratio<1, 10>, std::ratio<-40>>>(rng);
+        check<static_signal<7, 16, be, sig>>(rng);
+        check<static_signal<39, 32, be, sig, i, std::ratio<3, 4>>>(rng);
+        check<static_signal<0, 64, le, sig>>(rng);
+        check<static_signal<0, 32, le, usig, f>>(rng);
+        check<static_signal<0, 64, le, usig, d>>(rng);
+        check<static_signal<7, 64, be, usig, d>>(rng);
+    }
+    SECTION("Signals which fit into a 64 bit word")
+    {
+        check<static_signal<100, 20, le>>(rng);
+        check<static_signal<61, 10, le, sig>>(rng);
+        check<static_signal<129, 13, be>>(rng);
+        check<static_signal<85, 33, be, sig>>(rng);
+        check<static_signal<64, 32, le, usig, f>>(rng);
+    }
+    SECTION("Signals which span 9 bytes")
+    {
+        check<static_signal<67, 64, le>>(rng);
+        check<static_signal<68, 64, be, sig>>(rng);
+        check<static_signal<13, 60, le, sig>>(rng);
+        check<static_signal<2, 60, be>>(rng);
+    }
+    SECTION("Cross validation against runtime signals")
+    {
+        auto signal = make_signal<static_signal<0, 8, le>>();
+        REQUIRE(static_signal<0, 8, le>::matches(*signal));
+        REQUIRE_FALSE((static_signal<0, 8, be>::matches(*signal)));
+        REQUIRE_FALSE((static_signal<0, 8, le, sig>::matches(*signal)));
+        REQUIRE_FALSE((static_signal<0, 8, le, usig, i, std::ratio<2>>::matches(*signal)));
+    }
+}
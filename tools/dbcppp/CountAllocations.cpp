@@ -0,0 +1,128 @@
+#include <new>
+#include <atomic>
+#include <algorithm>
+#include <cstdlib>
+
+#include "dbcppp/LoadStats.h"
+#include "CountAllocations.h"
+
+namespace
+{
+    // constant initialized, so allocations during the static initialization see it
+    std::atomic<bool> counting{false};
+
+    void* allocate(std::size_t size) noexcept
+    {
+        if (counting.load(std::memory_order_relaxed))
+        {
+            dbcppp::LoadStats::CountAllocation(size);
+        }
+        return std::malloc(size ? size : 1);
+    }
+    void* allocate(std::size_t size, std::align_val_t alignment) noexcept
+    {
+        if (counting.load(std::memory_order_relaxed))
+        {
+            dbcppp::LoadStats::CountAllocation(size);
+        }
+        // aligned_alloc wants a non zero multiple of the alignment
+        std::size_t align = static_cast<std::size_t>(alignment);
+        return std::aligned_alloc(align, std::max<std::size_t>((size + align - 1) / align * align, align));
+    }
+    template <class... Alignment>
+    void* allocate_or_throw(std::size_t size, Alignment... alignment)
+    {
+        if (void* ptr = allocate(size, alignment...))
+        {
+            return ptr;
+        }
+        throw std::bad_alloc();
+    }
+}
+
+void enable_allocation_counting()
+{
+    counting.store(true, std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size)
+{
+    return allocate_or_throw(size);
+}
+void* operator new[](std::size_t size)
+{
+    return allocate_or_throw(size);
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocate_or_throw(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return allocate_or_throw(size, alignment);
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocate(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocate(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+// The tool replaces the global operator new, which reports the allocations to dbcppp::LoadStats
+// once this has been called for --stats. The replacement lives in its own translation unit, inlined into
+// the callers GCC warns about the std::free of memory from operator new.
+void enable_allocation_counting();
@@ -1,4 +1,5 @@
 #include <regex>
+#include <algorithm>
 #include <array>
 #include <string>
 #include <vector>
@@ -7,18 +8,182 @@
 #include <iostream>
 #include <filesystem>
 #include <memory>
+#include <cstdlib>
+#include <iomanip>
 
 #include "dbcppp/Network.h"
 #include "dbcppp/Network2Functions.h"
+#include "dbcppp/Generator.h"
+
+#include "CountAllocations.h"
+
+bool print_stats = false;
 
 void print_help()
 {
     std::cout << "dbcppp v1.0.0\nFor help type: dbcppp <subprogram> --help\n"
-        << "Sub programs: dbc2, decode\n";
+        << "Sub programs: dbc2, decode, gen\n"
+        << "--stats prints where the time and memory of loading the DBC went to stderr\n";
+}
+void print_load_stats(std::ostream& os, const dbcppp::LoadStats& stats)
+{
+    os << std::left << std::setw(28) << "phase" << std::right
+        << std::setw(12) << "time [ms]" << std::setw(14) << "allocations" << std::setw(14) << "bytes" << "\n";
+    double total_ms = 0;
+    for (const auto& phase : stats.phases)
+    {
+        os << std::left << std::setw(28) << phase.name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(3) << phase.wall_time_ms
+            << std::setw(14) << phase.allocations << std::setw(14) << phase.allocated_bytes << "\n";
+        total_ms += phase.wall_time_ms;
+    }
+    os << std::left << std::setw(28) << "total" << std::right << std::setw(12) << total_ms << "\n";
+    if (!stats.allocations_counted)
+    {
+        os << "(allocations not counted)\n";
+    }
+    os << "\n" << std::left << std::setw(28) << "AST nodes" << std::right << std::setw(12) << "count" << "\n";
+    for (const auto& node : stats.ast_nodes)
+    {
+        os << std::left << std::setw(28) << node.name << std::right << std::setw(12) << node.count << "\n";
+    }
+    os << "\n" << std::left << std::setw(28) << "footprint" << std::right
+        << std::setw(12) << "count" << std::setw(14) << "bytes" << "\n";
+    uint64_t total_bytes = 0;
+    for (const auto& entity : stats.footprint)
+    {
+        os << std::left << std::setw(28) << entity.name << std::right
+            << std::setw(12) << entity.count << std::setw(14) << entity.bytes << "\n";
+        total_bytes += entity.bytes;
+    }
+    os << std::left << std::setw(28) << "total" << std::right << std::setw(26) << total_bytes << "\n";
+}
+std::unique_ptr<dbcppp::INetwork> load_network(const std::string& filename)
+{
+    if (!print_stats)
+    {
+        return dbcppp::INetwork::LoadNetworkFromFile(filename);
+    }
+    dbcppp::LoadStats stats;
+    dbcppp::LoadOptions options;
+    options.stats = &stats;
+    std::string error_message;
+    auto net = dbcppp::INetwork::LoadNetworkFromFile(filename, options, error_message);
+    if (!net)
+    {
+        std::cerr << error_message << std::endl;
+    }
+    print_load_stats(std::cerr, stats);
+    return net;
+}
+void print_gen_help()
+{
+    std::cout << "Usage:\n"
+        << "dbcppp gen dbc [--seed=<n>] [--messages=<n>] [--signals=<n>] [--nodes=<n>] [--mux-depth=<n>] [--mux-values=<n>]\n"
+        << "    [--extended-mux] [--float] [--double] [--can-fd] [--extended-ids]\n"
+        << "    [--no-attributes] [--no-comments] [--no-value-descriptions]\n"
+        << "dbcppp gen frames <dbc filename> [--seed=<n>] [--count=<n>] [--format=candump|binary] [--interface=<name>]\n";
+}
+int gen(int argc, char** argv)
+{
+    if (argc < 3 || std::string("--help") == argv[2])
+    {
+        print_gen_help();
+        return 1;
+    }
+    const std::string what = argv[2];
+    std::vector<std::string> args(argv + 3, argv + argc);
+    auto value =
+        [](const std::string& arg, const std::string& name, auto& result)
+        {
+            if (arg.rfind(name + "=", 0) != 0)
+            {
+                return false;
+            }
+            std::istringstream iss(arg.substr(name.size() + 1));
+            iss >> result;
+            return true;
+        };
+    if (what == "dbc")
+    {
+        dbcppp::Generator::DBCOptions options;
+        for (const auto& arg : args)
+        {
+            if (value(arg, "--seed", options.seed)) {}
+            else if (value(arg, "--messages", options.messages)) {}
+            else if (value(arg, "--signals", options.signals_per_message)) {}
+            else if (value(arg, "--nodes", options.nodes)) {}
+            else if (value(arg, "--mux-depth", options.mux_depth)) {}
+            else if (value(arg, "--mux-values", options.mux_values)) {}
+            else if (arg == "--extended-mux") options.extended_mux = true;
+            else if (arg == "--float") options.float_signals = true;
+            else if (arg == "--double") options.double_signals = true;
+            else if (arg == "--can-fd") options.can_fd = true;
+            else if (arg == "--extended-ids") options.extended_ids = true;
+            else if (arg == "--no-attributes") options.attributes = false;
+            else if (arg == "--no-comments") options.comments = false;
+            else if (arg == "--no-value-descriptions") options.value_descriptions = false;
+            else
+            {
+                print_gen_help();
+                return 1;
+            }
+        }
+        dbcppp::Generator::GenerateDBC(std::cout, options);
+        return 0;
+    }
+    else if (what == "frames" && !args.empty())
+    {
+        dbcppp::Generator::FrameOptions options;
+        std::string format = "candump";
+        for (std::size_t i = 1; i < args.size(); i++)
+        {
+            const auto& arg = args[i];
+            if (value(arg, "--seed", options.seed)) {}
+            else if (value(arg, "--count", options.count)) {}
+            else if (value(arg, "--format", format)) {}
+            else if (value(arg, "--interface", options.interface_name)) {}
+            else
+            {
+                print_gen_help();
+                return 1;
+            }
+        }
+        if (format == "binary")
+        {
+            options.format = dbcppp::Generator::EFrameFormat::Binary;
+        }
+        else if (format != "candump")
+        {
+            print_gen_help();
+            return 1;
+        }
+        auto net = load_network(args[0]);
+        if (!net)
+        {
+            std::cout << "error: could not load DBC '" << args[0] << "'" << std::endl;
+            return 1;
+        }
+        dbcppp::Generator::WriteFrames(std::cout, *net, options);
+        return 0;
+    }
+    print_gen_help();
+    return 1;
 }
 
 int main(int argc, char** argv)
 {
+    auto stats_end = std::remove(argv + 1, argv + argc, std::string("--stats"));
+    print_stats = stats_end != argv + argc;
+    if (print_stats)
+    {
+        enable_allocation_counting();
+    }
+    argc = int(stats_end - argv);
+    if (argc >= 2 && std::string("gen") == argv[1])
+    {
+        return gen(argc, argv);
+    }
     if (argc != 4 || std::string("--help") == argv[1])
     {
         print_help();
@@ -33,13 +198,18 @@ int main(int argc, char** argv)
             return 1;
         }
         const std::string format = argv[2]; 
-        auto net = dbcppp::INetwork::LoadNetworkFromFile(argv[3]);
+        auto net = load_network(argv[3]);
         if (!net) return 1;
         if (format == "C")
         {
             using namespace dbcppp::Network2C;
             std::cout << *net;
         }
+        else if (format == "Cpp")
+        {
+            using namespace dbcppp::Network2Cpp;
+            std::cout << *net;
+        }
         else if (format == "DBC")
         {
             using namespace dbcppp::Network2DBC;
@@ -54,14 +224,14 @@ int main(int argc, char** argv)
         else 
         {
             std::cout << "Usage:\ndbcppp dbc2c [--help] <format> <dbc filename>\n";
-            std::cout << "format be C, DBC or human\n";
+            std::cout << "format be C, Cpp, DBC or human\n";
             return 1;
         }
     }
     else if (std::string("decode") == argv[1])
     {
         std::string name = argv[2];
-        std::unique_ptr<dbcppp::INetwork> net = dbcppp::INetwork::LoadNetworkFromFile(argv[3]);
+        std::unique_ptr<dbcppp::INetwork> net = load_network(argv[3]);
         if (!net)
         {
             std::cout << "error: could not load DBC '" << argv[3] << "'" << std::endl;